@@ -0,0 +1,59 @@
+#!/usr/bin/env python3
+
+# Compares two microbenchmark result files (Google Benchmark JSON format, as written
+# by the bench_* executables with -bench-out=<file>) and reports the relative change
+# in time per iteration for each benchmark present in both files.
+# Exits with code 1 if any benchmark became slower by more than the threshold.
+#
+# Usage: compare_benchmarks.py <baseline.json> <contender.json> [threshold=0.1] [metric=real_time|cpu_time]
+
+import sys
+import json
+
+def load_times(filename, metric):
+    benchmarks = json.load(open(filename, 'r'))["benchmarks"]
+    # Prefer median aggregates (from -bench-reps=<n> with n>1) over single iterations
+    medians = dict()
+    iterations = dict()
+    for b in benchmarks:
+        name = b["run_name"]
+        if b["run_type"] == "aggregate":
+            if b["aggregate_name"] == "median":
+                medians[name] = b[metric]
+        else:
+            iterations.setdefault(name, []).append(b[metric])
+    times = dict()
+    for name in iterations:
+        times[name] = medians[name] if name in medians else sum(iterations[name]) / len(iterations[name])
+    return times
+
+if len(sys.argv) < 3:
+    print("Usage: " + sys.argv[0] + " <baseline.json> <contender.json> [threshold=0.1] [metric=real_time|cpu_time]")
+    exit(2)
+
+threshold = float(sys.argv[3]) if len(sys.argv) > 3 else 0.1
+metric = sys.argv[4] if len(sys.argv) > 4 else "real_time"
+baseline = load_times(sys.argv[1], metric)
+contender = load_times(sys.argv[2], metric)
+
+regressions = []
+print("%-60s %14s %14s %9s" % ("Benchmark", "Baseline[ns]", "Contender[ns]", "Change"))
+for name in baseline:
+    if name not in contender:
+        print("%-60s %14.0f %14s %9s" % (name, baseline[name], "-", "-"))
+        continue
+    change = contender[name] / baseline[name] - 1 if baseline[name] > 0 else 0
+    marker = ""
+    if change > threshold:
+        marker = " REGRESSION"
+        regressions += [name]
+    elif change < -threshold:
+        marker = " improvement"
+    print("%-60s %14.0f %14.0f %+8.1f%%%s" % (name, baseline[name], contender[name], 100*change, marker))
+for name in contender:
+    if name not in baseline:
+        print("%-60s %14s %14.0f %9s" % (name, "-", contender[name], "-"))
+
+if len(regressions) > 0:
+    print(str(len(regressions)) + " benchmark(s) regressed by more than " + str(100*threshold) + "%")
+    exit(1)
@@ -0,0 +1,74 @@
+#!/usr/bin/env python3
+
+# Merges the per-rank timelines written by Mallob with the option -ctrace
+# (<trace-dir>/mallob_timeline.<rank>.json) into a single Chrome Trace Event file
+# which can be opened in Perfetto (ui.perfetto.dev) or chrome://tracing.
+#
+# The timestamps of each rank are relative to its Timer start, which happens right
+# after MPI initialization. By default, the ranks are aligned at the common clock
+# synchronization point (a barrier right after program start); alternatively,
+# they can be aligned by the wall clock time of their Timer start (for hosts with
+# synchronized clocks) or not shifted at all.
+#
+# Usage: merge_timelines.py <output.json> <timeline files or directories ...> [--align=sync|realtime|timer]
+
+import sys
+import os
+import glob
+import json
+
+if len(sys.argv) < 3:
+    print("Usage: " + sys.argv[0] + " <output.json> <timeline files or directories ...> [--align=sync|realtime|timer]")
+    exit(1)
+
+outfile = sys.argv[1]
+align = "sync"
+files = []
+for arg in sys.argv[2:]:
+    if arg.startswith("--align="):
+        align = arg[len("--align="):]
+    elif os.path.isdir(arg):
+        files += sorted(glob.glob(arg + "/mallob_timeline.*.json"))
+    else:
+        files += [arg]
+
+if align not in ["sync", "realtime", "timer"]:
+    print("Unknown alignment \"" + align + "\"")
+    exit(1)
+
+timelines = []
+for f in files:
+    timelines += [json.load(open(f, 'r'))]
+if not timelines:
+    print("No timeline files found")
+    exit(1)
+
+if align == "sync" and any("clock_sync_point_us" not in t["otherData"] for t in timelines):
+    print("WARN: Not all timelines have a clock sync point; aligning by Timer start instead")
+    align = "timer"
+
+# Compute the shift of each rank's timestamps
+shifts = []
+for t in timelines:
+    meta = t["otherData"]
+    if align == "sync":
+        # Move each rank's sync point to the latest sync point among all ranks
+        shifts += [-meta["clock_sync_point_us"]]
+    elif align == "realtime":
+        shifts += [meta["timer_start_realtime_us"]]
+    else:
+        shifts += [0]
+# Normalize such that no timestamp becomes negative
+offset = -min(shifts)
+shifts = [s + offset for s in shifts]
+
+events = []
+for t, shift in zip(timelines, shifts):
+    for e in t["traceEvents"]:
+        if "ts" in e:
+            e["ts"] += shift
+        events += [e]
+    print("rank", t["otherData"]["rank"], ": shift", "%.3f" % (shift/1000), "ms,", len(t["traceEvents"]), "events")
+
+json.dump({"traceEvents": events, "displayTimeUnit": "ms", "otherData": {"alignment": align}}, open(outfile, 'w'))
+print("Wrote", len(events), "events to", outfile)
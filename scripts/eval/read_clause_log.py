@@ -0,0 +1,56 @@
+#!/usr/bin/env python3
+
+# Reads a binary clause log (written by mallob with -clause-log=<file> -clause-log-binary=1)
+# and either prints a summary per sharing epoch (number of clauses, literals, mean length
+# and LBD, number of clauses produced by several local solvers) or dumps the clauses in
+# the same text format as the non-binary clause log.
+#
+# Usage: read_clause_log.py <clause-log> [summary|text]
+
+import sys
+import struct
+
+MAGIC = 0x4d434c47
+VERSION = 1
+
+def read_epochs(filename):
+    data = open(filename, 'rb').read()
+    ints = struct.unpack('<%ii' % (len(data) // 4), data[:len(data) - len(data) % 4])
+    if len(ints) < 3 or ints[0] != MAGIC or ints[1] != VERSION:
+        print("Not a binary clause log: " + filename, file=sys.stderr)
+        sys.exit(1)
+    num_metadata_ints = ints[2]
+    pos = 3
+    epoch = None
+    clauses = []
+    while pos < len(ints):
+        size = ints[pos]
+        if size == 0:
+            # epoch header
+            if epoch is not None:
+                yield epoch, clauses
+            epoch = ints[pos+1]
+            clauses = []
+            pos += 2
+            continue
+        if pos + 3 + size > len(ints):
+            break # truncated log
+        lbd, producers = ints[pos+1], ints[pos+2] & 0xffffffff
+        lits = ints[pos+3+num_metadata_ints:pos+3+size]
+        clauses.append((lbd, producers, lits))
+        pos += 3 + size
+    if epoch is not None:
+        yield epoch, clauses
+
+mode = sys.argv[2] if len(sys.argv) > 2 else "summary"
+for epoch, clauses in read_epochs(sys.argv[1]):
+    if mode == "text":
+        for (lbd, producers, lits) in clauses:
+            print(" ".join([str(lbd)] + [str(l) for l in lits]))
+        print()
+    else:
+        nb_lits = sum([len(c[2]) for c in clauses])
+        nb_multi = sum([1 for c in clauses if bin(c[1]).count("1") > 1])
+        mean_len = nb_lits / len(clauses) if clauses else 0
+        mean_lbd = sum([c[0] for c in clauses]) / len(clauses) if clauses else 0
+        print("epoch=%i clauses=%i lits=%i meanlen=%.2f meanlbd=%.2f multiproduced=%i" % (epoch, len(clauses), nb_lits, mean_len, mean_lbd, nb_multi))
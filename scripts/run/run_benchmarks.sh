@@ -0,0 +1,27 @@
+#!/bin/bash
+
+# Runs all microbenchmarks of a build directory (configured with -DMALLOB_BUILD_BENCHMARKS=1)
+# and writes one JSON result file per benchmark executable into the provided output directory.
+# Further arguments (e.g., -bench-min-time=1 -bench-reps=5) are forwarded to each executable.
+# Compare two output directories with scripts/eval/compare_benchmarks.py.
+#
+# Usage: scripts/run/run_benchmarks.sh <build-dir> <output-dir> [benchmark options]
+
+if [ -z "$2" ]; then
+    echo "Usage: $0 <build-dir> <output-dir> [benchmark options]"
+    exit 1
+fi
+
+mkdir -p "$2"
+builddir=$(realpath "$1")
+outdir=$(realpath "$2")
+shift 2
+
+# Input files are referenced relative to the repository's root directory
+cd "$(git -C "$(dirname "$0")" rev-parse --show-toplevel)" || exit 1
+for bench in "$builddir"/bench_*; do
+    [ -x "$bench" ] || continue
+    name=$(basename "$bench")
+    echo "Running $name ..."
+    "$bench" -bench-out="$outdir/$name.json" "$@" || exit 1
+done
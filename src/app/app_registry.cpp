@@ -18,6 +18,10 @@ namespace app_registry {
             JobReader reader;
             JobCreator creator;
             JobSolutionFormatter solutionFormatter;
+            JobQuickSolver quickSolver;
+            JobPreprocessor preprocessor;
+            JobTuner tuner;
+            JobResultObserver resultObserver;
         };
 
         std::vector<AppEntry> _app_entries;
@@ -29,10 +33,26 @@ namespace app_registry {
     // reader: a lambda which reads a number of description files into a JobDescription object.
     // creator: a lambda which returns a new instance of a particular subclass of Job.
     // solutionFormatter: a lambda which transforms a found job result into 
+    // quickSolver (optional): a lambda which attempts to solve a read job description
+    // within a small budget directly at the client, returning true and filling the
+    // result if successful.
+    // preprocessor (optional): a lambda which replaces a read job description with
+    // an equivalent, simplified one directly at the client. It returns a lambda
+    // which maps a result for the simplified job back to the original job
+    // (or an empty function if the description was left unchanged).
+    // tuner (optional): a lambda which adjusts the configuration of a (preprocessed)
+    // job description directly at the client before the job is introduced to the workers.
+    // resultObserver (optional): a lambda which the client calls for each job which
+    // was processed by the workers, with the job's (original) result or, if the job
+    // was cancelled, an empty result.
     void registerApplication(const std::string& key,
         JobReader reader, 
         JobCreator creator, 
-        JobSolutionFormatter solutionFormatter
+        JobSolutionFormatter solutionFormatter,
+        JobQuickSolver quickSolver,
+        JobPreprocessor preprocessor,
+        JobTuner tuner,
+        JobResultObserver resultObserver
     ) {
         int appId = _app_entries.size();
         _app_key_to_app_id[key] = appId;
@@ -43,6 +63,10 @@ namespace app_registry {
         entry.reader = reader;
         entry.creator = creator;
         entry.solutionFormatter = solutionFormatter;
+        entry.quickSolver = quickSolver;
+        entry.preprocessor = preprocessor;
+        entry.tuner = tuner;
+        entry.resultObserver = resultObserver;
         _app_entries.push_back(std::move(entry));
     }
 
@@ -72,5 +96,21 @@ namespace app_registry {
         getAppKey(appId); // check existence
         return _app_entries.at(appId).solutionFormatter;
     }
+    JobQuickSolver getJobQuickSolver(int appId) {
+        getAppKey(appId); // check existence
+        return _app_entries.at(appId).quickSolver;
+    }
+    JobPreprocessor getJobPreprocessor(int appId) {
+        getAppKey(appId); // check existence
+        return _app_entries.at(appId).preprocessor;
+    }
+    JobTuner getJobTuner(int appId) {
+        getAppKey(appId); // check existence
+        return _app_entries.at(appId).tuner;
+    }
+    JobResultObserver getJobResultObserver(int appId) {
+        getAppKey(appId); // check existence
+        return _app_entries.at(appId).resultObserver;
+    }
 }
 
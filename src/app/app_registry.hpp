@@ -17,11 +17,20 @@ namespace app_registry {
     typedef std::function<bool(const Parameters&, const std::vector<std::string>&, JobDescription&)> JobReader;
     typedef std::function<Job*(const Parameters&, const Job::JobSetup&, AppMessageTable&)> JobCreator;
     typedef std::function<nlohmann::json(const JobResult&)> JobSolutionFormatter;
+    typedef std::function<bool(const Parameters&, const JobDescription&, JobResult&)> JobQuickSolver;
+    typedef std::function<void(JobResult&)> JobSolutionReconstructor;
+    typedef std::function<JobSolutionReconstructor(const Parameters&, JobDescription&)> JobPreprocessor;
+    typedef std::function<void(const Parameters&, JobDescription&)> JobTuner;
+    typedef std::function<void(const Parameters&, JobDescription&, const JobResult&)> JobResultObserver;
 
     void registerApplication(const std::string& key,
         JobReader reader, 
         JobCreator creator, 
-        JobSolutionFormatter resultPrinter
+        JobSolutionFormatter resultPrinter,
+        JobQuickSolver quickSolver = JobQuickSolver(),
+        JobPreprocessor preprocessor = JobPreprocessor(),
+        JobTuner tuner = JobTuner(),
+        JobResultObserver resultObserver = JobResultObserver()
     );
 
     int getAppId(const std::string& key);
@@ -30,4 +39,8 @@ namespace app_registry {
     JobReader getJobReader(int appId);
     JobCreator getJobCreator(int appId);
     JobSolutionFormatter getJobSolutionFormatter(int appId);
+    JobQuickSolver getJobQuickSolver(int appId);
+    JobPreprocessor getJobPreprocessor(int appId);
+    JobTuner getJobTuner(int appId);
+    JobResultObserver getJobResultObserver(int appId);
 }
@@ -41,6 +41,7 @@ void Job::commit(const JobRequest& req) {
     updateJobTree(req.requestedNodeIndex, req.rootRank, req.rootContextId, 
         req.requestingNodeRank, req.requestingNodeContextId);
     updateJobBalancingEpoch(_balancing_epoch_of_last_commitment);
+    if (req.requestedNodeIndex == 0) _light = req.light;
     _commitment = req;
 }
 
@@ -72,6 +73,13 @@ void Job::pushRevision(const std::shared_ptr<std::vector<uint8_t>>& data) {
         LOG(V3_VERB, "%s : literal threshold exceeded - cut down #threads to %i\n", toStr(), _threads_per_job);
     }
 
+    if (_light) {
+        // Light job: stay on a single PE and leave the PE's other threads to co-hosted light jobs
+        _max_demand = 1;
+        _threads_per_job = std::max(1, _threads_per_job / _params.lightJobsPerProcess());
+        LOG(V3_VERB, "%s : light job - %i threads\n", toStr(), _threads_per_job);
+    }
+
     _has_description = true;
     _result.reset();
 }
@@ -177,6 +177,8 @@ private:
     bool _continuous_growth;
     int _max_demand;
     int _threads_per_job;
+    bool _light {false};
+    bool _co_hosted {false};
     
     JobState _state;
     Mutex _job_manipulation_lock;
@@ -253,6 +255,11 @@ public:
     float getPriority() const {return _priority;}
     int getApplicationId() const {return _application_id;}
     bool isIncremental() const {return _incremental;}
+    // Light jobs are tiny jobs which never grow beyond their root and may share a PE with other light jobs.
+    bool isLight() const {return _light;}
+    // Whether this (light) job runs next to another job on its PE, see JobRegistry.
+    bool isCoHosted() const {return _co_hosted;}
+    void setCoHosted(bool coHosted) {_co_hosted = coHosted;}
     bool hasDescription() const {return _has_description;};
     const JobDescription& getDescription() const {assert(hasDescription()); return _description;};
     const std::shared_ptr<std::vector<uint8_t>>& getSerializedDescription(int revision) {return _description.getSerialization(revision);};
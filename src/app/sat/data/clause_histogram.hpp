@@ -31,6 +31,10 @@ public:
         _total.fetch_add(by, std::memory_order_relaxed);
     }
 
+    unsigned long long get(size_t size) const {
+        return _hist[std::min(size, _hist.size())-1]->load(std::memory_order_relaxed);
+    }
+
     std::string getReport() {
 
         // Find last position where actual information is stored
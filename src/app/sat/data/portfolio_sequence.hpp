@@ -53,6 +53,56 @@ struct PortfolioSequence {
             || std::any_of(cycle.begin(), cycle.end(), [&](auto& i) {return i.outputProof;});
     }
 
+    // Returns the item of the solver with the given global ID and writes its
+    // diversification index, i.e., the number of solvers of the same kind before it
+    // within the prefix or within the (repeated) cycle, respectively.
+    Item getItem(int globalId, int& diversificationIndex) const {
+        if (globalId < (int) prefix.size()) {
+            const Item& item = prefix[globalId];
+            diversificationIndex = std::count_if(prefix.begin(), prefix.begin()+globalId,
+                [&](auto& x) {return x.baseSolver == item.baseSolver;});
+            return item;
+        }
+        const int cyclePos = (globalId - prefix.size()) % cycle.size();
+        const int numFullCycles = (globalId - prefix.size()) / cycle.size();
+        const Item& item = cycle[cyclePos];
+        auto isSameSolver = [&](auto& x) {return x.baseSolver == item.baseSolver;};
+        diversificationIndex = numFullCycles * std::count_if(cycle.begin(), cycle.end(), isSameSolver)
+            + std::count_if(cycle.begin(), cycle.begin()+cyclePos, isSameSolver);
+        return item;
+    }
+
+    // A single solver configuration, i.e., a non-incremental item together with
+    // a diversification index, is written as e.g. "k3" or "c+0".
+    static std::string toConfiguration(const Item& item, int diversificationIndex) {
+        std::string out(1, (char) item.baseSolver);
+        if (item.flavour == SAT) out += "+";
+        if (item.flavour == UNSAT) out += "-";
+        return out + std::to_string(diversificationIndex);
+    }
+    static bool parseConfiguration(const std::string& str, Item& item, int& diversificationIndex) {
+        size_t i = 0;
+        if (i == str.size() || !std::islower(str[i])) return false;
+        item = Item();
+        switch (str[i++]) {
+        case 'k': item.baseSolver = KISSAT; break;
+        case 'c': item.baseSolver = CADICAL; break;
+        case 'l': item.baseSolver = LINGELING; break;
+        case 'g': item.baseSolver = GLUCOSE; break;
+        case 'm': item.baseSolver = MERGESAT; break;
+        default: return false;
+        }
+        if (i < str.size() && str[i] == '+') {item.flavour = SAT; i++;}
+        else if (i < str.size() && str[i] == '-') {item.flavour = UNSAT; i++;}
+        if (i == str.size()) return false;
+        diversificationIndex = 0;
+        for (; i < str.size(); i++) {
+            if (!std::isdigit(str[i]) || diversificationIndex > 100000) return false;
+            diversificationIndex = 10*diversificationIndex + (str[i]-'0');
+        }
+        return true;
+    }
+
 private:
 
     bool parse(const std::string& descriptor, int nbRepetitions, std::vector<Item>& prefix, std::vector<Item>& cycle) {
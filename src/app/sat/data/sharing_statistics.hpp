@@ -11,6 +11,9 @@ struct SharingStatistics {
 	unsigned long clausesDroppedAtExport = 0;
 	unsigned long clausesProcessFilteredAtExport = 0;
 	unsigned long clausesSolverFilteredAtExport = 0;
+	unsigned long backloggedClauses = 0;
+	unsigned long maxBackloggedClauses = 0;
+	unsigned long clausesDroppedFromBacklog = 0;
 	ClauseHistogram* histProduced;
 	ClauseHistogram* histFailedFilter;
 	ClauseHistogram* histAdmittedToDb;
@@ -27,6 +30,8 @@ struct SharingStatistics {
 			+ " drp:" + std::to_string(clausesDroppedAtExport) 
 					+ "(" + std::to_string((float) (0.01 * (int)(droppedRatio*100))) + ")"
 			+ " pflt:" + std::to_string(clausesProcessFilteredAtExport)
-			+ " sflt:" + std::to_string(clausesSolverFilteredAtExport);
+			+ " sflt:" + std::to_string(clausesSolverFilteredAtExport)
+			+ " blog:" + std::to_string(backloggedClauses) + "/" + std::to_string(maxBackloggedClauses)
+					+ "(" + std::to_string(clausesDroppedFromBacklog) + ")";
 	}
 };
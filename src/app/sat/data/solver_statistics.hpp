@@ -28,6 +28,9 @@ struct SolverStatistics {
 	unsigned long receivedClausesFiltered = 0;
 	unsigned long receivedClausesDigested = 0;
 	unsigned long receivedClausesDropped = 0;
+	// not imported due to literals fixed by the solver
+	unsigned long receivedClausesBlocked = 0;
+	unsigned long receivedLitsBlocked = 0;
 
 	std::string getReport() const {
 		return "pps:" + std::to_string(propagations)
@@ -42,6 +45,7 @@ struct SolverStatistics {
 			+ " (flt:" + std::to_string(receivedClausesFiltered)
 			+ " digd:" + std::to_string(receivedClausesDigested)
 			+ " drp:" + std::to_string(receivedClausesDropped)
+			+ " blk:" + std::to_string(receivedClausesBlocked)
 			+ ") + intim:" + std::to_string(imported) + "/" + std::to_string(imported+discarded);
 	}
 
@@ -59,5 +63,7 @@ struct SolverStatistics {
 		receivedClausesFiltered += other.receivedClausesFiltered;
 		receivedClausesDigested += other.receivedClausesDigested;
 		receivedClausesDropped += other.receivedClausesDropped;
+		receivedClausesBlocked += other.receivedClausesBlocked;
+		receivedLitsBlocked += other.receivedLitsBlocked;
 	}
 };
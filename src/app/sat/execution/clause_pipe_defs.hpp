@@ -10,7 +10,7 @@
 #define CLAUSE_PIPE_FILTER_IMPORT 'f'
 
 // -> filter; epoch
-// <- # admitted lits
+// <- # admitted lits; usefulness volume factor (per mille)
 #define CLAUSE_PIPE_DIGEST_IMPORT 'd'
 
 // -> InPlaceClauseAggregation; epoch
@@ -22,6 +22,9 @@
 // -> clauses; epoch start; epoch end; revision
 #define CLAUSE_PIPE_DIGEST_HISTORIC 'h'
 
+// -> clauses (see ClauseSnapshot); revision
+#define CLAUSE_PIPE_DIGEST_SNAPSHOT 'S'
+
 // -> {}
 #define CLAUSE_PIPE_DUMP_STATS 's'
 
@@ -29,3 +32,6 @@
 #define CLAUSE_PIPE_REDUCE_THREAD_COUNT 'X'
 
 #define CLAUSE_PIPE_START_NEXT_REVISION 'v'
+
+// <- increments of event counters (CounterRegistry::serializeIncrements)
+#define CLAUSE_PIPE_COUNTERS 'c'
@@ -120,6 +120,15 @@ SatEngine::SatEngine(const Parameters& params, const SatProcessConfig& config, L
 	const std::string keyCycle = "div-offset-cycle";
 	const int divOffsetPrefix = appConfig.map.count(keyPrefix) ? atoi(appConfig.map[keyPrefix].c_str()) : 0;
 	const int divOffsetCycle = appConfig.map.count(keyCycle) ? atoi(appConfig.map[keyCycle].c_str()) : 0;
+	// A solver configuration selected for this job by the client's portfolio tuning
+	// (see PortfolioTuner) replaces the solver with global ID 0, including its diversification index
+	std::string tunedConfig = appConfig.map["__PFT"];
+	while (!tunedConfig.empty() && tunedConfig.back() == '.') tunedConfig.pop_back();
+	PortfolioSequence::Item tunedItem;
+	int tunedDivIndex;
+	const bool tuned = !config.incremental && !tunedConfig.empty()
+		&& PortfolioSequence::parseConfiguration(tunedConfig, tunedItem, tunedDivIndex);
+	if (tuned) LOGGER(_logger, V3_VERB, "Tuned portfolio: %s replaces solver 0\n", tunedConfig.c_str());
 	// Read # clauses and # vars from app config
 	int numClauses, numVars;
 	std::vector<std::pair<int*, std::string>> fields {
@@ -203,6 +212,7 @@ SatEngine::SatEngine(const Parameters& params, const SatProcessConfig& config, L
 		break;
 	}
 	setup.adaptiveImportManager = params.adaptiveImportManager();
+	setup.eliminationAwareImport = params.eliminationAwareImport();
 	setup.maxNumSolvers = config.mpisize * params.numThreadsPerProcess();
 	setup.numVars = numVars;
 	setup.numOriginalClauses = numClauses;
@@ -242,6 +252,10 @@ SatEngine::SatEngine(const Parameters& params, const SatProcessConfig& config, L
 			}
 			setup.diversificationIndex += divOffsetCycle;
 		}
+		if (tuned && setup.globalId == 0) {
+			item = tunedItem;
+			setup.diversificationIndex = tunedDivIndex;
+		}
 		setup.solverType = item.baseSolver;
 		setup.flavour = item.flavour;
 		setup.doIncrementalSolving = setup.isJobIncremental && item.incremental;
@@ -249,6 +263,7 @@ SatEngine::SatEngine(const Parameters& params, const SatProcessConfig& config, L
 		setup.onTheFlyChecking = setup.certifiedUnsat && params.onTheFlyChecking();
 		setup.onTheFlyCheckModel = params.onTheFlyChecking() && params.onTheFlyCheckModel();
 		setup.plratProofOutput = params.plratProofOutput();
+		setup.onTheFlyBatchImports = params.onTheFlyBatchImports();
 		setup.modelCheckingLratConnector = modelCheckingLratConnector;
 		setup.avoidUnsatParticipation = (params.proofOutputFile.isSet() || params.onTheFlyChecking()) && !item.outputProof;
 		setup.exportClauses = !setup.avoidUnsatParticipation;
@@ -475,6 +490,11 @@ void SatEngine::digestHistoricClauses(int epochBegin, int epochEnd, std::vector<
 	_sharing_manager->digestHistoricClauses(epochBegin, epochEnd, clauseBuf);
 }
 
+void SatEngine::digestClauseSnapshot(std::vector<int>& clauseBuf) {
+	if (isCleanedUp()) return;
+	_sharing_manager->digestClauseSnapshot(clauseBuf);
+}
+
 void SatEngine::syncDeterministicSolvingAndCheckForLocalWinner() {
 	if (_block_result) {
 		_block_result = !_sharing_manager->syncDeterministicSolvingAndCheckForWinningSolver();
@@ -562,7 +582,8 @@ SatEngine::LastAdmittedStats SatEngine::getLastAdmittedClauseShare() {
 	return LastAdmittedStats {
 		_sharing_manager->getLastNumAdmittedClausesToImport(), 
 		_sharing_manager->getLastNumClausesToImport(),
-		_sharing_manager->getLastNumAdmittedLitsToImport()
+		_sharing_manager->getLastNumAdmittedLitsToImport(),
+		_sharing_manager->getUsefulnessVolumeFactor()
 	};
 }
 
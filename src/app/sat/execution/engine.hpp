@@ -78,11 +78,13 @@ public:
 	void digestSharingWithoutFilter(std::vector<int>& clauseBuf);
 	void returnClauses(std::vector<int>& clauseBuf);
 	void digestHistoricClauses(int epochBegin, int epochEnd, std::vector<int>& clauseBuf);
+	void digestClauseSnapshot(std::vector<int>& clauseBuf);
 
 	struct LastAdmittedStats {
 		int nbAdmittedCls;
 		int nbTotalCls;
 		int nbAdmittedLits;
+		float usefulnessVolumeFactor;
 	};
 	LastAdmittedStats getLastAdmittedClauseShare();
 
@@ -13,6 +13,8 @@
 #include "util/assert.hpp"
 
 #include "util/sys/bidirectional_anytime_pipe.hpp"
+#include "util/sys/counter_registry.hpp"
+#include "util/sys/futex_event.hpp"
 #include "util/sys/timer.hpp"
 #include "util/logger.hpp"
 #include "util/params.hpp"
@@ -90,6 +92,13 @@ private:
         _hsm->lastAdmittedStats = engine.getLastAdmittedClauseShare();
     }
 
+    void digestClauseSnapshot(SatEngine& engine, std::vector<int>&& data) {
+        LOGGER(_log, V5_DEBG, "DO digest clause snapshot\n");
+        int bufferRevision = popLast(data);
+        if (bufferRevision >= 0) engine.setClauseBufferRevision(bufferRevision);
+        engine.digestClauseSnapshot(data);
+    }
+
     int popLast(std::vector<int>& v) {
         int res = v.back();
         v.pop_back();
@@ -103,11 +112,16 @@ private:
             TmpDir::get()+_shmem_id+".fromsub.pipe",
             TmpDir::get()+_shmem_id+".tosub.pipe",
             &_hsm->childReadyToWrite);
+        // Wake up this main loop whenever the parent signals something,
+        // be it via shared memory or via a message arriving in the pipe
+        FutexEvent wakeup(&_hsm->wakeupEvents);
+        uint32_t lastWakeup = wakeup.get();
+        pipe.setIncomingMessageCallback([&]() {wakeup.signal();});
         pipe.open();
         LOGGER(_log, V4_VVER, "Pipes set up\n");
 
         // Wait until everything is prepared for the solver to begin
-        while (!_hsm->doBegin) doSleep();
+        while (!_hsm->doBegin) doSleep(wakeup, lastWakeup);
         
         // Terminate directly?
         if (checkTerminate(engine, false)) return;
@@ -120,7 +134,18 @@ private:
         // Import subsequent revisions
         importRevisions(engine);
         if (checkTerminate(engine, false)) return;
-        
+
+        // Import a clause snapshot which arrived before this process was started
+        if (_hsm->hasClauseSnapshot) {
+            char c;
+            while ((c = pipe.pollForData()) == 0) {
+                doSleep(wakeup, lastWakeup);
+                if (checkTerminate(engine, false)) return;
+            }
+            assert(c == CLAUSE_PIPE_DIGEST_SNAPSHOT);
+            digestClauseSnapshot(engine, pipe.readData(c));
+        }
+
         // Start solver threads
         engine.solve();
         
@@ -134,12 +159,15 @@ private:
 
         bool collectClauses = false;
         int exportLiteralLimit;
+        float exportQueryArrival;
         std::vector<int> incomingClauses;
+        float lastCounterForwarding = 0;
+        std::vector<long> forwardedCounterValues;
 
         // Main loop
         while (true) {
 
-            doSleep();
+            doSleep(wakeup, lastWakeup);
             Timer::cacheElapsedSeconds();
 
             // Terminate
@@ -182,9 +210,20 @@ private:
                     auto rtInfo = Proc::getRuntimeInfo(Proc::getPid(), Proc::SubprocessMode::FLAT);
                     LOGGER(_log, V3_VERB, "child_mem=%.3fGB\n", 0.001*0.001*rtInfo.residentSetSize);
 
+                    if (_params.sharedMemHugePages() != SharedMemory::NO_HUGE_PAGES) {
+                        auto hpStats = SharedMemory::getHugePageStats();
+                        double hugeMappedBytes = 1024.0 * Proc::getHugePageMappedSharedMemoryKbs(Proc::getPid());
+                        LOGGER(_log, V3_VERB, "child_shmem mapped=%.3fGB requested_huge=%.3fGB advised=%.3fGB explicit=%.3fGB huge_mapped=%.3fGB coverage=%.3f fallbacks=%i\n",
+                            1e-9*hpStats.mappedBytes, 1e-9*hpStats.requestedBytes, 1e-9*hpStats.advisedBytes,
+                            1e-9*hpStats.explicitBytes, 1e-9*hugeMappedBytes,
+                            hpStats.mappedBytes == 0 ? 0 : std::min(1.0, hugeMappedBytes / hpStats.mappedBytes),
+                            hpStats.numFallbacks);
+                    }
+
                 } else if (c == CLAUSE_PIPE_PREPARE_CLAUSES) {
                     collectClauses = true;
                     exportLiteralLimit = pipe.readData(c)[0];
+                    exportQueryArrival = pipe.getArrivalTimeOfLastRead();
 
                 } else if (c == CLAUSE_PIPE_FILTER_IMPORT) {
                     incomingClauses = pipe.readData(c);
@@ -197,7 +236,8 @@ private:
                     engine.setClauseBufferRevision(bufferRevision);
                     auto filter = engine.filterSharing(incomingClauses);
                     LOGGER(_log, V5_DEBG, "filter result has size %i\n", filter.size());
-                    pipe.writeData(filter, {epoch}, CLAUSE_PIPE_FILTER_IMPORT);
+                    pipe.writeData(filter, {getMicrosSince(pipe.getArrivalTimeOfLastRead()), epoch},
+                        CLAUSE_PIPE_FILTER_IMPORT);
                     if (winningSolverId >= 0) {
                         LOGGER(_log, V4_VVER, "winning solver ID: %i\n", winningSolverId);
                         engine.setWinningSolverId(winningSolverId);
@@ -207,7 +247,9 @@ private:
                     auto filter = pipe.readData(c);
                     int epoch = popLast(filter);
                     doImportClauses(engine, incomingClauses, &filter, -1, epoch);
-                    pipe.writeData({engine.getLastAdmittedClauseShare().nbAdmittedLits}, CLAUSE_PIPE_DIGEST_IMPORT);
+                    auto admittedStats = engine.getLastAdmittedClauseShare();
+                    pipe.writeData({admittedStats.nbAdmittedLits, (int) (1000 * admittedStats.usefulnessVolumeFactor),
+                        getMicrosSince(pipe.getArrivalTimeOfLastRead())}, CLAUSE_PIPE_DIGEST_IMPORT);
 
                 } else if (c == CLAUSE_PIPE_DIGEST_IMPORT_WITHOUT_FILTER) {
                     incomingClauses = pipe.readData(c);
@@ -233,6 +275,9 @@ private:
                     engine.setClauseBufferRevision(bufferRevision);
                     engine.digestHistoricClauses(epochBegin, epochEnd, data);
 
+                } else if (c == CLAUSE_PIPE_DIGEST_SNAPSHOT) {
+                    digestClauseSnapshot(engine, pipe.readData(c));
+
                 } else if (c == CLAUSE_PIPE_REDUCE_THREAD_COUNT) {
                     LOGGER(_log, V3_VERB, "DO reduce thread count\n");
                     pipe.readData(c);
@@ -263,6 +308,13 @@ private:
                 break;
             }
 
+            // Forward event counter increments to the parent's sysstate reduction
+            if (Timer::elapsedSecondsCached() - lastCounterForwarding >= 1) {
+                lastCounterForwarding = Timer::elapsedSecondsCached();
+                auto increments = CounterRegistry::serializeIncrements(forwardedCounterValues);
+                if (!increments.empty()) pipe.writeData(increments, CLAUSE_PIPE_COUNTERS);
+            }
+
             // Collect clauses if ready for sharing
             if (collectClauses && engine.isReadyToPrepareSharing()) {
                 LOGGER(_log, V5_DEBG, "DO export clauses\n");
@@ -271,7 +323,8 @@ private:
                 int numCollectedLits;
                 auto clauses = engine.prepareSharing(exportLiteralLimit, successfulSolverId, numCollectedLits);
                 if (!clauses.empty()) {
-                    pipe.writeData(clauses, {numCollectedLits, successfulSolverId}, CLAUSE_PIPE_PREPARE_CLAUSES);
+                    pipe.writeData(clauses, {getMicrosSince(exportQueryArrival), numCollectedLits, successfulSolverId},
+                        CLAUSE_PIPE_PREPARE_CLAUSES);
                 }
                 collectClauses = false;
             }
@@ -304,7 +357,8 @@ private:
                 if (*solutionSize > 0) {
                     solutionShmemId = _shmem_id + ".solution." + std::to_string(_hsm->solutionRevision);
                     solutionShmemSize =  *solutionSize*sizeof(int);
-                    solutionShmem = (char*) SharedMemory::create(solutionShmemId, solutionShmemSize);
+                    solutionShmem = (char*) SharedMemory::create(solutionShmemId, solutionShmemSize,
+                        (SharedMemory::HugePageMode) _params.sharedMemHugePages());
                     memcpy(solutionShmem, solutionVec.data(), solutionShmemSize);
                 }
                 lastSolvedRevision = result.revision;
@@ -353,10 +407,11 @@ private:
             aSize = *aSizePtr;
         }
 
+        auto hugePages = (SharedMemory::HugePageMode) _params.sharedMemHugePages();
         const int* fPtr = (const int*) accessMemory(_shmem_id + ".formulae." + std::to_string(revision),
-            sizeof(int) * fSize, SharedMemory::READONLY);
+            sizeof(int) * fSize, SharedMemory::READONLY, hugePages);
         const int* aPtr = (const int*) accessMemory(_shmem_id + ".assumptions." + std::to_string(revision),
-            sizeof(int) * aSize, SharedMemory::READONLY);
+            sizeof(int) * aSize, SharedMemory::READONLY, hugePages);
 
         if (_params.copyFormulaeFromSharedMem()) {
             // Copy formula and assumptions to your own local memory
@@ -389,8 +444,9 @@ private:
         LOGGER(_log, V3_VERB, "Read formula rev. %i (size:%lu,%lu) from shared memory in %.4fs\n", revision, fSize, aSize, time);
     }
 
-    void* accessMemory(const std::string& shmemId, size_t size, SharedMemory::AccessMode accessMode = SharedMemory::ARBITRARY) {
-        void* ptr = SharedMemory::access(shmemId, size, accessMode);
+    void* accessMemory(const std::string& shmemId, size_t size, SharedMemory::AccessMode accessMode = SharedMemory::ARBITRARY,
+            SharedMemory::HugePageMode hugePages = SharedMemory::NO_HUGE_PAGES) {
+        void* ptr = SharedMemory::access(shmemId, size, accessMode, hugePages);
         if (ptr == nullptr) {
             LOGGER(_log, V0_CRIT, "[ERROR] Could not access shmem %s\n", shmemId.c_str());  
             abort();
@@ -412,9 +468,14 @@ private:
         }
     }
 
-    void doSleep() {
-        // Wait until something happens
-        // (can be interrupted by Fork::wakeUp(hsm->childPid))
-        usleep(1000 /*1 millisecond*/);
+    void doSleep(FutexEvent& wakeup, uint32_t& lastWakeup) {
+        // Wait until something happens, but at most one millisecond
+        // since the solvers' state is polled as well
+        wakeup.wait(lastWakeup, 1000);
+        lastWakeup = wakeup.get();
+    }
+
+    int getMicrosSince(float time) {
+        return (int) (1000000 * std::max(0.0f, Timer::elapsedSeconds() - time));
     }
 };
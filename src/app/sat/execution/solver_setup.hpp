@@ -72,6 +72,8 @@ struct SolverSetup {
 	bool incrementLbdBeforeImport {false};
 	bool randomizeLbdBeforeImport {false};
 	bool adaptiveImportManager;
+	// drop shared clauses over the solver's eliminated or fixed variables before buffering them
+	bool eliminationAwareImport;
 
 
 	// Certified UNSAT and proof production
@@ -84,6 +86,8 @@ struct SolverSetup {
 	bool onTheFlyCheckModel;
 	// If on-the-fly checking is enabled: the on-the-fly checker uses plrat proof output.
 	bool plratProofOutput;
+	// If on-the-fly checking is enabled: imported clauses are submitted to the checker in batches.
+	bool onTheFlyBatchImports;
 	// If non-null, use this LratConnector instance for checking a model;
 	// if null && onTheFlyCheckModel, then *create* a model-checking LRAT connector instance yourself (also to use for others).
 	LratConnector* modelCheckingLratConnector {nullptr};
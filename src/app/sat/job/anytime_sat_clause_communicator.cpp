@@ -19,6 +19,11 @@
 #include "data/job_state.h"
 #include "util/option.hpp"
 #include "util/sys/timer.hpp"
+#include "util/sys/counter_registry.hpp"
+#include "util/tracer.hpp"
+
+static Counter cntClauseSnapshotsSent("sat.snapshots_sent");
+static Counter cntClauseSnapshotLitsSent("sat.snapshot_lits_sent");
 
 void advanceCollective(BaseSatJob* job, JobMessage& msg, int broadcastTag) {
     if (job->getJobTree().isRoot() && msg.tag != broadcastTag) {
@@ -46,7 +51,17 @@ AnytimeSatClauseCommunicator::AnytimeSatClauseCommunicator(const Parameters& par
             setup.slotsForSumOfLengthAndLbd = _params.groupClausesByLengthLbdSum();
             setup.numLiterals = _job->getBufferLimit(MyMpi::size(MPI_COMM_WORLD), false);
             return setup;
-        }(), _job)
+        }(), _params.clauseHistoryMemoryLiterals(), _job)
+    ),
+    _cls_snapshot(params.clauseSnapshotLiterals() <= 0 ? nullptr :
+        new ClauseSnapshot([&]() {
+            AdaptiveClauseStore::Setup setup;
+            setup.maxEffectiveClauseLength = _params.strictClauseLengthLimit()+ClauseMetadata::numInts();
+            setup.maxLbdPartitionedSize = _params.maxLbdPartitioningSize();
+            setup.slotsForSumOfLengthAndLbd = _params.groupClausesByLengthLbdSum();
+            setup.numLiterals = _params.clauseSnapshotLiterals();
+            return setup;
+        }())
     ),
     _sent_cert_unsat_ready_msg(!params.proofOutputFile.isSet() && !params.deterministicSolving()) {
 
@@ -74,6 +89,19 @@ void AnytimeSatClauseCommunicator::communicate() {
         _current_session->advanceSharing();
         if (_current_session->isDone()) {
             _time_of_last_epoch_conclusion = Timer::elapsedSecondsCached();
+            int numMissed = _current_session->getNumMissedContributions();
+            int numUnforwarded = _current_session->getNumFoldedUnforwardedContributions();
+            if (numUnforwarded > 0) {
+                _num_late_contributions_folded += numUnforwarded;
+                LOG(V4_VVER, "%s CS e=%i result arrived early - folded %i unforwarded contribs\n",
+                    _job->toStr(), _current_epoch, numUnforwarded);
+            }
+            if (numMissed > 0) {
+                _num_missed_contributions += numMissed;
+                LOG(V4_VVER, "%s CS e=%i missed %i contribs (total: missed=%i folded=%i dropped=%i)\n",
+                    _job->toStr(), _current_epoch, numMissed, _num_missed_contributions,
+                    _num_late_contributions_folded, _num_late_contributions_dropped);
+            }
             _cancelled_sessions.emplace_back(_current_session.release());
         }
     }
@@ -99,6 +127,25 @@ void AnytimeSatClauseCommunicator::communicate() {
     if (_cls_history) {
         _cls_history->handleFinishedTasks();
     }
+
+    // Newly joined node: catch up with the clauses shared so far
+    if (_cls_snapshot) requestClauseSnapshot();
+}
+
+void AnytimeSatClauseCommunicator::requestClauseSnapshot() {
+    if (_requested_cls_snapshot || _job->getJobTree().isRoot()) return;
+    // Do not wait for the solvers to be initialized: a snapshot which arrives
+    // early enough is imported before the solvers begin to solve
+    if (_job->getState() != ACTIVE) return;
+    auto time = Timer::elapsedSecondsCached();
+    if (_time_of_cls_snapshot_request > 0 && time - _time_of_cls_snapshot_request < 1) return;
+
+    _requested_cls_snapshot = true;
+    _time_of_cls_snapshot_request = time;
+    JobMessage msg(_job->getId(), _job->getContextId(), _job->getRevision(),
+        _current_epoch, MSG_REQUEST_CLAUSE_SNAPSHOT);
+    _job->getJobTree().sendToParent(msg);
+    Tracer::beginAsync("sharing", "snapshot", _job->getId());
 }
 
 void AnytimeSatClauseCommunicator::handle(int source, int mpiTag, JobMessage& msg) {
@@ -115,12 +162,18 @@ void AnytimeSatClauseCommunicator::handle(int source, int mpiTag, JobMessage& ms
                 _current_session->pruneChild(source);
             }
         }
+        if (msg.tag == MSG_REQUEST_CLAUSE_SNAPSHOT) {
+            // Parent is not ready yet: try again later
+            _requested_cls_snapshot = false;
+            Tracer::endAsync("sharing", "snapshot", _job->getId());
+        }
 
         return;
     }
 
     assert(msg.jobId == _job->getId());
     if (handleClauseHistoryMessage(source, mpiTag, msg)) return;
+    if (handleClauseSnapshotMessage(source, mpiTag, msg)) return;
     if (handleProofProductionMessage(source, mpiTag, msg)) return;
     if (handleClauseSharingMessage(source, mpiTag, msg)) return;
     assert(log_return_false("[ERROR] Unexpected job message mpitag=%i inttag=%i <= [%i]\n", mpiTag, msg.tag, source));
@@ -143,6 +196,39 @@ bool AnytimeSatClauseCommunicator::handleClauseHistoryMessage(int source, int mp
     return false;
 }
 
+bool AnytimeSatClauseCommunicator::handleClauseSnapshotMessage(int source, int mpiTag, JobMessage& msg) {
+    if (msg.tag == MSG_REQUEST_CLAUSE_SNAPSHOT) {
+        auto& tree = _job->getJobTree();
+        bool fromLeftChild = tree.hasLeftChild() && source == tree.getLeftChildNodeRank();
+        bool fromRightChild = tree.hasRightChild() && source == tree.getRightChildNodeRank();
+        if (!fromLeftChild && !fromRightChild) return true; // child left in the meantime
+
+        // Reply in any case so that the child can conclude its request
+        msg.tag = MSG_FORWARD_CLAUSE_SNAPSHOT;
+        int numLits = 0;
+        if (_cls_snapshot) {
+            numLits = _cls_snapshot->getNumLiterals();
+            if (numLits > 0) msg.payload = _cls_snapshot->read();
+        }
+        LOG(V4_VVER, "%s sending clause snapshot (%i lits, buflen=%lu) to [%i]\n",
+            _job->toStr(), numLits, msg.payload.size(), source);
+        cntClauseSnapshotsSent.add();
+        cntClauseSnapshotLitsSent.add(numLits);
+        if (fromLeftChild) tree.sendToLeftChild(msg);
+        else tree.sendToRightChild(msg);
+        return true;
+    }
+    if (msg.tag == MSG_FORWARD_CLAUSE_SNAPSHOT) {
+        float latency = Timer::elapsedSecondsCached() - _time_of_cls_snapshot_request;
+        Tracer::endAsync("sharing", "snapshot", _job->getId());
+        LOG(V3_VERB, "%s received clause snapshot (buflen=%lu, %lu bytes, latency %.4fs)\n",
+            _job->toStr(), msg.payload.size(), msg.payload.size()*sizeof(int), latency);
+        if (!msg.payload.empty()) _job->digestClauseSnapshot(msg.payload);
+        return true;
+    }
+    return false;
+}
+
 bool AnytimeSatClauseCommunicator::handleProofProductionMessage(int source, int mpiTag, JobMessage& msg) {
 
     if (msg.tag == MSG_NOTIFY_READY_FOR_PROOF_SAFE_SHARING) {
@@ -226,9 +312,40 @@ bool AnytimeSatClauseCommunicator::handleClauseSharingMessage(int source, int mp
         success = _current_session->advanceClauseAggregation(source, mpiTag, msg)
                 || _current_session->advanceFilterAggregation(source, mpiTag, msg);
     }
+    if (!success && (msg.tag == MSG_ALLREDUCE_CLAUSES || msg.tag == MSG_ALLREDUCE_FILTER))
+        success = handleStraySharingMessage(source, mpiTag, msg);
     return success;
 }
 
+bool AnytimeSatClauseCommunicator::handleStraySharingMessage(int source, int mpiTag, JobMessage& msg) {
+
+    // Only happens with anytime sharing, where a parent may give up waiting for a child
+    if (_params.clauseSharingChildDeadline() <= 0) return false;
+
+    if (mpiTag == MSG_JOB_TREE_REDUCTION && msg.epoch <= _current_epoch) {
+        // Late contribution of a child which missed the deadline
+        if (msg.tag == MSG_ALLREDUCE_CLAUSES && msg.payload.size() >= (size_t) InplaceClauseAggregation::numMetadataInts()) {
+            // Fold the clauses into the next epoch's sharing by re-exporting them locally
+            InplaceClauseAggregation(msg.payload).stripToRawBuffer();
+            if (!msg.payload.empty()) _job->returnClauses(msg.payload);
+            _num_late_contributions_folded++;
+        } else {
+            // A late filter is of no use any more
+            _num_late_contributions_dropped++;
+        }
+        LOG(V4_VVER, "%s CS late contrib e=%i tag=%i <= [%i]\n", _job->toStr(), msg.epoch, msg.tag, source);
+        return true;
+    }
+
+    if (mpiTag == MSG_JOB_TREE_BROADCAST) {
+        // The parent concluded an epoch which did not begin here yet: defer
+        if (msg.epoch > _current_epoch) _deferred_sharing_broadcast_msgs.emplace_back(source, std::move(msg));
+        return true;
+    }
+
+    return false;
+}
+
 void AnytimeSatClauseCommunicator::initiateClauseSharing(JobMessage& msg) {
 
     if (_current_session || !_deferred_sharing_initiation_msgs.empty()) {
@@ -251,9 +368,20 @@ void AnytimeSatClauseCommunicator::initiateClauseSharing(JobMessage& msg) {
     assert(compensationFactor >= 0.1 && compensationFactor <= 10);
 
     _current_session.reset(
-        new ClauseSharingSession(_params, _job, _cls_history.get(), _current_epoch, compensationFactor)
+        new ClauseSharingSession(_params, _job, _cls_history.get(), _cls_snapshot.get(), _current_epoch, compensationFactor)
     );
     advanceCollective(_job, msg, MSG_INITIATE_CLAUSE_SHARING);
+
+    // Digest results of this epoch which arrived early
+    for (auto it = _deferred_sharing_broadcast_msgs.begin(); it != _deferred_sharing_broadcast_msgs.end();) {
+        auto& [source, deferredMsg] = *it;
+        if (deferredMsg.epoch < _current_epoch) {
+            it = _deferred_sharing_broadcast_msgs.erase(it);
+        } else if (deferredMsg.epoch == _current_epoch && _current_session) {
+            handleClauseSharingMessage(source, MSG_JOB_TREE_BROADCAST, deferredMsg);
+            it = _deferred_sharing_broadcast_msgs.erase(it);
+        } else ++it;
+    }
 }
 
 void AnytimeSatClauseCommunicator::tryActivateDeferredSharingInitiation() {
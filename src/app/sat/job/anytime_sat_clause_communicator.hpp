@@ -16,6 +16,7 @@
 #include "clause_sharing_session.hpp"
 #include "app/sat/proof/proof_producer.hpp"
 #include "app/sat/job/historic_clause_storage.hpp"
+#include "app/sat/job/clause_snapshot.hpp"
 
 class BaseSatJob; // fwd decl
 class HistoricClauseStorage; // fwd decl
@@ -29,6 +30,11 @@ private:
 
     std::unique_ptr<HistoricClauseStorage> _cls_history;
 
+    // Snapshot of the best clauses shared so far, sent to joining children
+    std::unique_ptr<ClauseSnapshot> _cls_snapshot;
+    bool _requested_cls_snapshot {false};
+    float _time_of_cls_snapshot_request {0};
+
     std::unique_ptr<ClauseSharingSession> _current_session;
     std::list<std::unique_ptr<ClauseSharingSession>> _cancelled_sessions;
 
@@ -43,6 +49,12 @@ private:
 
     JobMessage _msg_unsat_found;
     std::list<JobMessage> _deferred_sharing_initiation_msgs;
+    // Anytime sharing: broadcasts of epochs which did not begin locally yet (with source rank)
+    std::list<std::pair<int, JobMessage>> _deferred_sharing_broadcast_msgs;
+    // Anytime sharing: accounting of child contributions which missed the deadline
+    int _num_missed_contributions {0};
+    int _num_late_contributions_folded {0};
+    int _num_late_contributions_dropped {0};
 
     bool _initiated_proof_assembly = false;
     std::unique_ptr<ProofProducer> _proof_producer;
@@ -62,8 +74,11 @@ public:
 
 private:
     bool handleClauseHistoryMessage(int source, int mpiTag, JobMessage& msg);
+    bool handleClauseSnapshotMessage(int source, int mpiTag, JobMessage& msg);
+    void requestClauseSnapshot();
     bool handleProofProductionMessage(int source, int mpiTag, JobMessage& msg);
     bool handleClauseSharingMessage(int source, int mpiTag, JobMessage& msg);
+    bool handleStraySharingMessage(int source, int mpiTag, JobMessage& msg);
 
     void addToClauseHistory(std::vector<int>& clauses, int epoch);
 
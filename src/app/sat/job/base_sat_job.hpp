@@ -56,6 +56,9 @@ public:
     virtual bool hasPreparedSharing() = 0;
     virtual std::vector<int> getPreparedClauses(Checksum& checksum, int& successfulSolverId, int& numLits) = 0;
     virtual int getLastAdmittedNumLits() = 0;
+    // Factor in (0,1] by which the desired sharing volume is reduced if imported
+    // clauses turned out not to be useful (see -cuf)
+    virtual float getLastUsefulnessVolumeFactor() = 0;
     virtual void setClauseBufferRevision(int revision) = 0;
 
     virtual void filterSharing(int epoch, std::vector<int>& clauses) = 0;
@@ -66,6 +69,7 @@ public:
     
     virtual void returnClauses(std::vector<int>& clauses) = 0;
     virtual void digestHistoricClauses(int epochBegin, int epochEnd, std::vector<int>& clauses) = 0;
+    virtual void digestClauseSnapshot(std::vector<int>& clauses) = 0;
 
     // Methods common to all Job instances
 
@@ -129,6 +133,7 @@ public:
         auto defaultBuflim = MyMpi::getBinaryTreeBufferLimit(getVolume(),
             _params.clauseBufferBaseSize(), _params.clauseBufferLimitParam(),
             MyMpi::BufferQueryMode(_params.clauseBufferLimitMode()));
+        if (_params.clauseUsefulnessFeedback()) defaultBuflim *= getLastUsefulnessVolumeFactor();
         float priorCompensationFactor = _compensation_factor;
 
         if (_params.compensateUnusedSharingVolume()) {
@@ -13,8 +13,11 @@
 #include "base_sat_job.hpp"
 #include "comm/job_tree_all_reduction.hpp"
 #include "historic_clause_storage.hpp"
+#include "clause_snapshot.hpp"
 #include "app/sat/sharing/filter/in_place_clause_filtering.hpp"
+#include "app/sat/sharing/filter/sparse_filter_vector.hpp"
 #include "util/random.hpp"
+#include "util/tracer.hpp"
 #include "inplace_sharing_aggregation.hpp"
 #include <cstdint>
 
@@ -24,6 +27,7 @@ private:
     const Parameters& _params;
     BaseSatJob* _job;
     HistoricClauseStorage* _cls_history;
+    ClauseSnapshot* _cls_snapshot;
     int _epoch;
     enum Stage {
         PRODUCING_CLAUSES,
@@ -38,6 +42,7 @@ private:
     int _local_export_limit;
     int _num_broadcast_clauses;
     int _num_admitted_clauses;
+    int _num_folded_unforwarded_elems {0};
 
     JobTreeAllReduction _allreduce_clauses;
     std::optional<JobTreeAllReduction> _allreduce_filter;
@@ -46,8 +51,8 @@ private:
 
 public:
     ClauseSharingSession(const Parameters& params, BaseSatJob* job,
-            HistoricClauseStorage* clsHistory, int epoch, float compensationFactor) : 
-        _params(params), _job(job), _cls_history(clsHistory), _epoch(epoch),
+            HistoricClauseStorage* clsHistory, ClauseSnapshot* clsSnapshot, int epoch, float compensationFactor) : 
+        _params(params), _job(job), _cls_history(clsHistory), _cls_snapshot(clsSnapshot), _epoch(epoch),
         _allreduce_clauses(
             job->getJobTree(),
             // Base message 
@@ -74,7 +79,17 @@ public:
             );
         }
 
+        // Anytime mode: do not let a single slow child hold up the whole sharing.
+        // Not applicable if all contributions are required for correctness.
+        if (_params.clauseSharingChildDeadline() > 0 && !ClauseMetadata::enabled()
+                && !_params.deterministicSolving()) {
+            _allreduce_clauses.setChildDeadline(_params.clauseSharingChildDeadline());
+            if (_allreduce_filter) _allreduce_filter->setChildDeadline(_params.clauseSharingChildDeadline());
+        }
+
         LOG(V5_DEBG, "%s CS OPEN e=%i\n", _job->toStr(), _epoch);
+        Tracer::beginAsync("sharing", "epoch", getTraceId(), {"job", _job->getId(), "epoch", _epoch});
+        Tracer::beginAsync("sharing", getStageName(_stage), getTraceId());
         _local_export_limit = _job->setSharingCompensationFactorAndUpdateExportLimit(compensationFactor);
         if (!_job->hasPreparedSharing()) _job->prepareSharing();
     }
@@ -100,7 +115,13 @@ public:
                 return clauses;
             });
 
-            _stage = AGGREGATING_CLAUSES;
+            setStage(AGGREGATING_CLAUSES);
+
+        } else if (_stage == PRODUCING_CLAUSES && _allreduce_clauses.hasResult()) {
+            // The parent gave up waiting for this subtree (anytime mode):
+            // the clauses still to be exported are shared in the next epoch
+            LOG(V4_VVER, "%s CS result arrived before local clauses\n", _job->toStr());
+            setStage(AGGREGATING_CLAUSES);
         }
 
         if (_stage == AGGREGATING_CLAUSES && _allreduce_clauses.advance().hasResult()) {
@@ -114,6 +135,15 @@ public:
 
             // Fetch initial clause buffer (result of all-reduction of clauses)
             _broadcast_clause_buffer = _allreduce_clauses.extractResult();
+
+            // The parent gave up waiting for this subtree (anytime mode) after the local
+            // clauses were produced: fold them (and the children's) into the next epoch
+            for (auto& elem : _allreduce_clauses.extractUnforwardedElems()) {
+                if (elem.size() < (size_t) InplaceClauseAggregation::numMetadataInts()) continue;
+                InplaceClauseAggregation(elem).stripToRawBuffer();
+                if (!elem.empty()) _job->returnClauses(elem);
+                _num_folded_unforwarded_elems++;
+            }
             auto aggregation = InplaceClauseAggregation(_broadcast_clause_buffer);
             // If desired, scramble the LBD scores of featured clauses
             if (_params.scrambleLbdScores()) {
@@ -140,45 +170,51 @@ public:
                 // Initiate production of local filter element for 2nd all-reduction 
                 LOG(V5_DEBG, "%s CS filter\n", _job->toStr());
                 _job->filterSharing(_epoch, _broadcast_clause_buffer);
-                _stage = PRODUCING_FILTER;
+                setStage(PRODUCING_FILTER);
             } else {
                 // No distributed filtering: Sharing is done!
                 LOG(V5_DEBG, "%s CS digest w/o filter\n", _job->toStr());
                 _job->digestSharingWithoutFilter(_epoch, _broadcast_clause_buffer);
-                if (_cls_history) {
+                if (_cls_history || _cls_snapshot) {
                     InplaceClauseAggregation(_broadcast_clause_buffer).stripToRawBuffer();
-                    _cls_history->importSharing(_epoch, std::move(_broadcast_clause_buffer));
+                    storeSharedClauses();
                 }
-                _stage = DONE;
+                setStage(DONE);
             }
         }
 
         if (_stage == PRODUCING_FILTER && _job->hasFilteredSharing(_epoch)) {
 
             _allreduce_filter->produce([&]() {
-                auto f = _job->getLocalFilter(_epoch);
-                LOG(V5_DEBG, "%s CS produced filter, size %i\n", _job->toStr(), f.size());
+                auto f = SparseFilterVector::compress(_job->getLocalFilter(_epoch));
+                LOG(V5_DEBG, "%s CS produced filter, size %i (enc=%i)\n", _job->toStr(),
+                    f.size(), SparseFilterVector::getEncoding(f));
                 return f;
             });
-            _stage = AGGREGATING_FILTER;
+            setStage(AGGREGATING_FILTER);
+
+        } else if (_stage == PRODUCING_FILTER && _allreduce_filter->hasResult()) {
+            LOG(V4_VVER, "%s CS result arrived before local filter\n", _job->toStr());
+            setStage(AGGREGATING_FILTER);
         }
 
         if (_stage == AGGREGATING_FILTER && _allreduce_filter->advance().hasResult()) {
 
 
             // Extract and digest result
-            auto filter = _allreduce_filter->extractResult();
-            LOG(V5_DEBG, "%s CS digest w/ filter, size %i\n", _job->toStr(), filter.size());
+            auto encodedFilter = _allreduce_filter->extractResult();
+            auto filter = SparseFilterVector::decompress(encodedFilter);
+            LOG(V5_DEBG, "%s CS digest w/ filter, size %i (encoded %i)\n", _job->toStr(),
+                filter.size(), encodedFilter.size());
             _job->applyFilter(_epoch, filter);
-            if (_cls_history) {
+            if (_cls_history || _cls_snapshot) {
                 InplaceClauseAggregation(_broadcast_clause_buffer).stripToRawBuffer();
                 applyGlobalFilter(filter, _broadcast_clause_buffer);
-                // Add clause batch to history
-                _cls_history->importSharing(_epoch, std::move(_broadcast_clause_buffer));
+                storeSharedClauses();
             }
 
             // Conclude this sharing epoch
-            _stage = DONE;
+            setStage(DONE);
         }
     }
 
@@ -203,6 +239,18 @@ public:
         return _stage == DONE;
     }
 
+    // The number of child contributions which this node did not wait for (anytime mode).
+    int getNumMissedContributions() const {
+        return _allreduce_clauses.getNumMissedChildElems()
+            + (_allreduce_filter ? _allreduce_filter->getNumMissedChildElems() : 0);
+    }
+
+    // The number of contributions of this subtree which missed the parent's
+    // deadline and were folded into the next sharing (anytime mode).
+    int getNumFoldedUnforwardedContributions() const {
+        return _num_folded_unforwarded_elems;
+    }
+
     bool isDestructible() {
         return _allreduce_clauses.isDestructible() && 
             (!_allreduce_filter || _allreduce_filter->isDestructible());
@@ -210,6 +258,7 @@ public:
 
     ~ClauseSharingSession() {
         LOG(V5_DEBG, "%s CS CLOSE e=%i\n", _job->toStr(), _epoch);
+        if (_stage != DONE) setStage(DONE);
         // If not done producing, will send empty clause buffer upwards
         _allreduce_clauses.cancel();
         // If not done producing, will send empty filter upwards
@@ -217,6 +266,34 @@ public:
     }
 
 private:
+    uint64_t getTraceId() const {
+        return (((uint64_t) _job->getId()) << 32) | (uint32_t) _epoch;
+    }
+    static const char* getStageName(Stage stage) {
+        switch (stage) {
+        case PRODUCING_CLAUSES: return "produce clauses";
+        case AGGREGATING_CLAUSES: return "aggregate clauses";
+        case PRODUCING_FILTER: return "produce filter";
+        case AGGREGATING_FILTER: return "aggregate filter";
+        default: return "done";
+        }
+    }
+    void setStage(Stage stage) {
+        Tracer::endAsync("sharing", getStageName(_stage), getTraceId());
+        _stage = stage;
+        if (_stage == DONE) Tracer::endAsync("sharing", "epoch", getTraceId());
+        else Tracer::beginAsync("sharing", getStageName(_stage), getTraceId());
+    }
+
+    void storeSharedClauses() {
+        if (_cls_snapshot) {
+            if (_cls_history) _cls_snapshot->insert(std::vector<int>(_broadcast_clause_buffer));
+            else _cls_snapshot->insert(std::move(_broadcast_clause_buffer));
+        }
+        // Add clause batch to history
+        if (_cls_history) _cls_history->importSharing(_epoch, std::move(_broadcast_clause_buffer));
+    }
+
     void applyGlobalFilter(const std::vector<int>& filter, std::vector<int>& clauses) {
         
         InPlaceClauseFiltering filtering(_params, clauses, filter);
@@ -275,29 +352,18 @@ private:
     }
 
     std::vector<int> mergeFiltersDuringAggregation(std::list<std::vector<int>>& elems) {
-        std::vector<int> filter = std::move(elems.front());
-        elems.pop_front();
 
-        unsigned long maxMinEpochId;
+        unsigned long maxMinEpochId = 0;
         if (ClauseMetadata::enabled()) {
-            assert(filter.size() >= 2);
-            maxMinEpochId = ClauseMetadata::readUnsignedLong(filter.data());
-        }
-
-        for (auto& elem : elems) {
-            if (filter.size() < elem.size()) 
-                filter.resize(elem.size());
-            if (ClauseMetadata::enabled()) {
+            for (auto& elem : elems) {
                 assert(elem.size() >= 2);
-                unsigned long minEpochId = ClauseMetadata::readUnsignedLong(elem.data());
-                maxMinEpochId = std::max(maxMinEpochId, minEpochId);
-            }
-
-            for (size_t i = ClauseMetadata::enabled() ? 2 : 0; i < elem.size(); i++) {
-                filter[i] |= elem[i]; // bitwise OR
+                maxMinEpochId = std::max(maxMinEpochId, ClauseMetadata::readUnsignedLong(elem.data()));
             }
         }
 
+        // Bitwise OR on the compressed filters
+        std::vector<int> filter = SparseFilterVector::merge(elems);
+
         if (ClauseMetadata::enabled()) {
             ClauseMetadata::writeUnsignedLong(maxMinEpochId, filter.data());
         }
@@ -0,0 +1,91 @@
+
+#pragma once
+
+#include <chrono>
+#include <future>
+#include <list>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "app/sat/data/clause.hpp"
+#include "app/sat/data/produced_clause_candidate.hpp"
+#include "app/sat/sharing/filter/exact_clause_filter.hpp"
+#include "app/sat/sharing/filter/generic_clause_filter.hpp"
+#include "app/sat/sharing/store/adaptive_clause_store.hpp"
+#include "app/sat/sharing/buffer/buffer_reader.hpp"
+#include "util/sys/thread_pool.hpp"
+#include "util/sys/threading.hpp"
+
+// Size-bounded collection of the best clauses shared within a job so far,
+// deduplicated and ordered by quality (length, then LBD). A job tree node sends
+// its snapshot to a newly joining child so that the child's solvers can import it
+// right away instead of only learning from future sharing epochs.
+// Clauses are inserted asynchronously in the process-wide thread pool.
+class ClauseSnapshot {
+
+private:
+    std::unique_ptr<AdaptiveClauseStore> _store;
+    std::unique_ptr<GenericClauseStore> _filter_store; // only a dummy required for the filter
+    std::unique_ptr<ExactClauseFilter> _filter;
+    Mutex _mtx;
+
+    std::list<std::future<void>> _insertions;
+
+public:
+    ClauseSnapshot(const AdaptiveClauseStore::Setup& setup) :
+        _store(new AdaptiveClauseStore(setup)),
+        _filter_store(new AdaptiveClauseStore(setup)),
+        _filter(new ExactClauseFilter(*_filter_store, std::numeric_limits<int>::max(), setup.maxEffectiveClauseLength)) {}
+
+    // Adds the clauses of a (raw) buffer of shared clauses. Clauses already present
+    // are ignored; if the snapshot is full, the worst clauses are dropped.
+    void insert(std::vector<int>&& clauses) {
+        collectFinishedInsertions();
+        _insertions.push_back(ProcessWideThreadPool::get().addTask([this, clauses = std::move(clauses)]() mutable {
+            auto lock = _mtx.getLock();
+            // Clauses deleted from the store to make room for better ones
+            // must also be erased from the filter
+            _store->setClauseDeletionCallback([&](Mallob::Clause& cls) {
+                ProducedClauseCandidate pcc(cls.begin, cls.size, cls.lbd, 0, 0);
+                _filter->erase(pcc);
+            });
+            BufferReader reader = _store->getBufferReader(clauses.data(), clauses.size());
+            Mallob::Clause cls = reader.getNextIncomingClause();
+            while (cls.begin != nullptr) {
+                _filter->tryRegisterAndInsert(ProducedClauseCandidate(cls.begin, cls.size, cls.lbd, 0, 0), _store.get());
+                cls = reader.getNextIncomingClause();
+            }
+            _store->discardFreedClauses();
+            _store->clearClauseDeletionCallbacks();
+        }));
+    }
+
+    // Returns all clauses in the snapshot as a (raw) clause buffer.
+    std::vector<int> read() {
+        auto lock = _mtx.getLock();
+        return _store->readBuffer();
+    }
+
+    int getNumLiterals() {
+        auto lock = _mtx.getLock();
+        return _store->getCurrentlyUsedLiterals();
+    }
+
+    void waitForInsertions() {
+        for (auto& future : _insertions) future.get();
+        _insertions.clear();
+    }
+
+    ~ClauseSnapshot() {
+        waitForInsertions();
+    }
+
+private:
+    void collectFinishedInsertions() {
+        while (!_insertions.empty() && _insertions.front().wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+            _insertions.front().get();
+            _insertions.pop_front();
+        }
+    }
+};
@@ -274,6 +274,10 @@ int ForkedSatJob::getLastAdmittedNumLits() {
     if (!_initialized) return 0;
     return _solver->getLastAdmittedNumLits();
 }
+float ForkedSatJob::getLastUsefulnessVolumeFactor() {
+    if (!_initialized) return 1;
+    return _solver->getLastUsefulnessVolumeFactor();
+}
 void ForkedSatJob::setClauseBufferRevision(int revision) {
     if (!isInitialized()) return;
     _solver->setClauseBufferRevision(revision);
@@ -311,6 +315,10 @@ void ForkedSatJob::digestHistoricClauses(int epochBegin, int epochEnd, std::vect
     if (!_initialized) return;
     _solver->digestHistoricClauses(epochBegin, epochEnd, clauses);
 }
+void ForkedSatJob::digestClauseSnapshot(std::vector<int>& clauses) {
+    if (!_initialized) return;
+    _solver->digestClauseSnapshot(clauses);
+}
 
 void ForkedSatJob::startDestructThreadIfNecessary() {
     // Ensure concurrent destruction of shared memory
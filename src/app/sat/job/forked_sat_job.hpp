@@ -76,6 +76,7 @@ public:
     bool hasPreparedSharing() override;
     std::vector<int> getPreparedClauses(Checksum& checksum, int& successfulSolverId, int& numLits) override;
     int getLastAdmittedNumLits() override;
+    float getLastUsefulnessVolumeFactor() override;
     virtual void setClauseBufferRevision(int revision) override;
 
     virtual void filterSharing(int epoch, std::vector<int>& clauses) override;
@@ -86,6 +87,7 @@ public:
     
     virtual void returnClauses(std::vector<int>& clauses) override;
     virtual void digestHistoricClauses(int epochBegin, int epochEnd, std::vector<int>& clauses) override;
+    virtual void digestClauseSnapshot(std::vector<int>& clauses) override;
 
 private:
     void doStartSolver();
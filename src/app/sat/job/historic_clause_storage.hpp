@@ -2,6 +2,7 @@
 #pragma once
 
 #include <assert.h>
+#include <stdio.h>
 #include <limits>
 #include <algorithm>
 #include <iterator>
@@ -19,11 +20,15 @@
 #include "app/sat/sharing/store/adaptive_clause_store.hpp"
 #include "app/sat/sharing/store/generic_clause_store.hpp"
 #include "comm/msgtags.h"
+#include "comm/mympi.hpp"
 #include "data/job_transfer.hpp"
 #include "util/params.hpp"
 #include "base_sat_job.hpp"
 #include "util/logger.hpp"
+#include "util/sys/fileutils.hpp"
 #include "util/sys/process.hpp"
+#include "util/sys/proc.hpp"
+#include "util/sys/tmpdir.hpp"
 #include "util/sys/thread_pool.hpp"
 #include "util/sys/threading.hpp"
 #include "app/job_tree.hpp"
@@ -38,6 +43,7 @@ class HistoricClauseStorage {
 private:
     struct StorageDiagnostics {
         int numLitsInStorage;
+        int numLitsSpilled;
         int numClausesInStorage;
         std::string slotLayout;
     };
@@ -68,11 +74,24 @@ private:
         struct Slot {
             int epochBegin;
             int epochEnd;
-            AdaptiveClauseStore cdb;
+            std::unique_ptr<AdaptiveClauseStore> cdb; // null if spilled
+            std::string spillFile; // non-empty if spilled
+            int numSpilledLits {0};
             Slot(int epochBegin, int epochEnd, AdaptiveClauseStore::Setup setup) : 
-                epochBegin(epochBegin), epochEnd(epochEnd), cdb(setup) {}
+                epochBegin(epochBegin), epochEnd(epochEnd), cdb(new AdaptiveClauseStore(setup)) {}
+            bool spilled() const {return !cdb;}
+            ~Slot() {
+                if (!spillFile.empty()) FileUtils::rm(spillFile);
+            }
         };
         std::list<Slot> _storage_list;
+        // Once the slots in memory exceed this many literals, the oldest slots
+        // are written to files (in the flat buffer format) and read back on demand.
+        // The filter only holds the clauses of slots in memory, so the limit bounds both;
+        // duplicates of spilled clauses are detected again once their slot is restored.
+        int _max_lits_in_memory;
+        std::string _spill_file_prefix;
+        int _num_spills {0};
         std::unique_ptr<GenericClauseStore> _filter_store; // really only a dummy required for the filter
         std::unique_ptr<ExactClauseFilter> _filter;
 
@@ -84,7 +103,8 @@ private:
         int _num_open_tasks {0};
 
     public:
-        Worker(const AdaptiveClauseStore::Setup& setup) : _setup(setup),
+        Worker(const AdaptiveClauseStore::Setup& setup, int maxLitsInMemory, const std::string& spillFilePrefix) :
+                _setup(setup), _max_lits_in_memory(maxLitsInMemory), _spill_file_prefix(spillFilePrefix),
                 _filter_store(new AdaptiveClauseStore(_setup)),
                 _filter(new ExactClauseFilter(*_filter_store, std::numeric_limits<int>::max(), _setup.maxEffectiveClauseLength)) {
             _bg_worker.run([this]() {runBackgroundWorker();});
@@ -162,8 +182,8 @@ private:
                     task.epochBegin = slot.epochBegin;
                     task.epochEnd = slot.epochEnd;
                     // Read clauses from the slot into the task's clauses
-                    int numExported;
-                    task.clauses = slot.cdb.readBuffer();
+                    // (a spilled slot is streamed back from its file without restoring it)
+                    task.clauses = slot.spilled() ? readSpillFile(slot) : slot.cdb->readBuffer();
                     return;
                 }
             }
@@ -178,7 +198,8 @@ private:
                 bool success = false;
                 for (auto& slot : _storage_list) {
                     if (areIntervalsOverlapping(slot.epochBegin, slot.epochEnd, task.epochBegin, task.epochEnd)) {
-                        auto [accepted, total] = addClausesIntoDatabase(slot.cdb, task.clauses, 
+                        restore(slot);
+                        auto [accepted, total] = addClausesIntoDatabase(*slot.cdb, task.clauses, 
                             task.epochBegin, ClauseAdditionMode::INSERT_AND_IMPORT);
                         // The clauses in task.clauses are now the ones which HAVE been inserted successfully,
                         // i.e., the ones which were not contained in the storage yet
@@ -194,7 +215,7 @@ private:
 
                 // Create new storage slot of breadth 1
                 _storage_list.emplace_back(task.epochBegin, task.epochBegin+1, _setup);
-                AdaptiveClauseStore& cdb = _storage_list.back().cdb;
+                AdaptiveClauseStore& cdb = *_storage_list.back().cdb;
 
                 // Insert non-duplicate clauses into new storage slot as well as lookup table
                 auto [accepted, total] = addClausesIntoDatabase(cdb, task.clauses, 
@@ -204,16 +225,21 @@ private:
                 // Repair invariant of having at most _max_same_breadth_slots slots of the same breadth.
                 mergeSlots();
             }
+
+            enforceMemoryLimit();
         }
 
         void addStorageDiagnosticsToTask(BackgroundTask& task) {
 
             int numStoredLits = 0;
+            int numSpilledLits = 0;
             for (auto& slot : _storage_list) {
-                numStoredLits += slot.cdb.getCurrentlyUsedLiterals();
+                if (slot.spilled()) numSpilledLits += slot.numSpilledLits;
+                else numStoredLits += slot.cdb->getCurrentlyUsedLiterals();
             }
             task.storageDiagnostics.numClausesInStorage = _filter->size(0);
-            task.storageDiagnostics.numLitsInStorage = numStoredLits;
+            task.storageDiagnostics.numLitsInStorage = numStoredLits + numSpilledLits;
+            task.storageDiagnostics.numLitsSpilled = numSpilledLits;
             if (_storage_list.back().epochEnd < 80)
                 task.storageDiagnostics.slotLayout = reportSlots();
             else
@@ -260,7 +286,9 @@ private:
                 // Update slot breadth
                 slot.epochEnd = slotAfter.epochEnd;
                 // Merge the two clause databases
-                mergeDatabases(slot.cdb, slotAfter.cdb);
+                restore(slot);
+                restore(slotAfter);
+                mergeDatabases(*slot.cdb, *slotAfter.cdb);
                 // Delete old slot
                 it = _storage_list.erase(itAfter);
                 --it; // visit the merged slot again
@@ -270,7 +298,6 @@ private:
         void mergeDatabases(AdaptiveClauseStore& into, AdaptiveClauseStore& from) {
             
             // Flush clauses from "from"
-            int numExported;
             auto clauses = from.readBuffer();
 
             // Insert clauses into "into"
@@ -326,14 +353,114 @@ private:
             return std::pair<int, int>(numAccepted, numTotal);
         }
 
+        void enforceMemoryLimit() {
+            if (_max_lits_in_memory <= 0) return;
+
+            // Stored clauses plus their copies in the filter
+            size_t numLitsInMemory = getNumLitsInFilter();
+            for (auto& slot : _storage_list) if (!slot.spilled())
+                numLitsInMemory += slot.cdb->getCurrentlyUsedLiterals();
+
+            // Spill the oldest slots first; the newest slot always remains in memory
+            // since it is subject to frequent merges.
+            for (auto it = _storage_list.begin(); numLitsInMemory > (size_t) _max_lits_in_memory
+                    && it != _storage_list.end() && std::next(it) != _storage_list.end(); ++it) {
+                auto& slot = *it;
+                if (slot.spilled()) continue;
+                int numLits = slot.cdb->getCurrentlyUsedLiterals();
+                if (numLits == 0) continue;
+                if (!spill(slot)) {
+                    // I/O failure: keep everything in memory from now on
+                    LOG(V1_WARN, "[WARN] HCS cannot spill to %s - disabling spilling\n", _spill_file_prefix.c_str());
+                    _max_lits_in_memory = 0;
+                    return;
+                }
+                // The slot's clauses left memory along with their copies in the filter
+                numLitsInMemory -= std::min(numLitsInMemory, 2 * (size_t) numLits);
+            }
+        }
+
+        size_t getNumLitsInFilter() const {
+            size_t numLits = 0;
+            for (int len = 1; len <= _setup.maxEffectiveClauseLength; len++)
+                numLits += len * _filter->size(len);
+            return numLits;
+        }
+
+        bool spill(Slot& slot) {
+            auto clauses = slot.cdb->readBuffer();
+            std::string file = _spill_file_prefix + "." + std::to_string(_num_spills++);
+            FILE* f = fopen(file.c_str(), "wb");
+            if (!f) return false;
+            bool success = fwrite(clauses.data(), sizeof(int), clauses.size(), f) == clauses.size();
+            success &= fclose(f) == 0;
+            if (!success) {
+                remove(file.c_str());
+                return false;
+            }
+            // Only now that the clauses are safe, drop their copies in the filter
+            BufferReader reader = slot.cdb->getBufferReader(clauses.data(), clauses.size());
+            Mallob::Clause cls = reader.getNextIncomingClause();
+            while (cls.begin != nullptr) {
+                ProducedClauseCandidate pcc(cls.begin, cls.size, cls.lbd, 0, slot.epochBegin);
+                _filter->erase(pcc);
+                cls = reader.getNextIncomingClause();
+            }
+            slot.numSpilledLits = slot.cdb->getCurrentlyUsedLiterals();
+            slot.spillFile = file;
+            slot.cdb.reset();
+            LOG(V5_DEBG, "HCS spilled [%i,%i) : %i lits\n", slot.epochBegin, slot.epochEnd, slot.numSpilledLits);
+            return true;
+        }
+
+        // Reads the clauses of a spilled slot. If the file cannot be read,
+        // the slot is turned into an empty slot in memory.
+        std::vector<int> readSpillFile(Slot& slot) {
+            std::vector<int> clauses;
+            FILE* f = fopen(slot.spillFile.c_str(), "rb");
+            bool success = f != nullptr;
+            if (success) {
+                fseek(f, 0, SEEK_END);
+                clauses.resize(ftell(f) / sizeof(int));
+                fseek(f, 0, SEEK_SET);
+                success = fread(clauses.data(), sizeof(int), clauses.size(), f) == clauses.size();
+                fclose(f);
+            }
+            if (!success) {
+                LOG(V1_WARN, "[WARN] HCS cannot read %s - dropping [%i,%i)\n",
+                    slot.spillFile.c_str(), slot.epochBegin, slot.epochEnd);
+                FileUtils::rm(slot.spillFile);
+                slot.spillFile.clear();
+                slot.numSpilledLits = 0;
+                slot.cdb.reset(new AdaptiveClauseStore(_setup));
+                clauses.clear();
+            }
+            return clauses;
+        }
+
+        // Loads a spilled slot back into memory (no-op for a slot in memory).
+        void restore(Slot& slot) {
+            if (!slot.spilled()) return;
+            auto clauses = readSpillFile(slot);
+            if (!slot.spilled()) return; // could not be read
+            slot.cdb.reset(new AdaptiveClauseStore(_setup));
+            // Re-register the clauses in the filter; those which newer slots
+            // received in the meantime are dropped as duplicates
+            addClausesIntoDatabase(*slot.cdb, clauses, slot.epochBegin, ClauseAdditionMode::INSERT);
+            FileUtils::rm(slot.spillFile);
+            slot.spillFile.clear();
+            slot.numSpilledLits = 0;
+            LOG(V5_DEBG, "HCS restored [%i,%i)\n", slot.epochBegin, slot.epochEnd);
+        }
+
         std::string reportSlots() const {
 
             std::string out;
             std::string marker = "·";
             for (auto& slot : _storage_list) {
-                //LOG(V4_VVER, "SLOT [%i,%i) #lits=%i\n", slot.epochBegin, slot.epochEnd, slot.cdb.getCurrentlyUsedLiterals());
+                //LOG(V4_VVER, "SLOT [%i,%i) #lits=%i\n", slot.epochBegin, slot.epochEnd, slot.cdb->getCurrentlyUsedLiterals());
                 for (int i = 0; i < slot.epochEnd-slot.epochBegin; i++) {
-                    out += marker;
+                    out += slot.spilled() ? "~" : marker;
                 }
                 marker = marker == "-" ? "·" : "-";
             }
@@ -349,8 +476,10 @@ private:
     std::vector<std::pair<int, int>> _missing_epoch_intervals;
 
 public:
-    HistoricClauseStorage(const AdaptiveClauseStore::Setup& setup, BaseSatJob* job) : 
-        _job(job), _worker(setup)  {}
+    HistoricClauseStorage(const AdaptiveClauseStore::Setup& setup, int maxLitsInMemory, BaseSatJob* job) : 
+        _job(job), _worker(setup, maxLitsInMemory, TmpDir::get() + "/edu.kit.iti.mallob." + std::to_string(Proc::getPid())
+            + "." + std::to_string(MyMpi::rank(MPI_COMM_WORLD)) + ".#" + std::to_string(job->getId())
+            + "." + std::to_string(job->getContextId()) + ".history")  {}
 
     void importSharing(int epoch, std::vector<int>&& clauses) {
         
@@ -419,9 +548,9 @@ public:
                 LOG(V4_VVER, "HCS digest historic clauses, buflen=%i\n", task.clauses.size());
                 _job->digestHistoricClauses(task.epochBegin, task.epochEnd, task.clauses);
             }
-            LOG(V4_VVER, "HCS %i cls / %i lits, layout %s\n",
+            LOG(V4_VVER, "HCS %i cls / %i lits (%i spilled), layout %s\n",
                 task.storageDiagnostics.numClausesInStorage, task.storageDiagnostics.numLitsInStorage, 
-                task.storageDiagnostics.slotLayout.c_str());
+                task.storageDiagnostics.numLitsSpilled, task.storageDiagnostics.slotLayout.c_str());
         }
     }
 
@@ -13,18 +13,22 @@
 #include "app/sat/execution/clause_pipe_defs.hpp"
 #include "app/sat/execution/solving_state.hpp"
 #include "app/sat/job/inplace_sharing_aggregation.hpp"
+#include "app/sat/sharing/sat_counters.hpp"
 #include "sat_process_adapter.hpp"
 #include "../execution/engine.hpp"
 #include "util/sys/bidirectional_anytime_pipe.hpp"
+#include "util/sys/futex_event.hpp"
 #include "util/sys/shared_memory.hpp"
 #include "util/sys/proc.hpp"
 #include "util/sys/subprocess.hpp"
 #include "util/sys/process.hpp"
+#include "util/sys/timer.hpp"
 #include "util/logger.hpp"
 #include "util/sys/thread_pool.hpp"
 #include "app/sat/job/sat_shared_memory.hpp"
 #include "util/option.hpp"
 #include "util/sys/tmpdir.hpp"
+#include "util/tracer.hpp"
 
 #ifndef MALLOB_SUBPROC_DISPATCH_PATH
 #define MALLOB_SUBPROC_DISPATCH_PATH ""
@@ -66,8 +70,8 @@ void SatProcessAdapter::doWriteRevisions() {
             auto revStr = std::to_string(revData.revision);
             createSharedMemoryBlock("fsize."       + revStr, sizeof(size_t),              (void*)&revData.fSize);
             createSharedMemoryBlock("asize."       + revStr, sizeof(size_t),              (void*)&revData.aSize);
-            createSharedMemoryBlock("formulae."    + revStr, sizeof(int) * revData.fSize, (void*)revData.fLits);
-            createSharedMemoryBlock("assumptions." + revStr, sizeof(int) * revData.aSize, (void*)revData.aLits);
+            createSharedMemoryBlock("formulae."    + revStr, sizeof(int) * revData.fSize, (void*)revData.fLits, true);
+            createSharedMemoryBlock("assumptions." + revStr, sizeof(int) * revData.aSize, (void*)revData.aLits, true);
             createSharedMemoryBlock("checksum."    + revStr, sizeof(Checksum),            (void*)&(revData.checksum));
             _written_revision = revData.revision;
             LOG(V4_VVER, "DBG Done writing next revision %i\n", revData.revision);
@@ -89,6 +93,8 @@ void SatProcessAdapter::run() {
 
 void SatProcessAdapter::doInitialize() {
 
+    Tracer::Span span("sat", "init process", {"job", _config.jobid, "index", _config.apprank});
+
     // Initialize "management" shared memory
     //log(V4_VVER, "Setup base shmem: %s\n", _shmem_id.c_str());
     void* mainShmem = SharedMemory::create(_shmem_id, sizeof(SatSharedMemory));
@@ -101,8 +107,8 @@ void SatProcessAdapter::doInitialize() {
     _sum_of_revision_sizes += _f_size;
 
     // Allocate shared memory for formula, assumptions of initial revision
-    createSharedMemoryBlock("formulae.0", sizeof(int) * _f_size, (void*)_f_lits);
-    createSharedMemoryBlock("assumptions.0", sizeof(int) * _a_size, (void*)_a_lits);
+    createSharedMemoryBlock("formulae.0", sizeof(int) * _f_size, (void*)_f_lits, true);
+    createSharedMemoryBlock("assumptions.0", sizeof(int) * _a_size, (void*)_a_lits, true);
 
     // Set up bi-directional pipe to and from the subprocess
     _pipe.reset(new BiDirectionalAnytimePipe(BiDirectionalAnytimePipe::CREATE,
@@ -119,16 +125,29 @@ void SatProcessAdapter::doInitialize() {
     {
         auto lock = _state_mutex.getLock();
         _pipe->open();
+        if (!_pending_cls_snapshot.empty()) {
+            // First message in the pipe, imported by the child before it starts solving
+            _hsm->hasClauseSnapshot = true;
+            _pipe->writeData(_pending_cls_snapshot, {_clause_buffer_revision}, CLAUSE_PIPE_DIGEST_SNAPSHOT);
+            _pending_cls_snapshot = std::vector<int>();
+        }
         _initialized = true;
         _hsm->doBegin = true;
+        wakeUpChild();
         _child_pid = res;
         _state = SolvingStates::ACTIVE;
         applySolvingState();
     }
+    Tracer::beginAsync("sat", "init solvers", _config.jobid);
 }
 
 bool SatProcessAdapter::isFullyInitialized() {
-    return _initialized && _hsm->isInitialized;
+    bool initialized = _initialized && _hsm->isInitialized;
+    if (initialized && !_traced_full_initialization) {
+        _traced_full_initialization = true;
+        Tracer::endAsync("sat", "init solvers", _config.jobid);
+    }
+    return initialized;
 }
 
 void SatProcessAdapter::appendRevisions(const std::vector<RevisionData>& revisions, int desiredRevision) {
@@ -166,15 +185,22 @@ void SatProcessAdapter::doTerminateInitializedProcess() {
     //Fork::terminate(_child_pid); // Terminate child process by signal.
     _hsm->doTerminate = true; // Kindly ask child process to terminate.
     _hsm->doBegin = true; // Let child process know termination even if it waits for first revision
+    wakeUpChild();
     Process::resume(_child_pid); // Continue (resume) process.
 }
 
+void SatProcessAdapter::wakeUpChild() {
+    // Pipe messages wake up the child by themselves (see SatProcess::mainProgram);
+    // this is for signals via shared memory.
+    FutexEvent(&_hsm->wakeupEvents).signal();
+}
+
 void SatProcessAdapter::collectClauses(int maxSize) {
     if (!_initialized || _state != SolvingStates::ACTIVE || _clause_collecting_stage != NONE)
         return;
     _pipe->writeData({maxSize}, CLAUSE_PIPE_PREPARE_CLAUSES);
     _clause_collecting_stage = QUERIED;
-    if (_hsm->isInitialized) Process::wakeUp(_child_pid);
+    _sharing_latency.exportQueried = Timer::elapsedSeconds();
 }
 bool SatProcessAdapter::hasCollectedClauses() {
     return !_initialized || _state != SolvingStates::ACTIVE || _clause_collecting_stage == RETURNED;
@@ -190,12 +216,16 @@ int SatProcessAdapter::getLastAdmittedNumLits() {
     return _last_admitted_nb_lits;
 }
 
+float SatProcessAdapter::getLastUsefulnessVolumeFactor() {
+    return _last_usefulness_volume_factor;
+}
+
 void SatProcessAdapter::filterClauses(int epoch, const std::vector<int>& clauses) {
     if (!_initialized || _state != SolvingStates::ACTIVE) return;
     _pipe->writeData(clauses, {epoch},
         CLAUSE_PIPE_FILTER_IMPORT);
     _epoch_of_export_buffer = epoch;
-    if (_hsm->isInitialized) Process::wakeUp(_child_pid);
+    _sharing_latency.filterSent = Timer::elapsedSeconds();
 }
 
 bool SatProcessAdapter::hasFilteredClauses(int epoch) {
@@ -223,13 +253,12 @@ void SatProcessAdapter::applyFilter(int epoch, const std::vector<int>& filter) {
     if (!_initialized || _state != SolvingStates::ACTIVE) return;
     if (epoch != _epoch_of_export_buffer) return; // ignore filter if the corresponding clauses are not present
     _pipe->writeData(filter, {epoch}, CLAUSE_PIPE_DIGEST_IMPORT);
-    if (_hsm->isInitialized) Process::wakeUp(_child_pid);
+    _sharing_latency.digestSent = Timer::elapsedSeconds();
 }
 
 void SatProcessAdapter::digestClausesWithoutFilter(int epoch, const std::vector<int>& clauses) {
     if (!_initialized || _state != SolvingStates::ACTIVE) return;
     _pipe->writeData(clauses, {epoch}, CLAUSE_PIPE_DIGEST_IMPORT_WITHOUT_FILTER);
-    if (_hsm->isInitialized) Process::wakeUp(_child_pid);
 }
 
 void SatProcessAdapter::returnClauses(const std::vector<int>& clauses) {
@@ -242,6 +271,16 @@ void SatProcessAdapter::digestHistoricClauses(int epochBegin, int epochEnd, cons
     _pipe->writeData(clauses, {epochBegin, epochEnd, _clause_buffer_revision}, CLAUSE_PIPE_DIGEST_HISTORIC);
 }
 
+void SatProcessAdapter::digestClauseSnapshot(const std::vector<int>& clauses) {
+    auto lock = _state_mutex.getLock();
+    if (!_initialized) {
+        _pending_cls_snapshot = clauses;
+        return;
+    }
+    if (_state != SolvingStates::ACTIVE) return;
+    _pipe->writeData(clauses, {_clause_buffer_revision}, CLAUSE_PIPE_DIGEST_SNAPSHOT);
+}
+
 
 void SatProcessAdapter::dumpStats() {
     if (!_initialized || _state != SolvingStates::ACTIVE) return;
@@ -278,20 +317,9 @@ SatProcessAdapter::SubprocessStatus SatProcessAdapter::check() {
 
     if (_state != SolvingStates::ACTIVE) return NORMAL;
 
-    char c = _pipe->pollForData();
-    if (c == CLAUSE_PIPE_PREPARE_CLAUSES) {
-        _collected_clauses = _pipe->readData(c);
-        _successful_solver_id = _collected_clauses.back(); _collected_clauses.pop_back();
-        _nb_incoming_lits = _collected_clauses.back(); _collected_clauses.pop_back();
-        _clause_collecting_stage = RETURNED;
-        LOG(V4_VVER, "collected clauses from subprocess\n");
-    } else if (c == CLAUSE_PIPE_FILTER_IMPORT) {
-        std::vector<int> filter = _pipe->readData(c);
-        int epoch = filter.back(); filter.pop_back();
-        _filters_by_epoch[epoch] = std::move(filter);
-    } else if (c == CLAUSE_PIPE_DIGEST_IMPORT) {
-        _last_admitted_nb_lits = _pipe->readData(c).front();
-    }
+    // Digest all messages which arrived since the last check
+    char c;
+    while ((c = _pipe->pollForData()) != 0) handleChildMessage(c);
 
     if (_published_revision < _written_revision) {
         _published_revision = _written_revision;
@@ -370,9 +398,10 @@ void SatProcessAdapter::waitUntilChildExited() {
     }
 }
 
-void* SatProcessAdapter::createSharedMemoryBlock(std::string shmemSubId, size_t size, void* data) {
+void* SatProcessAdapter::createSharedMemoryBlock(std::string shmemSubId, size_t size, void* data, bool hugePages) {
     std::string id = _shmem_id + "." + shmemSubId;
-    void* shmem = SharedMemory::create(id, size);
+    void* shmem = SharedMemory::create(id, size, hugePages ?
+        (SharedMemory::HugePageMode) _params.sharedMemHugePages() : SharedMemory::NO_HUGE_PAGES);
     if (data == nullptr) {
         memset(shmem, 0, size);
     } else {
@@ -383,8 +412,49 @@ void* SatProcessAdapter::createSharedMemoryBlock(std::string shmemSubId, size_t
     return shmem;
 }
 
+void SatProcessAdapter::handleChildMessage(char c) {
+    // Each reply carries the microseconds the child spent on the request
+    if (c == CLAUSE_PIPE_PREPARE_CLAUSES) {
+        _collected_clauses = _pipe->readData(c);
+        _successful_solver_id = _collected_clauses.back(); _collected_clauses.pop_back();
+        _nb_incoming_lits = _collected_clauses.back(); _collected_clauses.pop_back();
+        _sharing_latency.exportChild = 0.000001f * _collected_clauses.back(); _collected_clauses.pop_back();
+        _sharing_latency.exportTotal = Timer::elapsedSeconds() - _sharing_latency.exportQueried;
+        _clause_collecting_stage = RETURNED;
+        LOG(V4_VVER, "collected clauses from subprocess\n");
+    } else if (c == CLAUSE_PIPE_FILTER_IMPORT) {
+        std::vector<int> filter = _pipe->readData(c);
+        int epoch = filter.back(); filter.pop_back();
+        _sharing_latency.filterChild = 0.000001f * filter.back(); filter.pop_back();
+        _sharing_latency.filterTotal = Timer::elapsedSeconds() - _sharing_latency.filterSent;
+        _filters_by_epoch[epoch] = std::move(filter);
+        // Filters of past epochs may have been skipped (anytime sharing)
+        for (auto it = _filters_by_epoch.begin(); it != _filters_by_epoch.end();) {
+            if (it->first < epoch) it = _filters_by_epoch.erase(it);
+            else ++it;
+        }
+    } else if (c == CLAUSE_PIPE_DIGEST_IMPORT) {
+        auto data = _pipe->readData(c);
+        _last_admitted_nb_lits = data[0];
+        _last_usefulness_volume_factor = 0.001f * data[1];
+        const float digestChild = 0.000001f * data[2];
+        const float digestTotal = Timer::elapsedSeconds() - _sharing_latency.digestSent;
+        const auto& lat = _sharing_latency;
+        LOG(V4_VVER, "sharing latency e=%i export=%.3fms(child %.3fms) filter=%.3fms(child %.3fms) digest=%.3fms(child %.3fms)\n",
+            _epoch_of_export_buffer, 1000*lat.exportTotal, 1000*lat.exportChild,
+            1000*lat.filterTotal, 1000*lat.filterChild, 1000*digestTotal, 1000*digestChild);
+    } else if (c == CLAUSE_PIPE_COUNTERS) {
+        CounterRegistry::addSerializedIncrements(_pipe->readData(c));
+    } else {
+        // Each message is length-prefixed, so it can be skipped safely
+        LOG(V1_WARN, "[WARN] Unknown pipe directive \"%c\" from child - discarding\n", c);
+        (void) _pipe->readData(c);
+    }
+}
+
 void SatProcessAdapter::crash() {
     _hsm->doCrash = true;
+    wakeUpChild();
 }
 
 void SatProcessAdapter::reduceThreadCount() {
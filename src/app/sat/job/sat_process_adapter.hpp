@@ -79,6 +79,7 @@ private:
 
     volatile bool _running = false;
     volatile bool _initialized = false;
+    bool _traced_full_initialization = false;
     volatile bool _terminate = false;
     volatile bool _bg_writer_running = false;
 
@@ -86,13 +87,23 @@ private:
     std::future<void> _bg_writer;
 
     int _last_admitted_nb_lits {0};
+    float _last_usefulness_volume_factor {1};
     int _successful_solver_id {-1};
     int _nb_incoming_lits {0};
     enum ClauseCollectingStage {NONE, QUERIED, RETURNED} _clause_collecting_stage {NONE};
     std::vector<int> _collected_clauses;
+    std::vector<int> _pending_cls_snapshot;
     tsl::robin_map<int, std::vector<int>> _filters_by_epoch;
     int _epoch_of_export_buffer {-1};
 
+    // End-to-end latencies (in seconds) of the stages of a sharing epoch across
+    // the process boundary, each with the share spent inside the child process
+    struct SharingLatency {
+        float exportQueried {0}, exportTotal {0}, exportChild {0};
+        float filterSent {0}, filterTotal {0}, filterChild {0};
+        float digestSent {0};
+    } _sharing_latency;
+
     pid_t _child_pid = -1;
     SolvingStates::SolvingState _state = SolvingStates::INITIALIZING;
 
@@ -133,6 +144,7 @@ public:
     bool hasCollectedClauses();
     std::vector<int> getCollectedClauses(int& successfulSolverId, int& numLits);
     int getLastAdmittedNumLits();
+    float getLastUsefulnessVolumeFactor();
 
     void filterClauses(int epoch, const std::vector<int>& clauses);
     bool hasFilteredClauses(int epoch);
@@ -142,6 +154,8 @@ public:
 
     void returnClauses(const std::vector<int>& clauses);
     void digestHistoricClauses(int epochBegin, int epochEnd, const std::vector<int>& clauses);
+    // Before the subprocess was started, the snapshot is kept and imported before solving begins.
+    void digestClauseSnapshot(const std::vector<int>& clauses);
 
     void dumpStats();
     
@@ -157,9 +171,11 @@ private:
     void doWriteRevisions();
     void doPrepareSolution();
     void doTerminateInitializedProcess();
+    void wakeUpChild();
+    void handleChildMessage(char c);
     
     void applySolvingState();
     void initSharedMemory(SatProcessConfig&& config);
-    void* createSharedMemoryBlock(std::string shmemSubId, size_t size, void* data);
+    void* createSharedMemoryBlock(std::string shmemSubId, size_t size, void* data, bool hugePages = false);
 
 };
@@ -2,6 +2,7 @@
 #pragma once
 
 #include <sys/types.h>
+#include <cstdint>
 
 #include "../solvers/portfolio_solver_interface.hpp"
 #include "app/sat/execution/engine.hpp"
@@ -21,6 +22,10 @@ struct SatSharedMemory {
     bool doTerminate {false};
     bool doCrash {false};
     bool childReadyToWrite {false};
+    // A clause snapshot is the first message in the pipe, to be imported before solving
+    bool hasClauseSnapshot {false};
+    // Event counter for waking up the child (see FutexEvent)
+    uint32_t wakeupEvents {0};
 
     // Signals child->parent
     bool didTerminate {false};
@@ -17,8 +17,12 @@ OPTION_GROUP(grpAppSat, "app/sat", "SAT solving options")
     "Supply config for SAT engine subprocess [internal option, do not use]")
  OPT_BOOL(copyFormulaeFromSharedMem,        "cpshm", "",                                           false,
     "Copy each formula + assumptions from shared memory to local memory before launching solvers")
+ OPT_INT(sharedMemHugePages,                "shmhp", "shared-mem-huge-pages",            0,        0,   2,
+    "Back large shared memory segments (formulae, solutions) with huge pages: 0=never, 1=transparent huge pages, 2=explicit huge pages from hugetlbfs (fallback: 1)")
  OPT_STRING(clauseLog,                      "clause-log", "",                            "",
     "Log successfully shared clauses to the provided path")
+ OPT_BOOL(clauseLogBinary,                  "clause-log-binary", "",                     false,
+    "Write the clause log in a compact binary format with per-epoch framing (see scripts/eval/read_clause_log.py)")
  OPT_STRING(cadicalProfilingDir,            "cpd", "cadical-profiling-dir", "", "Directory to write CaDiCaL profiling reports to")
  OPT_INT(cadicalProfilingLevel,             "cpl", "cadical-profiling-level", -1, -1, 4, "Profiling level for CaDiCaL (-1=none ... 4=all)")
 
@@ -33,8 +37,18 @@ OPTION_GROUP(grpAppSatSharing, "app/sat/sharing", "Clause sharing configuration"
     "Clause buffer discount factor: reduce buffer size per PE by <factor> each depth")
  OPT_FLOAT(clauseFilterClearInterval,       "cfci", "clause-filter-clear-interval",      15,       -1,  LARGE_INT,
     "Set clear interval of clauses in solver filters (-1: never clear, 0: always clear")
+ OPT_FLOAT(clauseSharingChildDeadline,      "cscd", "clause-sharing-child-deadline",     0,        0,   LARGE_INT,
+    "Anytime clause sharing: after its own contribution is ready, a node waits at most this many seconds for its children's contributions and then forwards what it has; late clauses are re-exported in the next epoch (0: always wait for all children)")
+ OPT_INT(clauseSnapshotLiterals,           "csl", "clause-snapshot-literals",           0,        0,   MAX_INT,
+    "Keep a snapshot of the best shared clauses (deduplicated, at most this many literals) and send it to newly joining job tree nodes (0: disabled)")
+ OPT_BOOL(clauseUsefulnessFeedback,       "cuf", "clause-usefulness-feedback",         false,
+    "Estimate per clause length how many imported clauses the local solvers actually use; shift the export budget towards useful clause lengths and reduce the sharing volume if few clauses are useful")
+ OPT_FLOAT(clauseUsefulnessMinShare,       "cums", "clause-usefulness-min-share",       0.1,      0.01, 1,
+    "With -cuf: min. share of the export budget granted to any clause length and min. factor for the sharing volume")
  OPT_BOOL(collectClauseHistory,           "ch", "collect-clause-history",                false,
     "Employ clause history collection mechanism")
+ OPT_INT(clauseHistoryMemoryLiterals,      "chml", "clause-history-memory-lits",        0,        0,   MAX_INT,
+    "Max. number of literals the clause history keeps in memory, counting stored clauses and their copies in the history's duplicate filter; older history slots are spilled to files in $MALLOB_TMP_DIR, and new history clauses are not deduplicated against spilled slots until these are restored (0: no limit)")
  OPT_BOOL(compensateUnusedSharingVolume,    "cusv", "compensate-unused-sharing-volume",  true,
     "Compensate for unused or filtered parts of clause buffer in the next sharings")
  OPT_INT(freeClauseLengthLimit, "fcll", "free-clause-length-limit", 1, 0, LARGE_INT, "Max. length of clauses which are considered \"free\" for sharing")
@@ -67,6 +81,7 @@ OPTION_GROUP(grpAppSatSharing, "app/sat/sharing", "Clause sharing configuration"
     "Max. relative increase in size of clause sharing buffers in case of many clauses being filtered")
  OPT_BOOL(backlogExportManager,             "bem", "backlog-export-manager",             true, "Use sequentialized export manager with backlogs instead of simple HordeSat-style export")
  OPT_BOOL(adaptiveImportManager,            "aim", "adaptive-import-manager",            true, "Use adaptive clause store for each solver's import buffer instead of lock-free ring buffers")
+ OPT_BOOL(eliminationAwareImport,           "eai", "elimination-aware-import",           true, "Drop shared clauses satisfied by a solver's root-level units before buffering them for that solver")
  OPT_BOOL(incrementLbd,                     "ilbd", "increment-lbd-at-import",           true, "Increment LBD value of each clause before import")
  OPT_BOOL(randomizeLbd,                     "randlbd", "reset-lbd-at-import",            false, "Randomize (uniformly) LBD value of each clause before import - can be combined with -ilbd afterwards")
  OPT_BOOL(noImport,                         "no-import", "",                             false, "Turn off solvers importing clauses (for comparison purposes)")
@@ -91,6 +106,12 @@ OPTION_GROUP(grpAppSatDiversification, "app/sat/diversification", "Diversificati
     "Diversify solvers with different random seeds")
  OPT_STRING(satSolverSequence,              "satsolver",  "",                            "C",
     "Sequence of SAT solvers to cycle through (capital letter for true incremental solver, lowercase for pseudo-incremental solving): L|l:Lingeling C|c:CaDiCaL G|g:Glucose k:Kissat m:MergeSAT")
+ OPT_STRING(portfolioTuningStore,           "pts", "portfolio-tuning-store",             "",
+    "File recording which solver configuration won which job; each new non-incremental job additionally runs the configuration which won most often on similar past jobs (empty: no tuning)") //[[AUTOCOMPLETE_FILE]]
+ OPT_FLOAT(portfolioTuningExploration,      "ptx", "portfolio-tuning-exploration",       0.1,      0,   1,
+    "Probability to run a job with the untuned portfolio in order to keep collecting unbiased outcomes")
+ OPT_INT(portfolioTuningNeighbors,          "ptn", "portfolio-tuning-neighbors",         16,       1,   LARGE_INT,
+    "Number of most similar recorded jobs to base the tuning of a new job on")
 
 OPTION_GROUP(grpAppSatProof, "app/sat/proof", "Production of UNSAT proofs")
  OPT_STRING(proofDirectory,               "proof-dir", "",                             "",                      "Directory to write partial proofs into (default: -log option")
@@ -98,6 +119,7 @@ OPTION_GROUP(grpAppSatProof, "app/sat/proof", "Production of UNSAT proofs")
  OPT_BOOL(onTheFlyChecking,               "otfc", "on-the-fly-checking",               false,                   "Enable on-the-fly checking of local derivations; generate and validate signatures for shared clauses")
  OPT_BOOL(plratProofOutput,                 "extid", "on-the-fly-checking-id",           false,                   "Enable for PLRAT on-the-fly checking; PLRAT on-the-fly checker modifies clause IDs for clause sharing")
  OPT_BOOL(onTheFlyCheckModel,             "otfcm", "on-the-fly-check-model",           true,                    "Also check satisfiable assignment in on-the-fly checking (prevents deletion of orig. clauses in one checker per process)")
+ OPT_BOOL(onTheFlyBatchImports,           "otfcbi", "on-the-fly-batch-imports",        false,                   "Submit imported clauses to the on-the-fly checker in batches with signatures verified by a multi-lane SipHash (requires checker support)")
  OPT_BOOL(distributedProofAssembly,       "dpa", "distributed-proof-assembly",         true,                    "Distributed UNSAT proof assembly into a single file")
  OPT_BOOL(interleaveProofMerging,         "ipm", "interleave-proof-merging",           true,                    "Interleave filtering and merging of proof lines")
  OPT_BOOL(proofDebugging,                 "proof-debugging", "",                       false,                   "Output debugging information into separate files - expensive and large!")
@@ -106,6 +128,10 @@ OPTION_GROUP(grpAppSatProof, "app/sat/proof", "Production of UNSAT proofs")
  OPT_INT(addClauseDeletionStatements,     "cdel", "add-clause-deletions", 2, 0, 2, "0: don't add deletion statements to final proof, 1: add approximately via Bloom filter, 2: add exactly")
  OPT_STRING(extMemDiskDirectory,          "extmem-disk-dir", "",                       ".disk",                 "Directory where to create external memory files") //[[AUTOCOMPLETE_DIRECTORY]]
  OPT_STRING(satPreprocessor,              "sat-preprocessor", "",                      "",                      "Executable which preprocesses CNF file") //[[AUTOCOMPLETE_EXECUTABLE]]
+ OPT_BOOL(clientPreprocessing,            "cpp", "client-preprocessing",               false,                   "Preprocess each non-incremental formula at the client before distributing it (units, duplicate/subsumed clauses, pure literals, variable compaction)")
+ OPT_INT(clientPreprocessingThreads,      "cppt", "client-preprocessing-threads",      4,    1, LARGE_INT,      "Number of threads for client-side preprocessing of each formula")
+ OPT_STRING(formulaCacheDirectory,        "fcd", "formula-cache-dir",                  "",                      "Directory for a persistent cache of parsed formulae, keyed by input path, size and modification time (empty: no cache)") //[[AUTOCOMPLETE_DIRECTORY]]
+ OPT_INT(formulaCacheMaxSize,             "fcms", "formula-cache-max-size",            4096, 1, MAX_INT,        "Max. total size of the formula cache in MiB; least recently used entries are evicted")
  OPT_FLOAT(satSolvingWallclockLimit,      "sswl", "sat-solving-wallclock-limit",       0,    0, LARGE_INT,      "Cancel job if not done solving after this many seconds (0: no limit)")
  OPT_FLOAT(clauseErrorChancePerMille,     "cecpm", "clause-error-chance-per-mille",    0,    0, 1000,  "Chance per mille for tampering with some literal in a shared clause")
  OPT_FLOAT(derivationErrorChancePerMille, "decpm", "deriv-error-chance-per-mille",     0,    0, 1000,  "Chance per mille for tampering with some on-the-fly checking clause derivation")
@@ -0,0 +1,394 @@
+
+#include "cnf_preprocessor.hpp"
+
+#include <stdlib.h>
+#include <thread>
+
+#include "data/checksum.hpp"
+#include "data/job_description.hpp"
+#include "sat_reader.hpp"
+#include "util/logger.hpp"
+#include "util/params.hpp"
+#include "util/sys/timer.hpp"
+
+namespace {
+    // Order of literals within a clause: by variable, negative before positive.
+    // Places duplicate and complementary literals next to each other.
+    bool litOrder(int a, int b) {
+        const int absA = std::abs(a), absB = std::abs(b);
+        return absA < absB || (absA == absB && a < b);
+    }
+    // Whether sorted clause c is a subset of sorted clause d
+    bool isSubset(const int* c, size_t sizeC, const int* d, size_t sizeD) {
+        size_t i = 0, j = 0;
+        while (i < sizeC && j < sizeD) {
+            if (c[i] == d[j]) {i++; j++;}
+            else if (litOrder(d[j], c[i])) j++;
+            else return false;
+        }
+        return i == sizeC;
+    }
+    // Clauses whose rarest literal occurs more often than this are not checked
+    // for subsuming other clauses, which bounds the effort per clause.
+    constexpr size_t MAX_SUBSUMPTION_CANDIDATES = 256;
+    // Minimum number of clauses per chunk to make a thread worthwhile
+    constexpr size_t MIN_CLAUSES_PER_CHUNK = 4096;
+}
+
+std::vector<int> CnfPreprocessor::Reconstruction::reconstructModel(const std::vector<int>& reducedModel) const {
+    std::vector<int> model(mapping.size(), 0);
+    for (size_t v = 1; v < mapping.size(); v++) {
+        bool negative;
+        if (mapping[v] > 0) negative = (size_t) mapping[v] < reducedModel.size() && reducedModel[mapping[v]] < 0;
+        else negative = fixed[v] < 0; // free variables are set to true
+        model[v] = negative ? -(int)v : (int)v;
+    }
+    return model;
+}
+
+void CnfPreprocessor::process(const int* lits, size_t size, int nbVars) {
+
+    _nb_vars = nbVars;
+    _lits.reserve(size);
+    _offsets.push_back(0);
+    for (size_t i = 0; i < size; i++) {
+        if (lits[i] == 0) {
+            _offsets.push_back(_lits.size());
+        } else {
+            _lits.push_back(lits[i]);
+            _nb_vars = std::max(_nb_vars, std::abs(lits[i]));
+        }
+    }
+    if (_offsets.back() != _lits.size()) _offsets.push_back(_lits.size()); // unterminated clause
+
+    const size_t numClauses = _offsets.size()-1;
+    _sizes.resize(numClauses);
+    for (size_t c = 0; c < numClauses; c++) {
+        _sizes[c] = _offsets[c+1] - _offsets[c];
+        if (_sizes[c] == 0) _unsat = true;
+    }
+    _deleted.assign(numClauses, 0);
+    _values.assign(_nb_vars+1, 0);
+
+    if (!_unsat) normalizeClauses();
+    if (!_unsat) propagateUnits();
+    if (!_unsat) {
+        removeDuplicates();
+        removeSubsumed();
+        eliminatePureLiterals();
+    }
+    compact();
+}
+
+std::shared_ptr<CnfPreprocessor::Reconstruction> CnfPreprocessor::preprocess(const Parameters& params, JobDescription& desc) {
+
+    const int revision = desc.getRevision();
+    const auto& config = desc.getAppConfiguration().map;
+    const int nbVars = config.count("__NV") ? atoi(config.at("__NV").c_str()) : 0;
+    const int nbClauses = config.count("__NC") ? atoi(config.at("__NC").c_str()) : 0;
+
+    float time = Timer::elapsedSeconds();
+    CnfPreprocessor preprocessor(params.clientPreprocessingThreads());
+    preprocessor.process(desc.getFormulaPayload(revision), desc.getFormulaPayloadSize(revision), nbVars);
+    time = Timer::elapsedSeconds() - time;
+
+    const auto& stats = preprocessor.getStatistics();
+    LOG(V3_VERB, "Preprocessed #%i in %.3fs: %i->%i vars, %i->%i cls (%lu taut., %lu units, %lu dupl., %lu subs., %lu pure)%s\n",
+        desc.getId(), time, nbVars, preprocessor.getNbVars(), nbClauses, preprocessor.getNbClauses(),
+        stats.numTautologies, stats.numUnits, stats.numDuplicates, stats.numSubsumed, stats.numPureLiterals,
+        preprocessor.isUnsat() ? " - UNSAT" : "");
+
+    // Replace the job's formula
+    const auto& formula = preprocessor.getFormula();
+    SatReader::storeFormulaSize(desc, preprocessor.getNbVars(), preprocessor.getNbClauses());
+    desc.setChecksum(Checksum());
+    desc.beginInitialization(revision);
+    desc.addPermanentData(formula.data(), formula.size());
+    desc.endInitialization();
+
+    return preprocessor.getReconstruction();
+}
+
+void CnfPreprocessor::normalizeClauses() {
+    std::vector<size_t> numTautologies(getNumChunks(), 0);
+    forEachChunk([&](size_t chunk, size_t begin, size_t end) {
+        for (size_t c = begin; c < end; c++) {
+            int* cls = _lits.data() + _offsets[c];
+            std::sort(cls, cls + _sizes[c], litOrder);
+            uint32_t newSize = 0;
+            for (uint32_t i = 0; i < _sizes[c]; i++) {
+                if (newSize > 0 && cls[newSize-1] == cls[i]) continue; // duplicate literal
+                if (newSize > 0 && cls[newSize-1] == -cls[i]) {
+                    _deleted[c] = 1;
+                    numTautologies[chunk]++;
+                    break;
+                }
+                cls[newSize++] = cls[i];
+            }
+            if (!_deleted[c]) _sizes[c] = newSize;
+        }
+    });
+    for (size_t n : numTautologies) _stats.numTautologies += n;
+}
+
+void CnfPreprocessor::propagateUnits() {
+
+    buildOccurrences();
+    std::vector<uint32_t> numUnassigned(_sizes.begin(), _sizes.end());
+    std::vector<int> trail;
+    auto enqueue = [&](int lit) {
+        if (value(lit) > 0) return;
+        if (value(lit) < 0) {
+            _unsat = true;
+            return;
+        }
+        _values[std::abs(lit)] = lit > 0 ? 1 : -1;
+        trail.push_back(lit);
+    };
+    for (size_t c = 0; c < _sizes.size(); c++) {
+        if (!_deleted[c] && _sizes[c] == 1) enqueue(_lits[_offsets[c]]);
+    }
+
+    for (size_t head = 0; head < trail.size() && !_unsat; head++) {
+        const int lit = trail[head];
+        // Clauses containing the literal are satisfied
+        for (size_t i = _occ_offsets[litIndex(lit)]; i < _occ_offsets[litIndex(lit)+1]; i++) {
+            _deleted[_occ[i]] = 1;
+        }
+        // Clauses containing its negation lose a literal
+        for (size_t i = _occ_offsets[litIndex(-lit)]; i < _occ_offsets[litIndex(-lit)+1] && !_unsat; i++) {
+            const size_t c = _occ[i];
+            if (_deleted[c] || --numUnassigned[c] > 1) continue;
+            int unassigned = 0;
+            bool satisfied = false;
+            for (size_t j = _offsets[c]; j < _offsets[c] + _sizes[c]; j++) {
+                const int v = value(_lits[j]);
+                if (v > 0) {satisfied = true; break;}
+                if (v == 0) unassigned = _lits[j];
+            }
+            // satisfied clauses are deleted when their true literal is processed
+            if (satisfied) continue;
+            if (unassigned == 0) _unsat = true;
+            else enqueue(unassigned);
+        }
+    }
+    _stats.numUnits = trail.size();
+    if (_unsat) return;
+
+    // Remove false literals from the remaining clauses
+    forEachChunk([&](size_t, size_t begin, size_t end) {
+        for (size_t c = begin; c < end; c++) {
+            if (_deleted[c]) continue;
+            int* cls = _lits.data() + _offsets[c];
+            uint32_t newSize = 0;
+            for (uint32_t i = 0; i < _sizes[c]; i++) {
+                if (value(cls[i]) < 0) continue;
+                cls[newSize++] = cls[i];
+            }
+            _sizes[c] = newSize;
+        }
+    });
+}
+
+void CnfPreprocessor::removeDuplicates() {
+
+    std::vector<uint64_t> hashes(_sizes.size());
+    forEachChunk([&](size_t, size_t begin, size_t end) {
+        for (size_t c = begin; c < end; c++) {
+            if (_deleted[c]) continue;
+            uint64_t hash = 14695981039346656037UL;
+            for (size_t i = _offsets[c]; i < _offsets[c] + _sizes[c]; i++) {
+                hash ^= (uint32_t) _lits[i];
+                hash *= 1099511628211UL;
+            }
+            hashes[c] = hash;
+        }
+    });
+
+    std::vector<size_t> order;
+    for (size_t c = 0; c < _sizes.size(); c++) if (!_deleted[c]) order.push_back(c);
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        if (_sizes[a] != _sizes[b]) return _sizes[a] < _sizes[b];
+        if (hashes[a] != hashes[b]) return hashes[a] < hashes[b];
+        return a < b;
+    });
+    // Within each group of equal size and hash, keep the first of equal clauses
+    for (size_t i = 0; i < order.size(); ) {
+        size_t groupEnd = i+1;
+        while (groupEnd < order.size() && _sizes[order[groupEnd]] == _sizes[order[i]]
+            && hashes[order[groupEnd]] == hashes[order[i]]) groupEnd++;
+        for (size_t a = i+1; a < groupEnd; a++) {
+            const int* clsA = _lits.data() + _offsets[order[a]];
+            for (size_t b = i; b < a; b++) {
+                if (_deleted[order[b]]) continue;
+                const int* clsB = _lits.data() + _offsets[order[b]];
+                if (std::equal(clsA, clsA + _sizes[order[a]], clsB)) {
+                    _deleted[order[a]] = 1;
+                    _stats.numDuplicates++;
+                    break;
+                }
+            }
+        }
+        i = groupEnd;
+    }
+}
+
+void CnfPreprocessor::removeSubsumed() {
+
+    buildOccurrences();
+    // Each clause is checked as a subsumer against the occurrences of its rarest
+    // literal. Deletions are only collected during the parallel phase. Since
+    // there are no duplicates, subsumption is strict and hence acyclic: deleting
+    // all subsumed clauses at once keeps a subsuming clause for each of them.
+    std::vector<std::vector<size_t>> subsumed(getNumChunks());
+    forEachChunk([&](size_t chunk, size_t begin, size_t end) {
+        for (size_t c = begin; c < end; c++) {
+            if (_deleted[c]) continue;
+            const int* cls = _lits.data() + _offsets[c];
+            size_t rarest = litIndex(cls[0]);
+            for (uint32_t i = 1; i < _sizes[c]; i++) {
+                const size_t idx = litIndex(cls[i]);
+                if (_occ_offsets[idx+1]-_occ_offsets[idx] < _occ_offsets[rarest+1]-_occ_offsets[rarest])
+                    rarest = idx;
+            }
+            if (_occ_offsets[rarest+1]-_occ_offsets[rarest] > MAX_SUBSUMPTION_CANDIDATES) continue;
+            for (size_t i = _occ_offsets[rarest]; i < _occ_offsets[rarest+1]; i++) {
+                const size_t d = _occ[i];
+                if (_sizes[d] <= _sizes[c]) continue;
+                if (isSubset(cls, _sizes[c], _lits.data() + _offsets[d], _sizes[d]))
+                    subsumed[chunk].push_back(d);
+            }
+        }
+    });
+    for (const auto& clauses : subsumed) for (size_t d : clauses) {
+        if (_deleted[d]) continue;
+        _deleted[d] = 1;
+        _stats.numSubsumed++;
+    }
+}
+
+void CnfPreprocessor::eliminatePureLiterals() {
+
+    buildOccurrences();
+    std::vector<size_t> count(_occ_offsets.size()-1);
+    for (size_t idx = 0; idx < count.size(); idx++) count[idx] = _occ_offsets[idx+1] - _occ_offsets[idx];
+
+    std::vector<int> pure;
+    for (int v = 1; v <= _nb_vars; v++) {
+        if (_values[v] != 0) continue;
+        const size_t numPos = count[litIndex(v)], numNeg = count[litIndex(-v)];
+        if (numPos > 0 && numNeg == 0) pure.push_back(v);
+        if (numNeg > 0 && numPos == 0) pure.push_back(-v);
+    }
+    while (!pure.empty()) {
+        const int lit = pure.back();
+        pure.pop_back();
+        if (_values[std::abs(lit)] != 0) continue;
+        _values[std::abs(lit)] = lit > 0 ? 1 : -1;
+        _stats.numPureLiterals++;
+        // Satisfied clauses disappear, which may render further literals pure
+        for (size_t i = _occ_offsets[litIndex(lit)]; i < _occ_offsets[litIndex(lit)+1]; i++) {
+            const size_t c = _occ[i];
+            if (_deleted[c]) continue;
+            _deleted[c] = 1;
+            for (size_t j = _offsets[c]; j < _offsets[c] + _sizes[c]; j++) {
+                const int other = _lits[j];
+                if (other == lit) continue;
+                if (--count[litIndex(other)] == 0 && count[litIndex(-other)] > 0
+                    && _values[std::abs(other)] == 0) pure.push_back(-other);
+            }
+        }
+    }
+}
+
+void CnfPreprocessor::compact() {
+
+    _reconstruction.reset(new Reconstruction());
+    auto& mapping = _reconstruction->mapping;
+    mapping.assign(_nb_vars+1, 0);
+    _reconstruction->fixed.assign(_values.begin(), _values.end());
+
+    if (_unsat) {
+        // Trivially unsatisfiable replacement
+        _result = {1, 0, -1, 0};
+        _result_nb_vars = 1;
+        _result_nb_clauses = 2;
+        return;
+    }
+
+    std::vector<uint8_t> occurs(_nb_vars+1, 0);
+    for (size_t c = 0; c < _sizes.size(); c++) {
+        if (_deleted[c]) continue;
+        for (size_t i = _offsets[c]; i < _offsets[c] + _sizes[c]; i++) occurs[std::abs(_lits[i])] = 1;
+    }
+    int nbVars = 0;
+    for (int v = 1; v <= _nb_vars; v++) if (occurs[v]) mapping[v] = ++nbVars;
+
+    // Compute each chunk's output position, then write the chunks in parallel
+    const size_t numChunks = getNumChunks();
+    std::vector<size_t> chunkSizes(numChunks+1, 0), chunkClauses(numChunks, 0);
+    forEachChunk([&](size_t chunk, size_t begin, size_t end) {
+        for (size_t c = begin; c < end; c++) {
+            if (_deleted[c]) continue;
+            chunkSizes[chunk+1] += _sizes[c] + 1;
+            chunkClauses[chunk]++;
+        }
+    });
+    for (size_t chunk = 0; chunk < numChunks; chunk++) {
+        chunkSizes[chunk+1] += chunkSizes[chunk];
+        _result_nb_clauses += chunkClauses[chunk];
+    }
+    _result.resize(chunkSizes[numChunks]);
+    forEachChunk([&](size_t chunk, size_t begin, size_t end) {
+        size_t pos = chunkSizes[chunk];
+        for (size_t c = begin; c < end; c++) {
+            if (_deleted[c]) continue;
+            for (size_t i = _offsets[c]; i < _offsets[c] + _sizes[c]; i++) {
+                const int lit = _lits[i];
+                _result[pos++] = lit > 0 ? mapping[lit] : -mapping[-lit];
+            }
+            _result[pos++] = 0;
+        }
+    });
+    _result_nb_vars = nbVars;
+
+    if (_result_nb_clauses == 0) {
+        // Every clause is satisfied: hand over a trivially satisfiable formula
+        // over an auxiliary variable which does not map back to the original.
+        _result = {1, 0};
+        _result_nb_vars = 1;
+        _result_nb_clauses = 1;
+    }
+}
+
+void CnfPreprocessor::buildOccurrences() {
+    _occ_offsets.assign(2*(size_t)_nb_vars + 3, 0);
+    for (size_t c = 0; c < _sizes.size(); c++) {
+        if (_deleted[c]) continue;
+        for (size_t i = _offsets[c]; i < _offsets[c] + _sizes[c]; i++) _occ_offsets[litIndex(_lits[i])+1]++;
+    }
+    for (size_t idx = 1; idx < _occ_offsets.size(); idx++) _occ_offsets[idx] += _occ_offsets[idx-1];
+    _occ.resize(_occ_offsets.back());
+    std::vector<size_t> pos(_occ_offsets.begin(), _occ_offsets.end()-1);
+    for (size_t c = 0; c < _sizes.size(); c++) {
+        if (_deleted[c]) continue;
+        for (size_t i = _offsets[c]; i < _offsets[c] + _sizes[c]; i++) _occ[pos[litIndex(_lits[i])]++] = c;
+    }
+}
+
+size_t CnfPreprocessor::getNumChunks() const {
+    return std::max((size_t) 1, std::min((size_t) _num_threads, _sizes.size() / MIN_CLAUSES_PER_CHUNK));
+}
+
+void CnfPreprocessor::forEachChunk(const std::function<void(size_t, size_t, size_t)>& f) const {
+    const size_t numClauses = _sizes.size();
+    const size_t numChunks = getNumChunks();
+    std::vector<std::thread> threads;
+    for (size_t chunk = 1; chunk < numChunks; chunk++) {
+        threads.emplace_back([&, chunk]() {
+            f(chunk, chunk*numClauses/numChunks, (chunk+1)*numClauses/numChunks);
+        });
+    }
+    f(0, 0, numClauses/numChunks);
+    for (auto& thread : threads) thread.join();
+}
@@ -0,0 +1,98 @@
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <vector>
+
+class JobDescription;
+class Parameters;
+
+// In-process preprocessing of a flat, zero-separated CNF formula: removal of
+// tautologies and duplicate literals, unit propagation, removal of duplicate and
+// subsumed clauses, pure literal elimination, and a renumbering of the remaining
+// variables to a dense range. Each of these steps leaves an original variable
+// either fixed, free, or mapped to a variable of the reduced formula, so a model
+// of the reduced formula is extended to a model of the original formula by a
+// simple lookup (see Reconstruction). The passes over all clauses run in
+// parallel over chunks of clauses.
+class CnfPreprocessor {
+
+public:
+    struct Reconstruction {
+        // For each original variable: the variable in the reduced formula (0: none)
+        std::vector<int> mapping;
+        // For each original variable without a mapping: its fixed sign (0: free)
+        std::vector<int8_t> fixed;
+
+        // Maps a model [0, ±1, ..., ±m] of the reduced formula to a model
+        // [0, ±1, ..., ±n] of the original formula.
+        std::vector<int> reconstructModel(const std::vector<int>& reducedModel) const;
+    };
+
+    struct Statistics {
+        size_t numTautologies {0};
+        size_t numUnits {0};
+        size_t numDuplicates {0};
+        size_t numSubsumed {0};
+        size_t numPureLiterals {0};
+    };
+
+private:
+    const int _num_threads;
+
+    int _nb_vars {0};
+    std::vector<int> _lits;       // literals of all clauses, without separators
+    std::vector<size_t> _offsets; // clause c begins at _lits[_offsets[c]]
+    std::vector<uint32_t> _sizes; // current size of each clause (shrinks in place)
+    std::vector<uint8_t> _deleted;
+    std::vector<int8_t> _values;  // per variable: 1 true, -1 false, 0 unassigned
+    bool _unsat {false};
+
+    // Clause occurrences per literal, indexed by litIndex()
+    std::vector<size_t> _occ_offsets;
+    std::vector<size_t> _occ;
+
+    std::vector<int> _result;
+    int _result_nb_vars {0};
+    int _result_nb_clauses {0};
+    std::shared_ptr<Reconstruction> _reconstruction;
+    Statistics _stats;
+
+public:
+    CnfPreprocessor(int numThreads) : _num_threads(std::max(1, numThreads)) {}
+
+    void process(const int* lits, size_t size, int nbVars);
+
+    bool isUnsat() const {return _unsat;}
+    const std::vector<int>& getFormula() const {return _result;}
+    int getNbVars() const {return _result_nb_vars;}
+    int getNbClauses() const {return _result_nb_clauses;}
+    std::shared_ptr<Reconstruction> getReconstruction() const {return _reconstruction;}
+    const Statistics& getStatistics() const {return _stats;}
+
+    // Replaces the formula of a freshly read, non-incremental SAT job description
+    // with its preprocessed version. Returns the according model reconstruction.
+    static std::shared_ptr<Reconstruction> preprocess(const Parameters& params, JobDescription& desc);
+
+private:
+    void normalizeClauses();
+    void propagateUnits();
+    void removeDuplicates();
+    void removeSubsumed();
+    void eliminatePureLiterals();
+    void compact();
+
+    void buildOccurrences();
+    int value(int lit) const {return lit > 0 ? _values[lit] : -_values[-lit];}
+    static size_t litIndex(int lit) {return 2*(size_t)std::abs(lit) + (lit < 0);}
+
+    // Calls f(chunkIdx, beginClause, endClause) for a partition of the clauses
+    // into at most _num_threads chunks, each in its own thread.
+    size_t getNumChunks() const;
+    void forEachChunk(const std::function<void(size_t, size_t, size_t)>& f) const;
+};
@@ -0,0 +1,279 @@
+
+#include "decompressing_reader.hpp"
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <vector>
+#include <zlib.h>
+#ifdef MALLOB_USE_BZIP2
+#include <bzlib.h>
+#endif
+#ifdef MALLOB_USE_LZMA
+#include <lzma.h>
+#endif
+#ifdef MALLOB_USE_ZSTD
+#include <zstd.h>
+#endif
+
+#include "util/logger.hpp"
+
+namespace {
+
+    // Size of the compressed blocks read from the input file
+    constexpr size_t INPUT_BLOCK_SIZE = 1<<20;
+
+    class PlainCodec : public DecompressionCodec {
+    private:
+        int _fd;
+    public:
+        PlainCodec(int fd) : _fd(fd) {}
+        ~PlainCodec() {close(_fd);}
+        ssize_t read(char* out, size_t size) override {
+            return ::read(_fd, out, size);
+        }
+    };
+
+    class GzipCodec : public DecompressionCodec {
+    private:
+        gzFile _file;
+    public:
+        GzipCodec(gzFile file) : _file(file) {
+            gzbuffer(_file, INPUT_BLOCK_SIZE);
+        }
+        ~GzipCodec() {gzclose(_file);}
+        ssize_t read(char* out, size_t size) override {
+            // gzread transparently continues with concatenated gzip members
+            return gzread(_file, out, std::min(size, (size_t) INT_MAX));
+        }
+    };
+
+#ifdef MALLOB_USE_BZIP2
+    class Bzip2Codec : public DecompressionCodec {
+    private:
+        FILE* _file;
+        BZFILE* _bzfile {nullptr};
+        bool _done {false};
+    public:
+        Bzip2Codec(FILE* file) : _file(file) {
+            int error;
+            _bzfile = BZ2_bzReadOpen(&error, _file, 0, 0, nullptr, 0);
+            if (error != BZ_OK) _done = true;
+        }
+        ~Bzip2Codec() {
+            int error;
+            if (_bzfile) BZ2_bzReadClose(&error, _bzfile);
+            fclose(_file);
+        }
+        ssize_t read(char* out, size_t size) override {
+            size = std::min(size, (size_t) INT_MAX);
+            while (!_done) {
+                int error;
+                int numRead = BZ2_bzRead(&error, _bzfile, out, size);
+                if (error == BZ_OK) return numRead;
+                if (error != BZ_STREAM_END) return -1;
+                // End of a stream: files written by parallel bzip2 tools
+                // may contain further concatenated streams.
+                void* unused; int numUnused;
+                BZ2_bzReadGetUnused(&error, _bzfile, &unused, &numUnused);
+                std::vector<char> rest((char*) unused, ((char*) unused) + numUnused);
+                BZ2_bzReadClose(&error, _bzfile);
+                _bzfile = nullptr;
+                if (rest.empty()) {
+                    int c = fgetc(_file);
+                    if (c == EOF) _done = true;
+                    else rest.push_back((char) c);
+                }
+                if (!_done) {
+                    _bzfile = BZ2_bzReadOpen(&error, _file, 0, 0, rest.data(), rest.size());
+                    if (error != BZ_OK) return -1;
+                }
+                if (numRead > 0) return numRead;
+            }
+            return 0;
+        }
+    };
+#endif
+
+#ifdef MALLOB_USE_LZMA
+    class LzmaCodec : public DecompressionCodec {
+    private:
+        int _fd;
+        lzma_stream _stream = LZMA_STREAM_INIT;
+        std::vector<uint8_t> _input;
+        bool _input_done {false};
+        bool _done {false};
+    public:
+        LzmaCodec(int fd) : _fd(fd), _input(INPUT_BLOCK_SIZE) {
+            // handles both .xz (incl. concatenated streams) and legacy .lzma
+            if (lzma_auto_decoder(&_stream, UINT64_MAX, LZMA_CONCATENATED) != LZMA_OK)
+                _done = true;
+        }
+        ~LzmaCodec() {
+            lzma_end(&_stream);
+            close(_fd);
+        }
+        ssize_t read(char* out, size_t size) override {
+            if (_done) return 0;
+            _stream.next_out = (uint8_t*) out;
+            _stream.avail_out = size;
+            while (_stream.avail_out == size) {
+                if (_stream.avail_in == 0 && !_input_done) {
+                    ssize_t numRead = ::read(_fd, _input.data(), _input.size());
+                    if (numRead < 0) return -1;
+                    if (numRead == 0) _input_done = true;
+                    _stream.next_in = _input.data();
+                    _stream.avail_in = numRead;
+                }
+                lzma_ret ret = lzma_code(&_stream, _input_done ? LZMA_FINISH : LZMA_RUN);
+                if (ret == LZMA_STREAM_END) {
+                    _done = true;
+                    break;
+                }
+                if (ret != LZMA_OK) {
+                    LOG(V1_WARN, "[WARN] xz/lzma decoder error %i\n", (int) ret);
+                    return -1;
+                }
+            }
+            return size - _stream.avail_out;
+        }
+    };
+#endif
+
+#ifdef MALLOB_USE_ZSTD
+    class ZstdCodec : public DecompressionCodec {
+    private:
+        int _fd;
+        ZSTD_DStream* _stream;
+        std::vector<char> _input;
+        ZSTD_inBuffer _in_buffer {nullptr, 0, 0};
+        bool _input_done {false};
+    public:
+        ZstdCodec(int fd) : _fd(fd), _stream(ZSTD_createDStream()), _input(INPUT_BLOCK_SIZE) {
+            ZSTD_initDStream(_stream);
+        }
+        ~ZstdCodec() {
+            ZSTD_freeDStream(_stream);
+            close(_fd);
+        }
+        ssize_t read(char* out, size_t size) override {
+            ZSTD_outBuffer outBuffer {out, size, 0};
+            while (outBuffer.pos == 0) {
+                if (_in_buffer.pos == _in_buffer.size) {
+                    if (_input_done) break;
+                    ssize_t numRead = ::read(_fd, _input.data(), _input.size());
+                    if (numRead < 0) return -1;
+                    if (numRead == 0) {
+                        _input_done = true;
+                        break;
+                    }
+                    _in_buffer = ZSTD_inBuffer {_input.data(), (size_t) numRead, 0};
+                }
+                size_t ret = ZSTD_decompressStream(_stream, &outBuffer, &_in_buffer);
+                if (ZSTD_isError(ret)) {
+                    LOG(V1_WARN, "[WARN] zstd decoder error: %s\n", ZSTD_getErrorName(ret));
+                    return -1;
+                }
+            }
+            return outBuffer.pos;
+        }
+    };
+#endif
+
+    // Fallback: decompression by an external command
+    class ProcessCodec : public DecompressionCodec {
+    private:
+        FILE* _pipe;
+    public:
+        ProcessCodec(FILE* pipe) : _pipe(pipe) {}
+        ~ProcessCodec() {pclose(_pipe);}
+        ssize_t read(char* out, size_t size) override {
+            return ::read(fileno(_pipe), out, size);
+        }
+    };
+}
+
+DecompressingReader::Format DecompressingReader::detectFormat(const std::string& filename) {
+    unsigned char magic[6] = {0};
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd == -1) return PLAIN;
+    ssize_t numRead = ::read(fd, magic, sizeof(magic));
+    close(fd);
+
+    if (numRead >= 2 && magic[0] == 0x1f && magic[1] == 0x8b) return GZIP;
+    if (numRead >= 3 && magic[0] == 'B' && magic[1] == 'Z' && magic[2] == 'h') return BZIP2;
+    if (numRead >= 6 && memcmp(magic, "\xfd" "7zXZ\0", 6) == 0) return XZ;
+    if (numRead >= 4 && magic[0] == 0x28 && magic[1] == 0xb5 && magic[2] == 0x2f && magic[3] == 0xfd) return ZSTD;
+    // Legacy .lzma files have no magic bytes
+    if (filename.size() > 5 && filename.substr(filename.size()-5, 5) == ".lzma") return LZMA;
+    return PLAIN;
+}
+
+const char* DecompressingReader::getFormatName(Format format) {
+    switch (format) {
+    case GZIP: return "gzip";
+    case BZIP2: return "bzip2";
+    case XZ: return "xz";
+    case LZMA: return "lzma";
+    case ZSTD: return "zstd";
+    default: return "plain";
+    }
+}
+
+DecompressingReader::DecompressingReader(const std::string& filename) : _format(detectFormat(filename)) {
+
+    std::string command;
+    switch (_format) {
+    case PLAIN: {
+        int fd = open(filename.c_str(), O_RDONLY);
+        if (fd != -1) _codec.reset(new PlainCodec(fd));
+        break;
+    }
+    case GZIP: {
+        gzFile file = gzopen(filename.c_str(), "rb");
+        if (file) _codec.reset(new GzipCodec(file));
+        break;
+    }
+    case BZIP2: {
+#ifdef MALLOB_USE_BZIP2
+        FILE* file = fopen(filename.c_str(), "rb");
+        if (file) _codec.reset(new Bzip2Codec(file));
+#else
+        command = "bzip2 -c -d ";
+#endif
+        break;
+    }
+    case XZ:
+    case LZMA: {
+#ifdef MALLOB_USE_LZMA
+        int fd = open(filename.c_str(), O_RDONLY);
+        if (fd != -1) _codec.reset(new LzmaCodec(fd));
+#else
+        command = "xz -c -d ";
+#endif
+        break;
+    }
+    case ZSTD: {
+#ifdef MALLOB_USE_ZSTD
+        int fd = open(filename.c_str(), O_RDONLY);
+        if (fd != -1) _codec.reset(new ZstdCodec(fd));
+#else
+        command = "zstd -c -d ";
+#endif
+        break;
+    }
+    }
+
+    if (!command.empty()) {
+        LOG(V3_VERB, "No built-in %s codec - decompressing %s externally\n",
+            getFormatName(_format), filename.c_str());
+        FILE* pipe = popen((command + "\"" + filename + "\"").c_str(), "r");
+        if (pipe) _codec.reset(new ProcessCodec(pipe));
+    }
+}
+
+DecompressingReader::~DecompressingReader() {}
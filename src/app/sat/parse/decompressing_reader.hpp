@@ -0,0 +1,44 @@
+
+#pragma once
+
+#include <sys/types.h>
+#include <memory>
+#include <string>
+
+// A streaming decoder which yields the decompressed content of some input.
+class DecompressionCodec {
+public:
+    virtual ~DecompressionCodec() {}
+    // Writes up to size decompressed bytes to out. Returns the number of
+    // written bytes, 0 at the end of the input, or -1 if an error occurred.
+    virtual ssize_t read(char* out, size_t size) = 0;
+};
+
+// Reads a possibly compressed file as a stream of decompressed blocks.
+// The compression format is detected by the file's magic bytes, with the file
+// extension as a fallback for legacy .lzma files (which have no signature).
+// Decompression happens in-process for all codecs compiled into Mallob
+// (gzip always; bzip2, xz/lzma and zstd depending on MALLOB_USE_*). Other
+// formats are decompressed by the according command line tool via a pipe.
+class DecompressingReader {
+
+public:
+    enum Format {PLAIN, GZIP, BZIP2, XZ, LZMA, ZSTD};
+    static Format detectFormat(const std::string& filename);
+    static const char* getFormatName(Format format);
+
+private:
+    Format _format;
+    std::unique_ptr<DecompressionCodec> _codec;
+
+public:
+    DecompressingReader(const std::string& filename);
+    ~DecompressingReader();
+
+    bool valid() const {return (bool) _codec;}
+    Format getFormat() const {return _format;}
+
+    ssize_t read(char* out, size_t size) {
+        return _codec->read(out, size);
+    }
+};
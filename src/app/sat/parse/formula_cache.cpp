@@ -0,0 +1,164 @@
+
+#include "formula_cache.hpp"
+
+#include <fcntl.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <filesystem>
+#include <vector>
+
+#include "data/job_description.hpp"
+#include "util/logger.hpp"
+#include "util/sys/fileutils.hpp"
+#include "util/sys/proc.hpp"
+
+namespace {
+    // 64-bit FNV-1a: stable across builds and platforms, unlike std::hash
+    uint64_t fnv1a(const std::string& str) {
+        uint64_t hash = 14695981039346656037UL;
+        for (unsigned char c : str) {
+            hash ^= c;
+            hash *= 1099511628211UL;
+        }
+        return hash;
+    }
+    size_t getPaddedKeySize(size_t keySize) {
+        return (keySize + 7) & ~((size_t) 7);
+    }
+}
+
+bool FormulaCache::load(const std::string& inputFile, const std::string& variant,
+        JobDescription& desc, int& nbVars, int& nbClauses) {
+
+    std::string key;
+    if (!getKey(inputFile, variant, key)) return false;
+    const std::string path = getEntryPath(key);
+
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd == -1) return false;
+    struct stat s;
+    if (fstat(fd, &s) != 0 || s.st_size < (off_t) sizeof(Header)) {
+        close(fd);
+        return false;
+    }
+    const size_t size = s.st_size;
+    void* mapped = mmap(0, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mapped == MAP_FAILED) {
+        close(fd);
+        return false;
+    }
+    madvise(mapped, size, MADV_SEQUENTIAL);
+
+    Header header;
+    memcpy(&header, mapped, sizeof(Header));
+    const char* keyBegin = ((const char*) mapped) + sizeof(Header);
+    const size_t literalsOffset = sizeof(Header) + getPaddedKeySize(header.keySize);
+    bool valid = header.magic == MAGIC && header.version == VERSION
+        && header.keySize == key.size()
+        && literalsOffset + sizeof(int) * (header.formulaSize + header.assumptionsSize) == size
+        && memcmp(keyBegin, key.data(), key.size()) == 0;
+    if (valid) {
+        const int* formula = (const int*) (((const char*) mapped) + literalsOffset);
+        desc.reserveSize(sizeof(int) * (header.formulaSize + header.assumptionsSize));
+        desc.addPermanentData(formula, header.formulaSize);
+        desc.addTransientData(formula + header.formulaSize, header.assumptionsSize);
+        nbVars = header.nbVars;
+        nbClauses = header.nbClauses;
+        // Mark entry as recently used
+        futimens(fd, nullptr);
+    } else {
+        LOG(V1_WARN, "[WARN] Ignoring invalid formula cache entry %s\n", path.c_str());
+    }
+    munmap(mapped, size);
+    close(fd);
+    return valid;
+}
+
+void FormulaCache::store(const std::string& inputFile, const std::string& variant,
+        JobDescription& desc, int nbVars, int nbClauses) {
+
+    std::string key;
+    if (!getKey(inputFile, variant, key)) return;
+    FileUtils::mkdir(_directory);
+
+    const size_t formulaSize = desc.getNumFormulaLiterals();
+    const size_t assumptionsSize = desc.getNumAssumptionLiterals();
+    const uint8_t* literals = desc.getRevisionData(desc.getRevision())->data() + desc.getMetadataSize();
+    Header header {MAGIC, VERSION, key.size(), formulaSize, assumptionsSize, nbVars, nbClauses};
+    if (sizeof(Header) + getPaddedKeySize(key.size()) + sizeof(int) * (formulaSize + assumptionsSize) > _max_size)
+        return; // would not fit into the cache anyway
+
+    // Write to a temporary file first and then publish it atomically
+    const std::string path = getEntryPath(key);
+    const std::string tmpPath = path + ".tmp." + std::to_string(getpid()) + "." + std::to_string(Proc::getTid());
+    FILE* file = fopen(tmpPath.c_str(), "w");
+    if (!file) return;
+    std::vector<char> paddedKey(getPaddedKeySize(key.size()), 0);
+    memcpy(paddedKey.data(), key.data(), key.size());
+    bool ok = fwrite(&header, sizeof(Header), 1, file) == 1
+        && fwrite(paddedKey.data(), 1, paddedKey.size(), file) == paddedKey.size()
+        && fwrite(literals, sizeof(int), formulaSize + assumptionsSize, file) == formulaSize + assumptionsSize;
+    ok = (fclose(file) == 0) && ok;
+    if (!ok || rename(tmpPath.c_str(), path.c_str()) != 0) {
+        LOG(V1_WARN, "[WARN] Could not write formula cache entry %s\n", path.c_str());
+        remove(tmpPath.c_str());
+        return;
+    }
+    LOG(V4_VVER, "Cached parsed formula %s as %s\n", inputFile.c_str(), path.c_str());
+
+    evict();
+}
+
+bool FormulaCache::getKey(const std::string& inputFile, const std::string& variant, std::string& key) const {
+    char canonicalPath[PATH_MAX];
+    if (realpath(inputFile.c_str(), canonicalPath) == nullptr) return false;
+    struct stat s;
+    if (stat(canonicalPath, &s) != 0 || !S_ISREG(s.st_mode)) return false;
+    key = std::string(canonicalPath) + "\n" + std::to_string(s.st_size) + "\n"
+        + std::to_string(s.st_mtim.tv_sec) + "." + std::to_string(s.st_mtim.tv_nsec) + "\n" + variant;
+    return true;
+}
+
+std::string FormulaCache::getEntryPath(const std::string& key) const {
+    char hex[17];
+    snprintf(hex, sizeof(hex), "%016lx", (unsigned long) fnv1a(key));
+    return _directory + "/" + std::string(hex) + ".mfc";
+}
+
+void FormulaCache::evict() {
+    struct CachedFile {
+        std::string path;
+        size_t size;
+        std::filesystem::file_time_type lastUse;
+    };
+    std::vector<CachedFile> files;
+    size_t totalSize = 0;
+    std::error_code ec;
+    for (const auto& dirEntry : std::filesystem::directory_iterator(_directory, ec)) {
+        if (dirEntry.path().extension() != ".mfc") continue;
+        std::error_code ecSize, ecTime;
+        size_t size = dirEntry.file_size(ecSize);
+        auto lastUse = dirEntry.last_write_time(ecTime);
+        if (ecSize || ecTime) continue; // concurrently removed
+        files.push_back(CachedFile{dirEntry.path().string(), size, lastUse});
+        totalSize += size;
+    }
+    if (totalSize <= _max_size) return;
+
+    std::sort(files.begin(), files.end(), [](const CachedFile& a, const CachedFile& b) {
+        return a.lastUse < b.lastUse;
+    });
+    for (const auto& file : files) {
+        if (totalSize <= _max_size) break;
+        if (remove(file.path.c_str()) == 0) {
+            LOG(V4_VVER, "Evicted formula cache entry %s\n", file.path.c_str());
+        }
+        totalSize -= file.size;
+    }
+}
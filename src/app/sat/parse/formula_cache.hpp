@@ -0,0 +1,57 @@
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+class JobDescription;
+
+// Persistent on-disk cache of parsed formulae. An entry holds the serialized
+// literals (formula and assumptions) of an input file together with its number
+// of variables and clauses. Entries are keyed by the input's canonical path,
+// size and modification time as well as a "variant" string which captures all
+// settings which influence the parsed result (e.g., content mode, preprocessor).
+// Entries are written to a temporary file which is then renamed, so concurrent
+// readers never see partial entries, and are memory-mapped for reading.
+// The total size of the cache directory is bounded: After each insertion, the
+// least recently used entries are evicted, where each cache hit refreshes the
+// modification time of the entry.
+class FormulaCache {
+
+private:
+    struct Header {
+        uint32_t magic;
+        uint32_t version;
+        uint64_t keySize;
+        uint64_t formulaSize;
+        uint64_t assumptionsSize;
+        int32_t nbVars;
+        int32_t nbClauses;
+    };
+    static constexpr uint32_t MAGIC = 0x4d464331; // "MFC1"
+    static constexpr uint32_t VERSION = 1;
+
+    const std::string _directory;
+    const size_t _max_size;
+
+public:
+    FormulaCache(const std::string& directory, size_t maxSizeBytes) :
+        _directory(directory), _max_size(maxSizeBytes) {}
+
+    // If a valid entry for the given input exists, appends its literals to the
+    // revision of the provided description which is being initialized, outputs
+    // the entry's numbers of variables and clauses, and returns true.
+    bool load(const std::string& inputFile, const std::string& variant,
+        JobDescription& desc, int& nbVars, int& nbClauses);
+
+    // Stores the literals of the provided description's current revision,
+    // which must be initialized but not yet finalized (endInitialization).
+    // Evicts least recently used entries if the cache exceeds its size bound.
+    void store(const std::string& inputFile, const std::string& variant,
+        JobDescription& desc, int nbVars, int nbClauses);
+
+private:
+    bool getKey(const std::string& inputFile, const std::string& variant, std::string& key) const;
+    std::string getEntryPath(const std::string& key) const;
+    void evict();
+};
@@ -0,0 +1,182 @@
+
+#include "portfolio_tuner.hpp"
+
+#include <stdlib.h>
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <utility>
+
+#include "app/sat/data/portfolio_sequence.hpp"
+#include "data/job_description.hpp"
+#include "data/job_result.hpp"
+#include "util/logger.hpp"
+#include "util/params.hpp"
+
+namespace {
+    // App configuration entry holding the tuned configuration, padded with dots
+    // to a fixed width so that it can be written after the job was initialized
+    const std::string TUNED_CONFIG_KEY = "__PFT";
+    const size_t TUNED_CONFIG_WIDTH = 16;
+
+    int getFormulaSize(const JobDescription& desc, const std::string& key) {
+        const auto& config = desc.getAppConfiguration().map;
+        return config.count(key) ? atoi(config.at(key).c_str()) : 0;
+    }
+}
+
+PortfolioTuner::PortfolioTuner(const std::string& storePath, float exploration, int numNeighbors) :
+        _store_path(storePath), _exploration(exploration), _num_neighbors(std::max(1, numNeighbors)),
+        _rng(std::random_device()()) {
+    load();
+}
+
+PortfolioTuner& PortfolioTuner::get(const Parameters& params) {
+    static PortfolioTuner tuner(params.portfolioTuningStore(),
+        params.portfolioTuningExploration(), params.portfolioTuningNeighbors());
+    return tuner;
+}
+
+bool PortfolioTuner::isEnabled(const Parameters& params) {
+    return params.portfolioTuningStore.isSet()
+        && !params.proofOutputFile.isSet() && !params.onTheFlyChecking();
+}
+
+void PortfolioTuner::reserveConfiguration(JobDescription& desc) {
+    desc.setAppConfigurationEntry(TUNED_CONFIG_KEY, std::string(TUNED_CONFIG_WIDTH, '.'));
+}
+
+std::string PortfolioTuner::getConfiguration(const JobDescription& desc) {
+    const auto& config = desc.getAppConfiguration().map;
+    if (!config.count(TUNED_CONFIG_KEY)) return "";
+    std::string str = config.at(TUNED_CONFIG_KEY);
+    while (!str.empty() && str.back() == '.') str.pop_back();
+    return str;
+}
+
+std::string PortfolioTuner::getConfiguration(const Parameters& params, const JobDescription& desc, int globalId) {
+    PortfolioSequence portfolio;
+    if (globalId < 0 || !portfolio.parse(params.satSolverSequence()) || portfolio.cycle.empty())
+        return "";
+    // The tuned configuration replaces the portfolio's first solver (see SatEngine)
+    const std::string tuned = getConfiguration(desc);
+    if (!tuned.empty() && globalId == 0) return tuned;
+    int divIdx;
+    auto item = portfolio.getItem(globalId, divIdx);
+    const auto& config = desc.getAppConfiguration().map;
+    const std::string offsetKey = globalId < (int) portfolio.prefix.size() ? "div-offset-prefix" : "div-offset-cycle";
+    if (config.count(offsetKey)) divIdx += atoi(config.at(offsetKey).c_str());
+    return PortfolioSequence::toConfiguration(item, divIdx);
+}
+
+void PortfolioTuner::tune(JobDescription& desc) {
+    if (!desc.getAppConfiguration().map.count(TUNED_CONFIG_KEY)) return;
+    std::string config = select(getFormulaSize(desc, "__NV"), getFormulaSize(desc, "__NC"),
+        desc.getNumFormulaLiterals());
+    if (config.empty() || config.size() > TUNED_CONFIG_WIDTH) return;
+    LOG(V3_VERB, "Tuned portfolio of #%i: first solver runs %s\n", desc.getId(), config.c_str());
+    config.resize(TUNED_CONFIG_WIDTH, '.');
+    desc.setAppConfigurationEntry(TUNED_CONFIG_KEY, config);
+    desc.writeMetadata();
+}
+
+void PortfolioTuner::record(const Parameters& params, JobDescription& desc, const JobResult& result) {
+    if (!desc.getAppConfiguration().map.count(TUNED_CONFIG_KEY)) return; // not a tunable job
+    Record record;
+    record.nbVars = getFormulaSize(desc, "__NV");
+    record.nbClauses = getFormulaSize(desc, "__NC");
+    record.nbLits = desc.getNumFormulaLiterals();
+    record.tuned = getConfiguration(desc);
+    if (result.result != 0) record.winner = getConfiguration(params, desc, result.winningInstanceId);
+    if (record.tuned.empty()) record.tuned = "-";
+    if (record.winner.empty()) record.winner = "-";
+    record.result = result.result;
+    record.time = desc.getStatistics().processingTime;
+    addRecord(std::move(record));
+}
+
+std::string PortfolioTuner::select(int nbVars, int nbClauses, size_t nbLits) {
+    auto lock = _mtx.getLock();
+    if (_exploration > 0 && std::uniform_real_distribution<float>(0, 1)(_rng) < _exploration)
+        return "";
+
+    // Find the most similar records which say something about some configuration
+    std::vector<std::pair<double, size_t>> neighbors;
+    for (size_t i = 0; i < _records.size(); i++) {
+        const auto& rec = _records[i];
+        if (rec.winner == "-" && rec.tuned == "-") continue;
+        neighbors.emplace_back(getDistance(rec, nbVars, nbClauses, nbLits), i);
+    }
+    const size_t k = std::min(neighbors.size(), (size_t) _num_neighbors);
+    std::partial_sort(neighbors.begin(), neighbors.begin()+k, neighbors.end());
+
+    // Similarity-weighted wins and trials of each configuration:
+    // a tuned configuration which did not win counts as a failed trial
+    std::map<std::string, std::pair<double, double>> scores;
+    for (size_t n = 0; n < k; n++) {
+        const auto& [dist, i] = neighbors[n];
+        const auto& rec = _records[i];
+        const double similarity = 1 / (1 + dist);
+        if (rec.winner != "-") {
+            scores[rec.winner].first += similarity;
+            scores[rec.winner].second += similarity;
+        }
+        if (rec.tuned != "-" && rec.tuned != rec.winner) scores[rec.tuned].second += similarity;
+    }
+
+    // Best success rate, with a prior of one failed trial against single lucky wins
+    std::string best;
+    double bestScore = 0;
+    for (const auto& [config, score] : scores) {
+        const double rate = score.first / (score.second + 1);
+        if (rate > bestScore) {
+            best = config;
+            bestScore = rate;
+        }
+    }
+    return best;
+}
+
+void PortfolioTuner::addRecord(Record&& record) {
+    auto lock = _mtx.getLock();
+    std::ofstream ofs(_store_path, std::ofstream::app);
+    if (ofs.is_open()) {
+        ofs << record.nbVars << " " << record.nbClauses << " " << record.nbLits << " "
+            << record.tuned << " " << record.winner << " " << record.result << " " << record.time << "\n";
+    } else {
+        LOG(V1_WARN, "[WARN] Cannot write to portfolio tuning store %s\n", _store_path.c_str());
+    }
+    _records.push_back(std::move(record));
+}
+
+size_t PortfolioTuner::getNumRecords() {
+    auto lock = _mtx.getLock();
+    return _records.size();
+}
+
+void PortfolioTuner::load() {
+    std::ifstream ifs(_store_path);
+    if (!ifs.is_open()) return;
+    std::string line;
+    while (std::getline(ifs, line)) {
+        std::istringstream iss(line);
+        Record rec;
+        if (iss >> rec.nbVars >> rec.nbClauses >> rec.nbLits >> rec.tuned >> rec.winner >> rec.result >> rec.time)
+            _records.push_back(std::move(rec));
+    }
+    LOG(V3_VERB, "Loaded %lu records from portfolio tuning store %s\n", _records.size(), _store_path.c_str());
+}
+
+double PortfolioTuner::getDistance(const Record& record, int nbVars, int nbClauses, size_t nbLits) {
+    // Log-scaled size and density features
+    auto features = [](int v, int c, size_t l) {
+        return std::vector<double> {std::log1p(v), std::log1p(c), std::log1p(l / (double) std::max(1, c))};
+    };
+    auto a = features(record.nbVars, record.nbClauses, record.nbLits);
+    auto b = features(nbVars, nbClauses, nbLits);
+    double sqDist = 0;
+    for (size_t i = 0; i < a.size(); i++) sqDist += (a[i]-b[i]) * (a[i]-b[i]);
+    return std::sqrt(sqDist);
+}
@@ -0,0 +1,77 @@
+
+#pragma once
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "util/sys/threading.hpp"
+
+class JobDescription;
+class Parameters;
+struct JobResult;
+
+// Client-side tuning of the solver portfolio across jobs. For each finished
+// job, a record of the job's features (numbers of variables, clauses, and
+// literals), the tuned configuration it ran with (if any), the configuration
+// of the winning solver (if any), the result, and the processing time is
+// appended to a persistent store. Before a new job is introduced, the
+// configurations which won on the most similar recorded jobs are ranked by
+// their similarity-weighted success rate, and the job's first solver runs the
+// best one instead of its configuration from the portfolio. With a certain
+// probability a job is left untuned in order to keep exploring (epsilon-greedy).
+// A configuration is a portfolio item with a diversification index as written
+// by PortfolioSequence::toConfiguration, e.g., "k3".
+class PortfolioTuner {
+
+public:
+    struct Record {
+        int nbVars;
+        int nbClauses;
+        size_t nbLits;
+        std::string tuned;  // configuration of the job's first solver if tuned ("-": none)
+        std::string winner; // configuration of the winning solver ("-": unknown)
+        int result;
+        float time;
+    };
+
+private:
+    const std::string _store_path;
+    const float _exploration;
+    const int _num_neighbors;
+
+    Mutex _mtx;
+    std::vector<Record> _records;
+    std::mt19937 _rng;
+
+public:
+    PortfolioTuner(const std::string& storePath, float exploration, int numNeighbors);
+
+    // The process-wide tuner configured by the provided parameters.
+    static PortfolioTuner& get(const Parameters& params);
+    static bool isEnabled(const Parameters& params);
+
+    // Reserves room for a tuned configuration in the app configuration of a job
+    // description which is about to be initialized.
+    static void reserveConfiguration(JobDescription& desc);
+    // The tuned configuration of an initialized job description ("" if none).
+    static std::string getConfiguration(const JobDescription& desc);
+    // The configuration of the solver with the given global ID in the provided job.
+    static std::string getConfiguration(const Parameters& params, const JobDescription& desc, int globalId);
+
+    // Selects a configuration for the initialized job description and writes it
+    // into the description's reserved app configuration entry.
+    void tune(JobDescription& desc);
+    // Records the outcome of a finished job.
+    void record(const Parameters& params, JobDescription& desc, const JobResult& result);
+
+    // The tuning policy: the configuration for the first solver of a job with
+    // the provided features, or "" if the job should not be tuned.
+    std::string select(int nbVars, int nbClauses, size_t nbLits);
+    void addRecord(Record&& record);
+    size_t getNumRecords();
+
+private:
+    void load();
+    static double getDistance(const Record& record, int nbVars, int nbClauses, size_t nbLits);
+};
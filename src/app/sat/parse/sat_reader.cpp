@@ -5,6 +5,7 @@
 #include <fcntl.h>
 #include <unistd.h>
 #include <stdlib.h>
+#include <string.h>
 #include <assert.h>
 #include <fstream>
 #include <cstdint>
@@ -16,6 +17,8 @@
 #include "app/sat/proof/trusted/trusted_utils.hpp"
 #include "app/sat/proof/trusted_parser_process_adapter.hpp"
 #include "sat_reader.hpp"
+#include "formula_cache.hpp"
+#include "portfolio_tuner.hpp"
 #include "util/logger.hpp"
 #include "util/params.hpp"
 #include "util/sys/terminator.hpp"
@@ -59,20 +62,20 @@ bool SatReader::parseInternally(JobDescription& desc) {
 	_raw_content_mode = desc.getAppConfiguration().map.count("content-mode")
 		&& desc.getAppConfiguration().map.at("content-mode") == "raw";
 
-	_pipe = nullptr;
+	_decompressor.reset();
 	_namedpipe = -1;
-	if ((_filename.size() > 3 && _filename.substr(_filename.size()-3, 3) == ".xz")
-		|| (_filename.size() > 5 && _filename.substr(_filename.size()-5, 5) == ".lzma")) {
-		// Decompress, read output
-		auto command = "xz -c -d " + _filename;
-		_pipe = popen(command.c_str(), "r");
-		if (_pipe == nullptr) return false;
-	} else if (_filename.size() > 5 && _filename.substr(_filename.size()-5, 5) == ".pipe") {
+	if (_filename.size() > 5 && _filename.substr(_filename.size()-5, 5) == ".pipe") {
 		// Named pipe!
 		_namedpipe = open(_filename.c_str(), O_RDONLY);
+	} else if (DecompressingReader::detectFormat(_filename) != DecompressingReader::PLAIN) {
+		// Decompress in a streaming manner, read output
+		_decompressor.reset(new DecompressingReader(_filename));
+		if (!_decompressor->valid()) return false;
+		LOG(V4_VVER, "Reading %s compressed input %s\n",
+			DecompressingReader::getFormatName(_decompressor->getFormat()), _filename.c_str());
 	}
 
-	if (_pipe == nullptr && _namedpipe == -1) {
+	if (!_decompressor && _namedpipe == -1) {
 
 		if (_params.satPreprocessor.isSet()) {
 
@@ -109,14 +112,17 @@ bool SatReader::parseInternally(JobDescription& desc) {
 		int status = stat(_filename.c_str(), &s);
 		if (status == -1) return false;
 		size = s.st_size;
-		desc.reserveSize(size / sizeof(int));
+		// raw content is copied 1:1 into the description
+		desc.reserveSize(_raw_content_mode ? size : size / sizeof(int));
 		void* mmapped = mmap(0, size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (mmapped == MAP_FAILED) {
+			close(fd);
+			return false;
+		}
 
 		if (_raw_content_mode) {
-			int* f = (int*) mmapped;
-			for (long i = 0; i < size; i++) {
-				processInt(f[i], desc);
-			}
+			madvise(mmapped, size, MADV_SEQUENTIAL);
+			processInts((const int*) mmapped, size / sizeof(int), desc);
 		} else {
 			char* f = (char*) mmapped;
 			for (long i = 0; i < size; i++) {
@@ -137,9 +143,7 @@ bool SatReader::parseInternally(JobDescription& desc) {
 				int numRead = ::read(_namedpipe, buffer, sizeof(buffer));
 				if (numRead <= 0) break;
 				numRead /= sizeof(int);
-				for (int i = 0; i < numRead; i++) {
-					processInt(buffer[i], desc);
-				}
+				processInts(buffer, numRead, desc);
 				iteration++;
 			}
 		} else {
@@ -158,64 +162,123 @@ bool SatReader::parseInternally(JobDescription& desc) {
 		}
 
 	} else {
-		// Read file over pipe
-		if (_raw_content_mode) {
-			int iteration = 0;
-			int buffer[1024] = {0};
-			while ((iteration ^ 511) != 0 || !Terminator::isTerminating()) {
-				int numRead = ::read(fileno(_pipe), buffer, sizeof(buffer));
-				if (numRead <= 0) break;
-				numRead /= sizeof(int);
-				for (int i = 0; i < numRead; i++) {
-					int c = buffer[i];
-					processInt(c, desc);
-				}
-				iteration++;
+		// Read decompressed content in large blocks
+		std::vector<char> buffer(1<<20);
+		size_t carry = 0; // raw content: bytes of an incomplete integer at the end of the last block
+		while (!Terminator::isTerminating()) {
+			ssize_t numRead = _decompressor->read(buffer.data()+carry, buffer.size()-carry);
+			if (numRead < 0) return false;
+			if (numRead == 0) break;
+			if (_raw_content_mode) {
+				size_t numBytes = carry + numRead;
+				size_t numInts = numBytes / sizeof(int);
+				const int* ints = (const int*) buffer.data();
+				processInts(ints, numInts, desc);
+				carry = numBytes - numInts*sizeof(int);
+				if (carry > 0) memmove(buffer.data(), buffer.data() + numInts*sizeof(int), carry);
+			} else {
+				const char* chars = buffer.data();
+				for (ssize_t i = 0; i < numRead; i++) process(chars[i], desc);
 			}
-		} else {
-			char buffer[4096] = {'\0'};
-			while (!Terminator::isTerminating() && fgets(buffer, sizeof(buffer), _pipe) != nullptr) {
-				size_t pos = 0;
-				while (buffer[pos] != '\0') {
-					int c = buffer[pos++];
-					process(c, desc);
-				}
-			}
-			process(EOF, desc);
 		}
+		if (!_raw_content_mode) process(EOF, desc);
 	}
 	return true;
 }
 
-bool SatReader::read(JobDescription& desc) {
+void SatReader::processInts(const int* data, size_t size, JobDescription& desc) {
+
+	const size_t blockSize = 1<<14;
+	size_t pos = 0;
+	while (_traversing_clauses && !_input_finished && pos < size) {
+		const int* block = data + pos;
+		const size_t n = std::min(blockSize, size - pos);
+		// Reductions without data-dependent branches, so that the compiler
+		// can vectorize them: largest variable, number of clause terminators,
+		// and number of "empty clauses" (a zero right after a zero), the
+		// first of which ends the clauses.
+		unsigned int maxVar = 0;
+		size_t numZeros = 0;
+		size_t numEmptyClauses = (_empty_clause && block[0] == 0);
+		for (size_t i = 0; i < n; i++) {
+			const unsigned int var = block[i] < 0 ? -(unsigned int) block[i] : block[i];
+			maxVar = std::max(maxVar, var);
+			numZeros += (block[i] == 0);
+		}
+		for (size_t i = 1; i < n; i++) {
+			numEmptyClauses += (block[i-1] == 0) & (block[i] == 0);
+		}
+		if (numEmptyClauses > 0) break; // leave this block to the state machine
 
+		desc.addPermanentData(block, n);
+		_max_var = std::max(_max_var, (int) maxVar);
+		_num_read_clauses += numZeros;
+		_empty_clause = block[n-1] == 0;
+		pos += n;
+	}
+	for (; pos < size; pos++) processInt(data[pos], desc);
+}
+
+namespace {
 	const std::string NC_DEFAULT_VAL = "BMMMKKK111";
+}
+
+void SatReader::storeFormulaSize(JobDescription& desc, int nbVars, int nbClauses) {
+	std::vector<std::pair<int, std::string>> fields {
+		{nbClauses, "__NC"},
+		{nbVars, "__NV"}
+	};
+	for (auto [nbRead, dest] : fields) {
+		std::string nbStr = std::to_string(nbRead);
+		assert(nbStr.size() < NC_DEFAULT_VAL.size());
+		while (nbStr.size() < NC_DEFAULT_VAL.size())
+			nbStr += ".";
+		desc.setAppConfigurationEntry(dest, nbStr);
+	}
+}
+
+bool SatReader::read(JobDescription& desc) {
+
 	desc.setAppConfigurationEntry("__NC", NC_DEFAULT_VAL);
 	desc.setAppConfigurationEntry("__NV", NC_DEFAULT_VAL);
 	if (_params.onTheFlyChecking()) {
 		std::string placeholder(32, 'x');
 		desc.setAppConfigurationEntry("__SIG", placeholder.c_str());
 	}
+	if (PortfolioTuner::isEnabled(_params) && !desc.isIncremental()) {
+		PortfolioTuner::reserveConfiguration(desc);
+	}
 	desc.beginInitialization(desc.getRevision());
 
-	if (_params.onTheFlyChecking()) {
+	// Persistent formula cache (not for named pipes, and not for trusted parsing
+	// which needs to sign the formula while reading it)
+	std::unique_ptr<FormulaCache> cache;
+	std::string cacheVariant;
+	const std::string inputFilename = _filename;
+	if (_params.formulaCacheDirectory.isSet() && !_params.onTheFlyChecking()
+			&& !(_filename.size() > 5 && _filename.substr(_filename.size()-5, 5) == ".pipe")) {
+		cache.reset(new FormulaCache(_params.formulaCacheDirectory(), 1048576UL * _params.formulaCacheMaxSize()));
+		bool rawContentMode = desc.getAppConfiguration().map.count("content-mode")
+			&& desc.getAppConfiguration().map.at("content-mode") == "raw";
+		cacheVariant = std::string(rawContentMode ? "raw" : "text") + "\n" + _params.satPreprocessor();
+	}
+
+	float time = Timer::elapsedSeconds();
+	if (cache && cache->load(inputFilename, cacheVariant, desc, _max_var, _num_read_clauses)) {
+		_input_finished = true;
+		LOG(V3_VERB, "Read %s from formula cache in %.3fs\n", inputFilename.c_str(), Timer::elapsedSeconds() - time);
+		cache.reset();
+	} else if (_params.onTheFlyChecking()) {
 		if (!parseWithTrustedParser(desc)) return false;
 	} else {
 		if (!parseInternally(desc)) return false;
 	}
+	if (cache && isValidInput() && !_contains_empty_clause) {
+		cache->store(inputFilename, cacheVariant, desc, _max_var, _num_read_clauses);
+	}
 
 	// Store # variables and # clauses in app config
-	std::vector<std::pair<int, std::string>> fields {
-		{_num_read_clauses, "__NC"},
-		{_max_var, "__NV"}
-	};
-	for (auto [nbRead, dest] : fields) {
-		std::string nbStr = std::to_string(nbRead);
-		assert(nbStr.size() < NC_DEFAULT_VAL.size());
-		while (nbStr.size() < NC_DEFAULT_VAL.size())
-			nbStr += ".";
-		desc.setAppConfigurationEntry(dest, nbStr);
-	}
+	storeFormulaSize(desc, _max_var, _num_read_clauses);
 
 	if (_params.satPreprocessor.isSet()) {
 		std::ofstream ofs(TmpDir::get() + "/preprocessed-header.pipe", std::ofstream::app);
@@ -225,7 +288,7 @@ bool SatReader::read(JobDescription& desc) {
 
 	desc.endInitialization();
 
-	if (_pipe != nullptr) pclose(_pipe);
+	_decompressor.reset();
 	if (_namedpipe != -1) close(_namedpipe);
 
 	if (_contains_empty_clause) {
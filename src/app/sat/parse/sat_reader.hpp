@@ -7,8 +7,10 @@
 #include <stdlib.h>
 #include <string>
 #include <algorithm>
+#include <memory>
 
 #include "data/job_description.hpp"
+#include "decompressing_reader.hpp"
 
 class Parameters;
 
@@ -18,7 +20,7 @@ private:
     const Parameters& _params;
     std::string _filename;
     bool _raw_content_mode;
-    FILE* _pipe {nullptr};
+    std::unique_ptr<DecompressingReader> _decompressor;
 	int _namedpipe {-1};
 
     // Content mode: ASCII
@@ -47,6 +49,15 @@ public:
     bool parseInternally(JobDescription& desc);
     bool parseWithTrustedParser(JobDescription& desc);
 
+    // Writes the formula's number of variables and clauses into the app
+    // configuration, padded to a fixed width (see read()).
+    static void storeFormulaSize(JobDescription& desc, int nbVars, int nbClauses);
+
+    // Processes a block of raw content. Complete clauses are validated by a
+    // branch-free scan and appended in bulk; the remainder (from the block
+    // which contains the end of the formula) goes through processInt.
+    void processInts(const int* data, size_t size, JobDescription& desc);
+
     inline void processInt(int x, JobDescription& desc) {
         
         //std::cout << x << std::endl;
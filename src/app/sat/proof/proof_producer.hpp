@@ -8,6 +8,7 @@
 #include "comm/job_tree_all_reduction.hpp"
 #include "app/sat/proof/merging/proof_merge_file_input.hpp"
 #include "comm/msg_queue/message_subscription.hpp"
+#include "util/tracer.hpp"
 
 class ProofProducer {
 
@@ -51,6 +52,7 @@ public:
         _proof_assembler(new ProofAssembler(_params, setup.jobId, setup.numWorkers, setup.threadsPerWorker, setup.thisWorkerIndex, 
                 setup.finalEpoch, setup.winningInstance, setup.globalStartOfSuccessEpoch)) {
         
+        Tracer::beginAsync("proof", "assembly", _setup.jobId, {"final_epoch", _setup.finalEpoch});
         createNewProofAllReduction();
 
         if (_params.interleaveProofMerging()) {
@@ -70,6 +72,7 @@ public:
             if (_params.interleaveProofMerging()) 
                 _file_merger->setNumOriginalClauses(_proof_assembler->getNumOriginalClauses());
             _file_merger->beginMerge();
+            Tracer::beginAsync("proof_merge", "merge", _setup.jobId);
         } 
         
         if (_file_merger->beganMerging()) {
@@ -80,6 +83,7 @@ public:
                     _reconstruction_time = _setup.jobAgeSinceActivation - _setup.solvingTime;
                     LOG(V2_INFO, "TIMING assembly %.3f\n", _reconstruction_time);
                 }
+                if (!_done_assembling_proof) Tracer::endAsync("proof_merge", "merge", _setup.jobId);
                 _done_assembling_proof = true;
             }
         }
@@ -101,6 +105,7 @@ public:
             _proof_all_reduction->advance();
             if (_proof_all_reduction->hasResult()) {
                 _proof_all_reduction_result = _proof_all_reduction->extractResult();
+                Tracer::endAsync("proof", "clause id exchange", _setup.jobId);
                 LOG(V5_DEBG, "Importing proof-relevant clause IDs\n");
                 _proof_assembler->importClauseIds(
                     (LratClauseId*) _proof_all_reduction_result.data(), 
@@ -117,6 +122,8 @@ public:
                 _file_merger->setNumOriginalClauses(_proof_assembler->getNumOriginalClauses());
             }
             _proof_all_reduction.reset();
+            Tracer::endAsync("proof", "clause id exchange", _setup.jobId);
+            Tracer::endAsync("proof", "assembly", _setup.jobId);
         }
     }
 
@@ -176,6 +183,7 @@ private:
 
     void createNewProofAllReduction() {
         assert(!_proof_all_reduction.has_value());
+        Tracer::beginAsync("proof", "clause id exchange", _setup.jobId, {"epoch", _proof_assembler->getEpoch()});
         JobMessage baseMsg(_setup.jobId, 0, _setup.revision, 
             _proof_assembler->getEpoch(), MSG_ALLREDUCE_PROOF_RELEVANT_CLAUSES);
 
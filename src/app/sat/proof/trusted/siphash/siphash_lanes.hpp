@@ -0,0 +1,117 @@
+#pragma once
+
+#include <stdlib.h> // size_t
+
+// Computes the 128-bit SipHash-2-4 digests of up to LANES independent messages
+// in lockstep. The state of each lane is kept in a structure of arrays and each
+// SipHash round is applied to all lanes at once, which exposes the independent
+// work to instruction-level parallelism and to auto-vectorization.
+// Lanes whose message is exhausted are masked out of the remaining compression
+// rounds. The digests are identical to those of the sequential SipHash class.
+template <int LANES = 4>
+class SipHashLanes {
+
+typedef unsigned long u64;
+typedef unsigned char u8;
+
+private:
+    u64 k0;
+    u64 k1;
+
+    u64 v0[LANES];
+    u64 v1[LANES];
+    u64 v2[LANES];
+    u64 v3[LANES];
+
+public:
+    static constexpr int NB_LANES = LANES;
+
+    SipHashLanes(const unsigned char* key_128bit) :
+        k0(load64(key_128bit)), k1(load64(key_128bit + 8)) {}
+
+    // Writes the 16-byte digest of each message msgs[l] of lens[l] bytes
+    // to outs[l], for each l < nbMsgs <= LANES.
+    void digest(int nbMsgs, const u8* const* msgs, const size_t* lens, u8* const* outs) {
+
+        size_t nbBlocks[LANES];
+        size_t maxNbBlocks = 0;
+        for (int l = 0; l < LANES; l++) {
+            v0[l] = 0x736f6d6570736575UL ^ k0;
+            v1[l] = 0x646f72616e646f6dUL ^ k1 ^ 0xee;
+            v2[l] = 0x6c7967656e657261UL ^ k0;
+            v3[l] = 0x7465646279746573UL ^ k1;
+            nbBlocks[l] = l < nbMsgs ? lens[l] / 8 : 0;
+            if (nbBlocks[l] > maxNbBlocks) maxNbBlocks = nbBlocks[l];
+        }
+
+        // Full 8-byte blocks
+        u64 m[LANES];
+        u64 active[LANES];
+        for (size_t b = 0; b < maxNbBlocks; b++) {
+            for (int l = 0; l < LANES; l++) {
+                active[l] = b < nbBlocks[l] ? ~0UL : 0UL;
+                m[l] = b < nbBlocks[l] ? load64(msgs[l] + 8*b) : 0UL;
+            }
+            compress(m, active);
+        }
+
+        // Final block: residual bytes and message length
+        for (int l = 0; l < LANES; l++) {
+            active[l] = ~0UL;
+            m[l] = 0;
+            if (l >= nbMsgs) continue;
+            const u8* tail = msgs[l] + 8*nbBlocks[l];
+            const int left = lens[l] & 7;
+            m[l] = ((u64) lens[l]) << 56;
+            for (int i = 0; i < left; i++) m[l] |= ((u64) tail[i]) << (8*i);
+        }
+        compress(m, active);
+
+        // Finalization
+        for (int l = 0; l < LANES; l++) v2[l] ^= 0xee;
+        for (int r = 0; r < 4; r++) round();
+        for (int l = 0; l < nbMsgs; l++) store64(outs[l], v0[l] ^ v1[l] ^ v2[l] ^ v3[l]);
+        for (int l = 0; l < LANES; l++) v1[l] ^= 0xdd;
+        for (int r = 0; r < 4; r++) round();
+        for (int l = 0; l < nbMsgs; l++) store64(outs[l] + 8, v0[l] ^ v1[l] ^ v2[l] ^ v3[l]);
+    }
+
+private:
+    // Two SipHash rounds on the message words m; lanes with active[l] == 0 keep their state.
+    inline void compress(const u64* m, const u64* active) {
+        u64 s0[LANES], s1[LANES], s2[LANES], s3[LANES];
+        for (int l = 0; l < LANES; l++) {
+            s0[l] = v0[l]; s1[l] = v1[l]; s2[l] = v2[l]; s3[l] = v3[l];
+            v3[l] ^= m[l];
+        }
+        round();
+        round();
+        for (int l = 0; l < LANES; l++) {
+            v0[l] ^= m[l];
+            v0[l] = (v0[l] & active[l]) | (s0[l] & ~active[l]);
+            v1[l] = (v1[l] & active[l]) | (s1[l] & ~active[l]);
+            v2[l] = (v2[l] & active[l]) | (s2[l] & ~active[l]);
+            v3[l] = (v3[l] & active[l]) | (s3[l] & ~active[l]);
+        }
+    }
+
+    inline void round() {
+        for (int l = 0; l < LANES; l++) {
+            v0[l] += v1[l]; v1[l] = rotl(v1[l], 13); v1[l] ^= v0[l]; v0[l] = rotl(v0[l], 32);
+            v2[l] += v3[l]; v3[l] = rotl(v3[l], 16); v3[l] ^= v2[l];
+            v0[l] += v3[l]; v3[l] = rotl(v3[l], 21); v3[l] ^= v0[l];
+            v2[l] += v1[l]; v1[l] = rotl(v1[l], 17); v1[l] ^= v2[l]; v2[l] = rotl(v2[l], 32);
+        }
+    }
+
+    static inline u64 rotl(u64 x, int b) {
+        return (x << b) | (x >> (64 - b));
+    }
+    static inline u64 load64(const u8* p) {
+        return ((u64)p[0]) | ((u64)p[1] << 8) | ((u64)p[2] << 16) | ((u64)p[3] << 24)
+            | ((u64)p[4] << 32) | ((u64)p[5] << 40) | ((u64)p[6] << 48) | ((u64)p[7] << 56);
+    }
+    static inline void store64(u8* p, u64 v) {
+        for (int i = 0; i < 8; i++) p[i] = (u8) (v >> (8*i));
+    }
+};
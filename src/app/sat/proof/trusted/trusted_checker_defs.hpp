@@ -25,6 +25,12 @@
 // OUT: OK
 #define TRUSTED_CHK_CLS_IMPORT 'i'
 
+// Import a batch of clauses from other solvers.
+// IN: #clauses k (int) <= TRUSTED_CHK_MAX_IMPORT_BATCH; k times: 64-bit ID;
+//     #lits (int); lits; 128-bit signature.
+// OUT: k times OK
+#define TRUSTED_CHK_CLS_IMPORT_BATCH 'I'
+
 // Delete a sequence of clauses.
 // IN: total size (#ints) k; 64-bit IDs.
 // OUT: OK
@@ -43,3 +49,4 @@
 #define TRUSTED_CHK_RES_ERROR 'E'
 
 #define TRUSTED_CHK_MAX_BUF_SIZE (1<<14)
+#define TRUSTED_CHK_MAX_IMPORT_BATCH 256
@@ -32,6 +32,11 @@ private:
     size_t _bufcap_hints {TRUSTED_CHK_MAX_BUF_SIZE};
     unsigned long* _buf_hints;
     unsigned long _buflen_hints {0};
+    u64 _batch_ids[TRUSTED_CHK_MAX_IMPORT_BATCH];
+    int _batch_nb_lits[TRUSTED_CHK_MAX_IMPORT_BATCH];
+    const int* _batch_lits[TRUSTED_CHK_MAX_IMPORT_BATCH];
+    u8 _batch_sigs[TRUSTED_CHK_MAX_IMPORT_BATCH * SIG_SIZE_BYTES];
+    bool _batch_results[TRUSTED_CHK_MAX_IMPORT_BATCH];
 
     Printer _printer;
 
@@ -115,6 +120,30 @@ public:
                 say(res);
                 nbImported++;
 
+            } else if (c == TRUSTED_CHK_CLS_IMPORT_BATCH) {
+
+                // parse
+                const int nbClauses = TrustedUtils::readInt(_input);
+                TrustedUtils::doAssert(nbClauses >= 0 && nbClauses <= TRUSTED_CHK_MAX_IMPORT_BATCH);
+                _buflen_lits = 0;
+                int litOffsets[TRUSTED_CHK_MAX_IMPORT_BATCH];
+                for (int i = 0; i < nbClauses; i++) {
+                    _batch_ids[i] = readId();
+                    _batch_nb_lits[i] = TrustedUtils::readInt(_input);
+                    litOffsets[i] = _buflen_lits;
+                    readLiterals(_batch_nb_lits[i], true);
+                    TrustedUtils::readSignature(_batch_sigs + i*SIG_SIZE_BYTES, _input);
+                    _printer.printImportDirective(_batch_ids[i], _buf_lits + litOffsets[i],
+                        _batch_nb_lits[i], _batch_sigs + i*SIG_SIZE_BYTES);
+                }
+                // literal buffer is final now
+                for (int i = 0; i < nbClauses; i++) _batch_lits[i] = _buf_lits + litOffsets[i];
+                // forward to checker
+                _ts->importClauses(nbClauses, _batch_ids, _batch_lits, _batch_nb_lits, _batch_sigs, _batch_results);
+                // respond
+                for (int i = 0; i < nbClauses; i++) say(_batch_results[i]);
+                nbImported += nbClauses;
+
             } else if (c == TRUSTED_CHK_CLS_DELETE) {
                 
                 // parse
@@ -187,9 +216,9 @@ private:
         return TrustedUtils::readUnsignedLong(_input);
     }
 
-    inline void readLiterals(int nbLits) {
+    inline void readLiterals(int nbLits, bool append = false) {
         // parse clause
-        _buflen_lits = 0;
+        if (!append) _buflen_lits = 0;
         for (int i = 0; i < nbLits; i++) {
             const int lit = TrustedUtils::readInt(_input);
             if (MALLOB_UNLIKELY(_buflen_lits >= _bufcap_lits)) {
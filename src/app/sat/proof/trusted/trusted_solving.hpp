@@ -3,6 +3,7 @@
 
 #include "lrat_checker.hpp"
 #include "siphash/siphash.hpp"
+#include "siphash/siphash_lanes.hpp"
 #include "trusted_utils.hpp"
 #include "secret.hpp"
 
@@ -16,6 +17,13 @@ private:
     signature _formula_signature;
     LratChecker _checker;
     SipHash _siphash;
+    SipHashLanes<4> _siphash_lanes;
+
+    // Buffering for batched signature computation.
+    u8* _lane_msgs[SipHashLanes<4>::NB_LANES];
+    size_t _lane_msg_caps[SipHashLanes<4>::NB_LANES];
+    u8* _batch_sigs {nullptr};
+    int _batch_sigs_cap {0};
 
     bool _valid {true};
     char _errmsg[512] = {0};
@@ -23,7 +31,17 @@ private:
 public:
     TrustedSolving(int nbVars) :
         _checker(nbVars, Secret::SECRET_KEY),
-        _siphash(Secret::SECRET_KEY) {}
+        _siphash(Secret::SECRET_KEY),
+        _siphash_lanes(Secret::SECRET_KEY) {
+        for (int l = 0; l < SipHashLanes<4>::NB_LANES; l++) {
+            _lane_msg_caps[l] = 256;
+            _lane_msgs[l] = (u8*) malloc(_lane_msg_caps[l]);
+        }
+    }
+    ~TrustedSolving() {
+        for (int l = 0; l < SipHashLanes<4>::NB_LANES; l++) free(_lane_msgs[l]);
+        free(_batch_sigs);
+    }
 
     void init(const u8* formulaSignature) {
         // Store formula signature to validate later after loading
@@ -74,6 +92,33 @@ public:
         return _valid;
     }
 
+    // Batched variant of importClause: the signatures of all clauses are verified
+    // via the multi-lane SipHash before the clauses are forwarded to the checker
+    // in their given order. Writes the result for each clause to outResults.
+    inline bool importClauses(int nbClauses, const u64* ids, const int* const* literals,
+        const int* nbLiterals, const u8* signatureData, bool* outResults) {
+
+        if (nbClauses > _batch_sigs_cap) {
+            _batch_sigs_cap = nbClauses;
+            _batch_sigs = (u8*) realloc(_batch_sigs, _batch_sigs_cap * SIG_SIZE_BYTES);
+        }
+        computeClauseSignatures(nbClauses, ids, literals, nbLiterals, _batch_sigs);
+
+        bool allOk = true;
+        for (int i = 0; i < nbClauses; i++) {
+            if (!TrustedUtils::equalSignatures(signatureData + i*SIG_SIZE_BYTES, _batch_sigs + i*SIG_SIZE_BYTES)) {
+                _valid = false;
+                snprintf(_errmsg, 512, "Signature check of clause %lu failed", ids[i]);
+                outResults[i] = false;
+            } else {
+                _valid &= _checker.addAxiomaticClause(ids[i], literals[i], nbLiterals[i]);
+                outResults[i] = _valid;
+            }
+            allOk &= outResults[i];
+        }
+        return allOk;
+    }
+
     inline bool deleteClauses(const unsigned long* ids, int nbIds) {
         return _checker.deleteClause(ids, nbIds);
     }
@@ -98,6 +143,34 @@ public:
         TrustedUtils::copyBytes(out, hashOut, SIG_SIZE_BYTES);
     }
 
+    // Batched variant of computeClauseSignature: computes the signatures of
+    // several clauses in lockstep and writes them consecutively to out.
+    inline void computeClauseSignatures(int nbClauses, const u64* ids, const int* const* lits,
+        const int* nbLits, u8* out) {
+
+        constexpr int LANES = SipHashLanes<4>::NB_LANES;
+        size_t lens[LANES];
+        u8* outs[LANES];
+        for (int begin = 0; begin < nbClauses; begin += LANES) {
+            const int nbMsgs = nbClauses-begin < LANES ? nbClauses-begin : LANES;
+            for (int l = 0; l < nbMsgs; l++) {
+                const int c = begin + l;
+                // Same message as in computeClauseSignature: ID, literals, formula signature
+                lens[l] = sizeof(u64) + nbLits[c]*sizeof(int) + SIG_SIZE_BYTES;
+                if (lens[l] > _lane_msg_caps[l]) {
+                    while (lens[l] > _lane_msg_caps[l]) _lane_msg_caps[l] *= 2;
+                    _lane_msgs[l] = (u8*) realloc(_lane_msgs[l], _lane_msg_caps[l]);
+                }
+                u8* msg = _lane_msgs[l];
+                TrustedUtils::copyBytes(msg, (const u8*) (ids+c), sizeof(u64));
+                TrustedUtils::copyBytes(msg + sizeof(u64), (const u8*) lits[c], nbLits[c]*sizeof(int));
+                TrustedUtils::copyBytes(msg + sizeof(u64) + nbLits[c]*sizeof(int), _formula_signature, SIG_SIZE_BYTES);
+                outs[l] = out + c*SIG_SIZE_BYTES;
+            }
+            _siphash_lanes.digest(nbMsgs, _lane_msgs, lens, outs);
+        }
+    }
+
     inline void computeSignature(const u8* data, int size, u8* out) {
         u8* sipout = _siphash.reset()
             .update(data, size)
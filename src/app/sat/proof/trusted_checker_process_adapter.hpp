@@ -8,6 +8,7 @@
 #include <stdlib.h>
 #include <unistd.h>
 #include <signal.h>
+#include <vector>
 
 #include "app/sat/proof/lrat_op.hpp"
 #include "trusted/trusted_utils.hpp"
@@ -47,14 +48,22 @@ private:
     int _buflen_lits {0};
     SPSCBlockingRingbuffer<LratOp> _op_queue;
 
+    // batching of imported clauses
+    const bool _batch_imports;
+    int _batch_size {0};
+    std::vector<unsigned long> _batch_ids;
+    std::vector<int> _batch_lits;
+    std::vector<int> _batch_lit_offsets;
+    std::vector<uint8_t> _batch_sigs;
+
     bool _error_reported {false};
     bool _model_set {false};
     std::vector<int> _model;
     Mutex _mtx_model;
 
 public:
-    TrustedCheckerProcessAdapter(Logger& logger, int solverId, int nbVars, bool checkModel, int maxNumSolvers, int globalSolverId, bool plratProofOutput, std::string& proofDir) :
-            _logger(logger), _solver_id(solverId), _nb_vars(nbVars), _op_queue(1<<14),
+    TrustedCheckerProcessAdapter(Logger& logger, int solverId, int nbVars, bool checkModel, int maxNumSolvers, int globalSolverId, bool plratProofOutput, std::string& proofDir, bool batchImports = false) :
+            _logger(logger), _solver_id(solverId), _nb_vars(nbVars), _op_queue(1<<14), _batch_imports(batchImports),
             _check_model(checkModel), _max_num_solvers(maxNumSolvers), _global_solver_id(globalSolverId), _otfc_external_id(plratProofOutput),  _proof_directory(proofDir) {}
 
     ~TrustedCheckerProcessAdapter() {
@@ -127,7 +136,10 @@ public:
 
     inline void submit(LratOp& op) {
         auto type = op.getType();
-        if (type == LratOp::DERIVATION) submitProduceClause(op.getId(), op.getLits(), op.getNbLits(), op.getHints(), op.getNbHints(), op.getGlue() > 0);
+        // Pending batched imports must precede any other directive
+        if (_batch_size > 0 && type != LratOp::IMPORT) flushImportBatch();
+        if (type == LratOp::IMPORT && _batch_imports) appendToImportBatch(op.getId(), op.getLits(), op.getNbLits(), op.getSignature());
+        else if (type == LratOp::DERIVATION) submitProduceClause(op.getId(), op.getLits(), op.getNbLits(), op.getHints(), op.getNbHints(), op.getGlue() > 0);
         else if (type == LratOp::IMPORT) submitImportClause(op.getId(), op.getLits(), op.getNbLits(), op.getSignature());
         else if (type == LratOp::DELETION) submitDeleteClauses(op.getHints(), op.getNbHints());
         else if (type == LratOp::VALIDATION_UNSAT) submitValidateUnsat();
@@ -210,6 +222,35 @@ private:
         TrustedUtils::writeInts(literals, nbLiterals, _f_directives);
         TrustedUtils::writeSignature(signatureData, _f_directives);
     }
+    inline void appendToImportBatch(unsigned long id, const int* literals, int nbLiterals,
+        const uint8_t* signatureData) {
+
+        _batch_ids.push_back(id);
+        _batch_lit_offsets.push_back(_batch_lits.size());
+        _batch_lits.insert(_batch_lits.end(), literals, literals+nbLiterals);
+        _batch_sigs.insert(_batch_sigs.end(), signatureData, signatureData+SIG_SIZE_BYTES);
+        _batch_size++;
+        if (_batch_size == TRUSTED_CHK_MAX_IMPORT_BATCH) flushImportBatch();
+    }
+    void flushImportBatch() {
+        // The checker responds to each clause of the batch individually,
+        // so acceptImportClause() is used for each of them as usual.
+        _batch_lit_offsets.push_back(_batch_lits.size());
+        writeDirectiveType(TRUSTED_CHK_CLS_IMPORT_BATCH);
+        TrustedUtils::writeInt(_batch_size, _f_directives);
+        for (int i = 0; i < _batch_size; i++) {
+            TrustedUtils::writeUnsignedLong(_batch_ids[i], _f_directives);
+            const int nbLits = _batch_lit_offsets[i+1] - _batch_lit_offsets[i];
+            TrustedUtils::writeInt(nbLits, _f_directives);
+            TrustedUtils::writeInts(_batch_lits.data() + _batch_lit_offsets[i], nbLits, _f_directives);
+            TrustedUtils::writeSignature(_batch_sigs.data() + i*SIG_SIZE_BYTES, _f_directives);
+        }
+        _batch_ids.clear();
+        _batch_lits.clear();
+        _batch_lit_offsets.clear();
+        _batch_sigs.clear();
+        _batch_size = 0;
+    }
     inline bool acceptImportClause() {
         if (!awaitResponse()) {
             handleError("Imported clause not accepted");
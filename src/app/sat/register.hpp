@@ -4,7 +4,10 @@
 #include "app/app_message_subscription.hpp"
 #include "app/app_registry.hpp"
 #include "job/forked_sat_job.hpp"
+#include "parse/cnf_preprocessor.hpp"
+#include "parse/portfolio_tuner.hpp"
 #include "parse/sat_reader.hpp"
+#include "solvers/quick_cdcl_solver.hpp"
 
 void register_mallob_app_sat() {
     app_registry::registerApplication("SAT",
@@ -38,6 +41,37 @@ void register_mallob_app_sat() {
                 }
             }
             return json;
+        },
+        // Job quick solver
+        [](const Parameters& params, const JobDescription& desc, JobResult& result) {
+            QuickCdclSolver solver(desc.getFormulaPayload(0), desc.getFormulaPayloadSize(0));
+            result.result = solver.solve(params.quickSolveConflicts(), params.quickSolveTime());
+            if (result.result == RESULT_SAT) result.setSolution(solver.getModel());
+            return result.result != 0;
+        },
+        // Job preprocessor
+        [](const Parameters& params, JobDescription& desc) {
+            if (params.proofOutputFile.isSet() || params.onTheFlyChecking())
+                return app_registry::JobSolutionReconstructor();
+            app_registry::JobSolutionReconstructor reconstructor;
+            if (params.clientPreprocessing()) {
+                auto reconstruction = CnfPreprocessor::preprocess(params, desc);
+                reconstructor = [reconstruction](JobResult& result) {
+                    if (result.result != RESULT_SAT) return;
+                    result.setSolution(reconstruction->reconstructModel(result.extractSolution()));
+                };
+            }
+            return reconstructor;
+        },
+        // Job tuner: runs after preprocessing, so the portfolio is tuned to
+        // the formula which the solvers will actually see
+        [](const Parameters& params, JobDescription& desc) {
+            if (params.proofOutputFile.isSet() || params.onTheFlyChecking()) return;
+            if (PortfolioTuner::isEnabled(params)) PortfolioTuner::get(params).tune(desc);
+        },
+        // Job result observer
+        [](const Parameters& params, JobDescription& desc, const JobResult& result) {
+            if (PortfolioTuner::isEnabled(params)) PortfolioTuner::get(params).record(params, desc, result);
         }
     );
 }
@@ -3,11 +3,32 @@
 set(SAT_SUBPROC_SOURCES src/app/sat/execution/engine.cpp src/app/sat/execution/solver_thread.cpp src/app/sat/execution/solving_state.cpp src/app/sat/job/sat_process_config.cpp src/app/sat/sharing/buffer/buffer_merger.cpp src/app/sat/sharing/buffer/buffer_reader.cpp src/app/sat/sharing/filter/clause_buffer_lbd_scrambler.cpp src/app/sat/sharing/sharing_manager.cpp src/app/sat/solvers/cadical.cpp src/app/sat/solvers/kissat.cpp src/app/sat/solvers/lingeling.cpp src/app/sat/solvers/portfolio_solver_interface.cpp src/app/sat/data/clause_metadata.cpp src/app/sat/proof/lrat_utils.cpp CACHE INTERNAL "")
 
 # Add SAT-specific sources to main Mallob executable
-set(SAT_MALLOB_SOURCES src/app/sat/parse/sat_reader.cpp src/app/sat/execution/solving_state.cpp src/app/sat/job/anytime_sat_clause_communicator.cpp src/app/sat/job/forked_sat_job.cpp src/app/sat/job/sat_process_adapter.cpp src/app/sat/job/sat_process_config.cpp src/app/sat/job/historic_clause_storage.cpp src/app/sat/sharing/buffer/buffer_merger.cpp src/app/sat/sharing/buffer/buffer_reader.cpp src/app/sat/sharing/filter/clause_buffer_lbd_scrambler.cpp src/app/sat/data/clause_metadata.cpp src/app/sat/proof/lrat_utils.cpp)
+set(SAT_MALLOB_SOURCES src/app/sat/parse/sat_reader.cpp src/app/sat/parse/decompressing_reader.cpp src/app/sat/parse/formula_cache.cpp src/app/sat/parse/cnf_preprocessor.cpp src/app/sat/parse/portfolio_tuner.cpp src/app/sat/execution/solving_state.cpp src/app/sat/job/anytime_sat_clause_communicator.cpp src/app/sat/job/forked_sat_job.cpp src/app/sat/job/sat_process_adapter.cpp src/app/sat/job/sat_process_config.cpp src/app/sat/job/historic_clause_storage.cpp src/app/sat/sharing/buffer/buffer_merger.cpp src/app/sat/sharing/buffer/buffer_reader.cpp src/app/sat/sharing/filter/clause_buffer_lbd_scrambler.cpp src/app/sat/data/clause_metadata.cpp src/app/sat/proof/lrat_utils.cpp)
 set(BASE_SOURCES ${BASE_SOURCES} ${SAT_MALLOB_SOURCES} CACHE INTERNAL "")
 
 #message("commons+SAT sources: ${BASE_SOURCES}") # Use to debug
 
+# In-process decompression of compressed formulae: gzip (zlib) is always available,
+# other codecs are used if enabled and otherwise delegated to an external process.
+if(NOT DEFINED MALLOB_USE_BZIP2)
+    set(MALLOB_USE_BZIP2 1)
+endif()
+if(NOT DEFINED MALLOB_USE_LZMA)
+    set(MALLOB_USE_LZMA 1)
+endif()
+if(MALLOB_USE_BZIP2)
+    set(BASE_LIBS ${BASE_LIBS} bz2 CACHE INTERNAL "")
+    add_definitions(-DMALLOB_USE_BZIP2)
+endif()
+if(MALLOB_USE_LZMA)
+    set(BASE_LIBS ${BASE_LIBS} lzma CACHE INTERNAL "")
+    add_definitions(-DMALLOB_USE_LZMA)
+endif()
+if(MALLOB_USE_ZSTD)
+    set(BASE_LIBS ${BASE_LIBS} zstd CACHE INTERNAL "")
+    add_definitions(-DMALLOB_USE_ZSTD)
+endif()
+
 # Include default SAT solvers as external libraries (their Mallob-side interfaces are part of SAT_SOURCES)
 link_directories(lib/lingeling lib/yalsat lib/cadical lib/kissat)
 set(BASE_LIBS ${BASE_LIBS} lgl yals cadical kissat CACHE INTERNAL "")
@@ -55,6 +76,22 @@ new_test(lrat_utils)
 new_test(priority_clause_buffer)
 new_test(clause_store_iteration)
 new_test(lrat_checker)
+new_test(siphash_lanes)
 new_test(portfolio_sequence)
+new_test(sparse_filter_vector)
+new_test(clause_snapshot)
+new_test(clause_usefulness)
+new_test(backlog_export_manager)
+new_test(clause_logger)
+new_test(quick_cdcl_solver)
+new_test(formula_cache)
+new_test(cnf_preprocessor)
+new_test(blocked_literals)
+new_test(portfolio_tuner)
 #new_test(formula_separator)
 #new_test(historic_clause_storage)
+
+# Add microbenchmarks
+new_bench(clause_sharing)
+new_bench(formula_parsing)
+new_bench(lrat_checker)
@@ -1,7 +1,10 @@
-
 #pragma once
 
-#include <list>
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <stdlib.h>
+#include <vector>
 
 #include "app/sat/data/clause_metadata.hpp"
 #include "app/sat/data/produced_clause_candidate.hpp"
@@ -10,20 +13,46 @@
 #include "app/sat/sharing/store/generic_clause_store.hpp"
 #include "app/sat/solvers/portfolio_solver_interface.hpp"
 #include "util/logger.hpp"
-#include "util/sys/threading.hpp"
+#include "util/ringbuf/ringbuf.h"
 #include "../data/solver_statistics.hpp"
 #include "util/sys/timer.hpp"
 
 class BacklogExportManager : public GenericExportManager {
 
 private:
+    // Per clause length, the backlog is a bounded lock-free MPSC ring (one producer
+    // per solver) of fixed-size clause records: [lbd] [producer ID] [epoch] [literals].
+    // It is drained by whichever solver thread currently holds the filter lock
+    // for this clause length.
+    static constexpr int RECORD_HEADER_SIZE = 3;
+    static constexpr size_t BACKLOG_CAPACITY_INTS = 1<<16;
+
     struct Slot {
         int clauseLength;
-        Mutex mtxBacklog;
-        std::list<ProducedClauseCandidate> backlog;
-        float lastBacklogWarn {0};
-
-        Slot(GenericClauseStore& pcb, int clauseLength) : clauseLength(clauseLength) {}
+        int recordSize;
+        ringbuf_t* ringbuf;
+        std::vector<ringbuf_worker_t*> producers;
+        std::vector<int> data;
+        std::atomic_flag draining = ATOMIC_FLAG_INIT;
+        std::atomic_int numBacklogged {0};
+        std::atomic_int maxNumBacklogged {0};
+        std::atomic_ulong numDropped {0};
+        std::atomic<float> lastBacklogWarn {0};
+
+        Slot(int clauseLength, int numProducers) : clauseLength(clauseLength),
+                recordSize(RECORD_HEADER_SIZE + clauseLength) {
+            // Capacity: a multiple of the record size
+            size_t capacity = std::max(16UL, BACKLOG_CAPACITY_INTS / recordSize) * recordSize;
+            size_t ringbufSize;
+            ringbuf_get_sizes(numProducers, &ringbufSize, nullptr);
+            ringbuf = (ringbuf_t*) malloc(ringbufSize);
+            ringbuf_setup(ringbuf, numProducers, capacity);
+            for (int i = 0; i < numProducers; i++) producers.push_back(ringbuf_register(ringbuf, i));
+            data.resize(capacity);
+        }
+        ~Slot() {
+            free(ringbuf);
+        }
     };
 
     std::vector<std::unique_ptr<Slot>> _slots;
@@ -36,71 +65,111 @@ public:
 
         _slots.resize(maxEffClauseLength);
         for (size_t i = 0; i < _slots.size(); i++)
-            _slots[i].reset(new Slot(pcb, i+1));
+            _slots[i].reset(new Slot(i+1, std::max(1UL, solvers.size())));
     }
     virtual ~BacklogExportManager() {}
 
     void produce(int* begin, int size, int lbd, int producerId, int epoch) override {
 
-        ProducedClauseCandidate pcc(begin, size, lbd, producerId, epoch);
-
         if (size > _clause_store.getMaxAdmissibleEffectiveClauseLength()) {
             handleResult(producerId, GenericClauseFilter::DROPPED, size);
             return;
         }
 
         auto& slot = getSlot(size);
-        auto& mtxBacklog = slot.mtxBacklog;
-        auto& backlog = slot.backlog;
 
         // Can I expect to quickly obtain the map's internal locks?
         if (_filter.tryAcquireLock(size)) {
             // -- yes!
 
             // Insert clause directly
+            ProducedClauseCandidate pcc(begin, size, lbd, producerId, epoch);
             processClause(pcc, true);
 
             // Reduce backlog size
-            std::list<ProducedClauseCandidate> extracted;
-            size_t backlogSize;
-            bool warnSize = false;
-            {
-                auto lock = mtxBacklog.getLock();
-                auto endIt = backlog.begin();
-                std::advance(endIt, std::min(32UL, backlog.size()));
-                extracted.splice(extracted.end(), backlog, backlog.begin(), endIt);
-                backlogSize = backlog.size();
-                if (backlogSize >= (1<<16)) {
-                    auto time = Timer::elapsedSeconds();
-                    if (time - slot.lastBacklogWarn >= 1.0) {
-                        warnSize = true;
-                        slot.lastBacklogWarn = time;
-                    }
-                }
-            }
-            while (!extracted.empty()) {
-                processClause(extracted.front());
-                extracted.pop_front();
-            }
+            drainBacklog(slot, 32);
 
             _filter.releaseLock(size);
 
-            // Print a warning periodically if the backlog is very large
-            if (warnSize && _solvers[producerId]) {
-                LOGGER(_solvers[producerId]->getLogger(), V1_WARN, "[WARN] Export backlog for clauses of len %i had size %lu\n",
-                    size, backlogSize);
+            // Print a warning periodically if the backlog is (nearly) full
+            int backlogSize = slot.numBacklogged.load(std::memory_order_relaxed);
+            if (backlogSize >= 0.9 * (slot.data.size() / slot.recordSize) && _solvers[producerId]) {
+                auto time = Timer::elapsedSeconds();
+                if (time - slot.lastBacklogWarn.load(std::memory_order_relaxed) >= 1.0) {
+                    slot.lastBacklogWarn.store(time, std::memory_order_relaxed);
+                    LOGGER(_solvers[producerId]->getLogger(), V1_WARN, "[WARN] Export backlog for clauses of len %i had size %i (%lu dropped)\n",
+                        size, backlogSize, slot.numDropped.load(std::memory_order_relaxed));
+                }
             }
 
         } else {
             // -- no: Insert into backlog
-            auto lock = mtxBacklog.getLock();
-            backlog.push_back(std::move(pcc));
+            assert(producerId < slot.producers.size());
+            ssize_t offset = ringbuf_acquire(slot.ringbuf, slot.producers[producerId], slot.recordSize);
+            if (offset == -1) {
+                // Backlog is full: drop clause
+                slot.numDropped.fetch_add(1, std::memory_order_relaxed);
+                handleResult(producerId, GenericClauseFilter::DROPPED, size);
+                return;
+            }
+            int* record = slot.data.data() + offset;
+            record[0] = lbd;
+            record[1] = producerId;
+            record[2] = epoch;
+            memcpy(record + RECORD_HEADER_SIZE, begin, size * sizeof(int));
+            ringbuf_produce(slot.ringbuf, slot.producers[producerId]);
+            int backlogSize = 1 + slot.numBacklogged.fetch_add(1, std::memory_order_relaxed);
+            int maxBacklogSize = slot.maxNumBacklogged.load(std::memory_order_relaxed);
+            while (backlogSize > maxBacklogSize && !slot.maxNumBacklogged.compare_exchange_weak(
+                maxBacklogSize, backlogSize, std::memory_order_relaxed)) {}
         }
     }
 
+    size_t getNumBackloggedClauses() const override {
+        size_t sum = 0;
+        for (auto& slot : _slots) sum += std::max(0, slot->numBacklogged.load(std::memory_order_relaxed));
+        return sum;
+    }
+    size_t getMaxNumBackloggedClauses() const override {
+        size_t sum = 0;
+        for (auto& slot : _slots) sum += slot->maxNumBacklogged.load(std::memory_order_relaxed);
+        return sum;
+    }
+    unsigned long getNumDroppedFromBacklog() const override {
+        unsigned long sum = 0;
+        for (auto& slot : _slots) sum += slot->numDropped.load(std::memory_order_relaxed);
+        return sum;
+    }
+
 private:
     Slot& getSlot(int effClauseLength) {return *_slots.at(effClauseLength-1);}
 
+    // Processes up to the given number of backlogged clauses of this slot.
+    // Must be called while holding the filter lock for this clause length.
+    void drainBacklog(Slot& slot, int maxNbClauses) {
+        // The ring has a single consumer: skip if another thread is draining already
+        // (possible with filters which do not lock)
+        if (slot.draining.test_and_set(std::memory_order_acquire)) return;
+        int nbDrained = 0;
+        while (nbDrained < maxNbClauses) {
+            size_t offset;
+            size_t len = ringbuf_consume(slot.ringbuf, &offset);
+            if (len == 0) break;
+            assert(len % slot.recordSize == 0);
+            size_t nbRecords = std::min(len / slot.recordSize, (size_t) (maxNbClauses - nbDrained));
+            for (size_t r = 0; r < nbRecords; r++) {
+                int* record = slot.data.data() + offset + r * slot.recordSize;
+                ProducedClauseCandidate pcc(record + RECORD_HEADER_SIZE, slot.clauseLength,
+                    record[0], record[1], record[2]);
+                processClause(pcc);
+            }
+            ringbuf_release(slot.ringbuf, nbRecords * slot.recordSize);
+            slot.numBacklogged.fetch_sub(nbRecords, std::memory_order_relaxed);
+            nbDrained += nbRecords;
+        }
+        slot.draining.clear(std::memory_order_release);
+    }
+
     void processClause(ProducedClauseCandidate& pcc, bool checkedForAdmissibleClauseLength = false) {
         int effClauseLength = pcc.size;
         int producerId = pcc.producerId;
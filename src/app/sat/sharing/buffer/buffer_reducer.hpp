@@ -1,6 +1,9 @@
 
 #pragma once
 
+#include <stdint.h>
+#include <string.h>
+#include <algorithm>
 #include <functional>
 
 #include "../../data/clause.hpp"
@@ -26,6 +29,82 @@ public:
         return reduceTemplated(acceptor);
     }
 
+    // Removes each clause whose bit is set in the provided bit vector (clauses in order of
+    // appearance; bit j of int i corresponds to clause 32i+j; missing bits are unset).
+    // The bit vector is scanned a 64-bit word at a time so that runs of admitted clauses
+    // are moved (or left in place) in bulk.
+    int reduceByFilterBitset(const int* bitset, size_t bitsetSize, int& numClauses, int& numAdmittedClauses) {
+
+        const int numInts = sizeof(size_t)/sizeof(int);
+        if (_size <= numInts) return _size;
+
+        size_t currentPos = numInts+1;
+        size_t currentWritePos = currentPos;
+
+        BufferIterator it(_max_eff_clause_length, _slots_for_sum_of_length_and_lbd);
+
+        int remainingClsOfBucket = _buffer[numInts];
+        int* clsInBucketCounter = &_buffer[numInts];
+        assert(remainingClsOfBucket >= 0);
+
+        size_t clauseIdx = 0;
+        auto getWord = [&](size_t wordIdx) -> uint64_t {
+            size_t i = 2*wordIdx;
+            uint64_t word = i < bitsetSize ? (uint32_t) bitset[i] : 0;
+            if (i+1 < bitsetSize) word |= ((uint64_t) (uint32_t) bitset[i+1]) << 32;
+            return word;
+        };
+
+        while (true) {
+            // Find a non-empty bucket
+            if (remainingClsOfBucket == 0) {
+                do {
+                    if (currentPos >= _size) return currentWritePos;
+                    it.nextLengthLbdGroup();
+                    _buffer[currentWritePos] = _buffer[currentPos];
+                    remainingClsOfBucket = _buffer[currentWritePos];
+                    clsInBucketCounter = &_buffer[currentWritePos];
+                    currentPos++;
+                    currentWritePos++;
+                    assert(remainingClsOfBucket >= 0);
+                } while (remainingClsOfBucket == 0);
+            }
+
+            const size_t clauseLength = it.clauseLength;
+            // Number of clauses which still fit into the buffer
+            const size_t numFitting = (_size - currentPos) / clauseLength;
+            if (numFitting == 0) return currentWritePos;
+
+            // Length of the run of admitted clauses beginning at the current clause
+            uint64_t word = getWord(clauseIdx / 64) >> (clauseIdx % 64);
+            size_t runLength = word == 0 ? 64 - (clauseIdx % 64) : __builtin_ctzll(word);
+            runLength = std::min(runLength, std::min((size_t) remainingClsOfBucket, numFitting));
+
+            if (runLength == 0) {
+                // Clause filtered: Only advance read position
+                currentPos += clauseLength;
+                (*clsInBucketCounter)--;
+                remainingClsOfBucket--;
+                clauseIdx++;
+                numClauses++;
+                continue;
+            }
+
+            // Run of admitted clauses: Re-position (if necessary), advance both positions
+            const size_t runSize = runLength * clauseLength;
+            if (currentWritePos != currentPos)
+                memmove(_buffer+currentWritePos, _buffer+currentPos, runSize*sizeof(int));
+            currentPos += runSize;
+            currentWritePos += runSize;
+            remainingClsOfBucket -= runLength;
+            clauseIdx += runLength;
+            numClauses += runLength;
+            numAdmittedClauses += runLength;
+        }
+
+        return currentWritePos;
+    }
+
 private:
     template <typename Func>
     int reduceTemplated(Func acceptor) {
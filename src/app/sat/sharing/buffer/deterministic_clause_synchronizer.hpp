@@ -1,14 +1,24 @@
 
 #pragma once
 
+#include <atomic>
 #include <functional>
-#include <deque>
+#include <vector>
 
 #include "../../data/clause.hpp"
 #include "app/sat/solvers/portfolio_solver_interface.hpp"
 #include "util/logger.hpp"
 #include "util/sys/threading.hpp"
-
+#include "util/sys/timer.hpp"
+
+// Makes the admission of produced clauses into clause sharing reproducible.
+// Each solver appends its produced clauses to its own append-only log, which is
+// only ever written by the solver's (single) producing thread and therefore needs
+// no locking. After a fixed number of insertions (an "epoch boundary"), a solver
+// waits until the next sharing operation has been performed. Once all solvers
+// reached their boundary (or are done), all logs are merged in a deterministic
+// round-robin order (one clause of each solver at a time, in order of solver IDs)
+// and admitted in a single batch before the sharing is prepared.
 class DeterministicClauseSynchronizer {
 
 public:
@@ -23,15 +33,19 @@ public:
 private:
     CbAdmitClause _cb_admit_clause;
     std::vector<std::shared_ptr<PortfolioSolverInterface>>& _solvers;
-    
-    Mutex _mtx_flush;
-    int _num_nonempty_queues {0};
-    struct AdmissionQueue {
-        std::deque<ClauseInsertionCall> queue;
+
+    static constexpr int RECORD_HEADER_SIZE = 4; // revision, cond. var, LBD, size
+    struct SolverLog {
+        std::vector<int> data;
         int numInserted {0};
-        bool waiting {false};
+        // Only written under _mtx_sync, but read without it by the solver's
+        // producing thread to skip the lock on each insertion
+        std::atomic_bool waiting {false};
+        // time statistics
+        float timeOfCreation {0};
+        float timeWaiting {0};
     };
-    std::vector<AdmissionQueue> _admission_queues;
+    std::vector<SolverLog> _logs;
 
     int _nb_insertions_until_sync {10'000};
     int _nb_waiting_for_sync {0};
@@ -39,65 +53,54 @@ private:
     ConditionVariable _cond_var_sync;
 
     int _min_solver_id_with_result {-1};
+    unsigned long _nb_admitted {0};
+    int _nb_syncs {0};
 
 public:
     DeterministicClauseSynchronizer(std::vector<std::shared_ptr<PortfolioSolverInterface>>& solvers,
             size_t numOrigClauses, CbAdmitClause cb) :
-        _cb_admit_clause(cb), _solvers(solvers), _admission_queues(_solvers.size()),
-        _nb_insertions_until_sync(std::floor(0.1*approximateConflictsPerSecond(numOrigClauses))) {}
+        _cb_admit_clause(cb), _solvers(solvers), _logs(_solvers.size()),
+        _nb_insertions_until_sync(std::floor(0.1*approximateConflictsPerSecond(numOrigClauses))) {
+        for (auto& log : _logs) log.timeOfCreation = Timer::elapsedSeconds();
+    }
     ~DeterministicClauseSynchronizer() {
         if (isWaitingForSync()) syncAndCheckForLocalWinner(-1);
+        LOG(V3_VERB, "Det. solving: %i syncs, %lu clauses admitted, non-waiting time share %.3f\n",
+            _nb_syncs, _nb_admitted, getNonWaitingTimeShare());
     }
 
+    // Must be called by the single thread producing clauses for the given solver.
     void insertBlocking(int solverId, int solverRevision, const Mallob::Clause& clause, int condVarOrZero) {
-        
-        waitForSync(solverId);
 
-        {
-            auto lock = _mtx_flush.getLock();
-
-            auto& q = _admission_queues.at(solverId);
-            bool emptyBefore = q.queue.empty();
-            q.queue.push_back(ClauseInsertionCall {solverId, solverRevision, clause.copy(), condVarOrZero});
-            q.numInserted++;
-
-            if (emptyBefore) {
-                _num_nonempty_queues++;
-                while (_num_nonempty_queues == _admission_queues.size()) {
-                    // flush one clause from each queue
-                    int numNonEmptyQueuesAfterFlush = 0;
-                    for (auto& otherQ : _admission_queues) {
-                        assert(!otherQ.queue.empty());
-                        auto call = std::move(otherQ.queue.front());
-                        otherQ.queue.pop_front();
-                        if (!otherQ.queue.empty()) numNonEmptyQueuesAfterFlush++;
-                        _cb_admit_clause(call);
-                    }
-                    _num_nonempty_queues = numNonEmptyQueuesAfterFlush;
-                }
-            }
+        waitForSync(solverId);
 
-            if (q.numInserted % _nb_insertions_until_sync == 0) {
-                // Sync! Sleep until clause exchange has been done.
-                {
-                    auto lock = _mtx_sync.getLock();
-                    assert(!q.waiting);
-                    q.waiting = true;
-                    _nb_waiting_for_sync++;
-                }
-                _cond_var_sync.notify();
+        auto& log = _logs.at(solverId);
+        log.data.push_back(solverRevision);
+        log.data.push_back(condVarOrZero);
+        log.data.push_back(clause.lbd);
+        log.data.push_back(clause.size);
+        log.data.insert(log.data.end(), clause.begin, clause.begin + clause.size);
+        log.numInserted++;
+
+        if (log.numInserted % _nb_insertions_until_sync == 0) {
+            // Epoch boundary: sleep until clause exchange has been done.
+            {
+                auto lock = _mtx_sync.getLock();
+                assert(!log.waiting);
+                log.waiting = true;
+                _nb_waiting_for_sync++;
             }
+            _cond_var_sync.notify();
+            waitForSync(solverId);
         }
-
-        waitForSync(solverId);
     }
 
     void notifySolverDone(int localId) {
         {
             auto lock = _mtx_sync.getLock();
-            auto& q = _admission_queues[localId];
-            if (!q.waiting) {
-                q.waiting = true;
+            auto& log = _logs[localId];
+            if (!log.waiting) {
+                log.waiting = true;
                 _nb_waiting_for_sync++;
                 int globalId = _solvers[localId]->getGlobalId();
                 if (_min_solver_id_with_result == -1 || _min_solver_id_with_result > globalId)
@@ -109,40 +112,78 @@ public:
 
     bool areAllSolversSyncReady() {
         auto lock = _mtx_sync.getLock();
-        return _nb_waiting_for_sync == _admission_queues.size();
+        return _nb_waiting_for_sync == _logs.size();
     }
 
     int waitUntilSyncReadyAndReturnSolverIdWithResult() {
         // Wait until all solvers are waiting for sync
-        _cond_var_sync.wait(_mtx_sync, [&]() {return _nb_waiting_for_sync == _admission_queues.size();});
+        _cond_var_sync.wait(_mtx_sync, [&]() {return _nb_waiting_for_sync == _logs.size();});
         return _min_solver_id_with_result;
     }
 
+    // Admits all logged clauses in a deterministic order and clears the logs.
+    // Must only be called while all solvers are waiting for sync.
+    void admitLoggedClauses() {
+        assert(isWaitingForSync());
+        std::vector<size_t> positions(_logs.size(), 0);
+        bool admittedAny = true;
+        while (admittedAny) {
+            admittedAny = false;
+            for (size_t i = 0; i < _logs.size(); i++) {
+                auto& data = _logs[i].data;
+                size_t& pos = positions[i];
+                if (pos >= data.size()) continue;
+                ClauseInsertionCall call {(int) i, data[pos], Mallob::Clause(data.data()+pos+RECORD_HEADER_SIZE,
+                    data[pos+3], data[pos+2]), data[pos+1]};
+                pos += RECORD_HEADER_SIZE + call.clause.size;
+                _cb_admit_clause(call);
+                _nb_admitted++;
+                admittedAny = true;
+            }
+        }
+        for (auto& log : _logs) log.data.clear();
+    }
+
     bool isWaitingForSync() {
         auto lock = _mtx_sync.getLock();
-        return _nb_waiting_for_sync == _admission_queues.size();
+        return _nb_waiting_for_sync == _logs.size();
     }
 
     bool syncAndCheckForLocalWinner(int globalWinningId) {
         bool hasWinningSolver = false;
         {
             auto lock = _mtx_sync.getLock();
-            assert(_nb_waiting_for_sync == _admission_queues.size());
-            for (int i = 0; i < _admission_queues.size(); ++i) {
-                auto& q = _admission_queues[i];
-                assert(q.waiting);
+            assert(_nb_waiting_for_sync == _logs.size());
+            for (int i = 0; i < _logs.size(); ++i) {
+                auto& log = _logs[i];
+                assert(log.waiting);
                 if (_solvers[i]->getGlobalId() == globalWinningId) {
                     hasWinningSolver = true;
                 }
                 if (globalWinningId >= 0) _solvers[i]->suspend();
-                q.waiting = false;
+                log.waiting = false;
             }
             _nb_waiting_for_sync = 0;
+            _nb_syncs++;
         }
         _cond_var_sync.notify();
         return hasWinningSolver;
     }
 
+    // Average share of time which the solvers did not spend waiting for synchronization,
+    // i.e., 1 minus the waiting fraction. This only approximates the throughput relative to
+    // non-deterministic solving since it ignores the cost of the synchronization itself.
+    float getNonWaitingTimeShare() {
+        auto lock = _mtx_sync.getLock();
+        float time = Timer::elapsedSeconds();
+        float sumRatios = 0;
+        for (auto& log : _logs) {
+            float elapsed = time - log.timeOfCreation;
+            sumRatios += elapsed <= 0 ? 1 : std::max(0.f, 1 - log.timeWaiting / elapsed);
+        }
+        return _logs.empty() ? 1 : sumRatios / _logs.size();
+    }
+
 private:
     double approximateConflictsPerSecond(size_t numOrigClauses) {
 
@@ -160,7 +201,7 @@ private:
 
         const double secsPerConflict = std::min(0.02, 0.001 * kSecsPerConflict);
         const double conflictsPerSec = 1 / secsPerConflict;
-        LOG(V2_INFO, "Det. solving: approximated %ld clauses to result in %.3f conflicts per second\n", 
+        LOG(V2_INFO, "Det. solving: approximated %ld clauses to result in %.3f conflicts per second\n",
             numOrigClauses, conflictsPerSec);
 
         assert(conflictsPerSec >= 50);
@@ -170,10 +211,14 @@ private:
 
 private:
     void waitForSync(int solverId) {
-        bool& waiting = _admission_queues.at(solverId).waiting;
-        if (!waiting) return;
+        auto& log = _logs.at(solverId);
+        // Fast path: not at an epoch boundary
+        if (!log.waiting.load(std::memory_order_acquire)) return;
         LOG(V5_DEBG, "%i : WAIT_FOR_SYNC\n", solverId);
-        _cond_var_sync.wait(_mtx_sync, [&]() {return !waiting;});
+        float time = Timer::elapsedSeconds();
+        _cond_var_sync.wait(_mtx_sync, [&]() {return !log.waiting;});
+        auto lock = _mtx_sync.getLock();
+        log.timeWaiting += Timer::elapsedSeconds() - time;
         LOG(V5_DEBG, "%i : END_WAIT_FOR_SYNC\n", solverId);
     }
 };
@@ -3,26 +3,79 @@
 
 #include "app/sat/data/clause.hpp"
 #include "app/sat/data/clause_metadata.hpp"
+#include "util/ringbuffer.hpp"
 #include "util/sys/background_worker.hpp"
 #include "util/sys/threading.hpp"
+#include <cstdio>
 #include <fstream>
+#include <unistd.h>
 #include <vector>
 
+// Logs the successfully shared clauses of each sharing epoch.
+// TEXT: one line per clause (LBD, [ID], literals), an empty line after each epoch.
+// BINARY: a stream of 32-bit integers (host byte order) which is cheap to write:
+//   file header:  MAGIC VERSION #metadata-ints-per-clause
+//   epoch header: 0 epoch
+//   clause:       size lbd producers lit_1 ... lit_size
+// where size includes the metadata ints (which precede the literals) and
+// producers is the bitset of local solvers which produced the clause.
+// Clauses are handed to a background writer via a large ring buffer.
 class ClauseLogger {
 
+public:
+    enum Format {TEXT, BINARY};
+    static constexpr int BINARY_MAGIC = 0x4d434c47;
+    static constexpr int BINARY_VERSION = 1;
+
 private:
+    const Format _format;
     BackgroundWorker _bg_worker;
+
+    // TEXT
     std::ofstream _ofs;
     Mutex _mtx_parcelled_clauses;
     ConditionVariable _cond_var;
     std::vector<std::vector<int>> _parcelled_clauses;
 
+    // BINARY
+    FILE* _file {nullptr};
+    RingBuffer _ringbuf;
+    int _last_epoch {-1};
+    unsigned long _nb_stalls {0};
+
 public:
-    ClauseLogger(const std::string& outputPath) : _ofs(outputPath) {
-        _bg_worker.run([&]() {run();});
+    ClauseLogger(const std::string& outputPath, Format format = TEXT) :
+            _format(format), _ringbuf(format == BINARY ? 1<<22 : 1) {
+        if (_format == TEXT) {
+            _ofs.open(outputPath);
+            _bg_worker.run([&]() {run();});
+        } else {
+            _file = fopen(outputPath.c_str(), "w");
+            if (!_file) return;
+            setvbuf(_file, nullptr, _IOFBF, 1<<20);
+            const int header[] {BINARY_MAGIC, BINARY_VERSION, ClauseMetadata::numInts()};
+            fwrite(header, sizeof(int), 3, _file);
+            _bg_worker.run([&]() {runBinary();});
+        }
+    }
+    ~ClauseLogger() {
+        _bg_worker.stopWithoutWaiting();
+        _cond_var.notify();
+        _bg_worker.join();
     }
 
-    void append(const Mallob::Clause& clause) {
+    void append(const Mallob::Clause& clause, int epoch = 0, uint32_t producers = 0) {
+        if (_format == BINARY) {
+            if (!_file) return;
+            if (epoch != _last_epoch) {
+                const int epochHeader[] {0, epoch};
+                produceBlocking(epochHeader, 2, nullptr, 0);
+                _last_epoch = epoch;
+            }
+            const int clauseHeader[] {clause.size, clause.lbd, (int) producers};
+            produceBlocking(clauseHeader, 3, clause.begin, clause.size);
+            return;
+        }
         std::vector<int> vec(clause.size+1);
         vec[0] = clause.lbd;
         for (size_t i = 0; i < clause.size; i++) vec[i+1] = clause.begin[i];
@@ -33,6 +86,7 @@ public:
     }
 
     void publish() {
+        if (_format == BINARY) return; // the writer picks up clauses continuously
         {
             auto lock = _mtx_parcelled_clauses.getLock();
             _parcelled_clauses.emplace_back();
@@ -40,6 +94,9 @@ public:
         _cond_var.notify();
     }
 
+    // Number of times an append had to wait for the writer
+    unsigned long getNumStalls() const {return _nb_stalls;}
+
     void run() {
         std::vector<std::vector<int>> outClauses;
         while (true) {
@@ -59,12 +116,103 @@ public:
                 }
                 for (size_t i = 1+ClauseMetadata::numInts(); i < vec.size(); i++)
                     _ofs << " " << vec[i];
-                _ofs << std::endl;
+                _ofs << "\n";
             }
             outClauses.clear();
-            _ofs << std::endl;
+            _ofs << "\n";
             _ofs.flush();
         }
         _ofs.close();
     }
+
+private:
+    void produceBlocking(const int* data1, size_t size1, const int* data2, size_t size2) {
+        while (!_ringbuf.produceInTwoChunks(data1, size1, data2, size2, false)) {
+            // Ring buffer full: wait for the writer
+            _nb_stalls++;
+            usleep(100);
+        }
+    }
+
+    void runBinary() {
+        std::vector<int> chunk;
+        while (true) {
+            bool running = _bg_worker.continueRunning();
+            bool wroteAny = false;
+            while (_ringbuf.consume(chunk)) {
+                fwrite(chunk.data(), sizeof(int), chunk.size(), _file);
+                wroteAny = true;
+            }
+            if (!running) break;
+            if (!wroteAny) usleep(1000);
+        }
+        fclose(_file);
+    }
+};
+
+// Reads a binary clause log (see ClauseLogger) epoch by epoch.
+class ClauseLogReader {
+
+public:
+    struct LoggedClause {
+        int lbd;
+        uint32_t producers;
+        std::vector<int> lits; // including metadata
+    };
+
+private:
+    FILE* _file;
+    bool _valid {false};
+    int _nb_metadata_ints {0};
+    int _next_epoch {-1};
+
+public:
+    ClauseLogReader(const std::string& path) {
+        _file = fopen(path.c_str(), "r");
+        if (!_file) return;
+        int header[3];
+        if (fread(header, sizeof(int), 3, _file) < 3) return;
+        if (header[0] != ClauseLogger::BINARY_MAGIC || header[1] != ClauseLogger::BINARY_VERSION) return;
+        _nb_metadata_ints = header[2];
+        _valid = true;
+        readEpochHeader();
+    }
+    ~ClauseLogReader() {
+        if (_file) fclose(_file);
+    }
+
+    bool valid() const {return _valid;}
+    int getNumMetadataInts() const {return _nb_metadata_ints;}
+
+    // Reads the clauses of the next epoch. Returns false if there is no further epoch.
+    bool readNextEpoch(int& epoch, std::vector<LoggedClause>& clauses) {
+        clauses.clear();
+        if (!_valid || _next_epoch < 0) return false;
+        epoch = _next_epoch;
+        _next_epoch = -1;
+        int header[3];
+        while (fread(header, sizeof(int), 1, _file) == 1) {
+            if (header[0] == 0) {
+                // next epoch begins
+                readEpochValue();
+                break;
+            }
+            if (fread(header+1, sizeof(int), 2, _file) < 2) break;
+            LoggedClause cls {header[1], (uint32_t) header[2], std::vector<int>(header[0])};
+            if (fread(cls.lits.data(), sizeof(int), header[0], _file) < header[0]) break;
+            clauses.push_back(std::move(cls));
+        }
+        return true;
+    }
+
+private:
+    void readEpochHeader() {
+        int zero;
+        if (fread(&zero, sizeof(int), 1, _file) < 1 || zero != 0) return;
+        readEpochValue();
+    }
+    void readEpochValue() {
+        int epoch;
+        if (fread(&epoch, sizeof(int), 1, _file) == 1) _next_epoch = epoch;
+    }
 };
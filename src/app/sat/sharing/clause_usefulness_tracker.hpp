@@ -0,0 +1,138 @@
+
+#pragma once
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "app/sat/data/clause_histogram.hpp"
+
+// Estimates for each (effective) clause length how useful the imported clauses of
+// this length are for the local solvers: the fraction of offered clauses which a
+// solver neither knew already (solver-side filter) nor dropped from its import
+// buffer, multiplied with the fraction of handed clauses which the solver backend
+// actually kept (imported vs. discarded, if the backend exposes these statistics).
+// Estimates are smoothed over sharing epochs. From the estimates, a share of the
+// export budget is derived for each clause length as well as a factor for the
+// overall sharing volume.
+// Clauses are only distinguished by length, not by LBD: the digested clauses are
+// counted per length by the solvers' import paths, and the kept/discarded counts
+// are solver-wide, so an LBD dimension would have nothing to be measured from.
+class ClauseUsefulnessTracker {
+
+private:
+    const int _max_eff_clause_length;
+    const int _max_free_eff_clause_length;
+    const float _min_share;
+    const float _decay {0.8f};
+
+    // per clause length (index = length-1)
+    std::vector<unsigned long> _offered;
+    std::vector<unsigned long> _last_digested;
+    std::vector<float> _usefulness;
+    std::vector<bool> _has_estimate;
+    std::vector<float> _offered_lits_share;
+
+    unsigned long _last_imported {0};
+    unsigned long _last_discarded {0};
+    float _acceptance {1};
+
+public:
+    ClauseUsefulnessTracker(int maxEffClauseLength, int maxFreeEffClauseLength, float minShare) :
+        _max_eff_clause_length(maxEffClauseLength), _max_free_eff_clause_length(maxFreeEffClauseLength),
+        _min_share(minShare), _offered(maxEffClauseLength, 0), _last_digested(maxEffClauseLength, 0),
+        _usefulness(maxEffClauseLength, 1), _has_estimate(maxEffClauseLength, false),
+        _offered_lits_share(maxEffClauseLength, 0) {}
+
+    // Clauses of an incoming sharing which were offered to each of the local solvers.
+    void recordOffered(ClauseHistogram& hist) {
+        for (int len = 1; len <= _max_eff_clause_length; len++) _offered[len-1] += hist.get(len);
+    }
+
+    // Updates the estimates with the clauses offered since the last update.
+    // digested: cumulative histograms of clauses handed to each solver;
+    // imported, discarded: cumulative counts summed over all solvers (zero if unknown),
+    // which may be refreshed less often than this method is called.
+    void update(const std::vector<ClauseHistogram*>& digested, unsigned long imported, unsigned long discarded) {
+        if (digested.empty()) return;
+
+        // Fraction of handed clauses which the solver backends kept;
+        // retained as long as the counts did not advance
+        if (imported < _last_imported || discarded < _last_discarded) {
+            // a solver was cleaned up: restart from the remaining counts
+            _last_imported = imported;
+            _last_discarded = discarded;
+        } else if (imported + discarded > _last_imported + _last_discarded) {
+            _acceptance = (imported - _last_imported) / (float) (imported + discarded - _last_imported - _last_discarded);
+            _last_imported = imported;
+            _last_discarded = discarded;
+        }
+        const float acceptance = _acceptance;
+
+        unsigned long totalOfferedLits = 0;
+        for (int len = 1; len <= _max_eff_clause_length; len++) totalOfferedLits += len * _offered[len-1];
+
+        for (int len = 1; len <= _max_eff_clause_length; len++) {
+            unsigned long sumDigested = 0;
+            for (auto hist : digested) sumDigested += hist->get(len);
+            unsigned long newlyDigested = sumDigested >= _last_digested[len-1] ?
+                sumDigested - _last_digested[len-1] : 0;
+            _last_digested[len-1] = sumDigested;
+
+            unsigned long offered = _offered[len-1] * digested.size();
+            if (totalOfferedLits > 0)
+                _offered_lits_share[len-1] = (len * _offered[len-1]) / (float) totalOfferedLits;
+            _offered[len-1] = 0;
+            if (offered == 0) continue;
+
+            float observed = acceptance * std::min(1.f, newlyDigested / (float) offered);
+            _usefulness[len-1] = _has_estimate[len-1] ?
+                _decay * _usefulness[len-1] + (1-_decay) * observed : observed;
+            _has_estimate[len-1] = true;
+        }
+    }
+
+    // Share of the export budget (relative to the full budget) which clauses of each
+    // effective length may occupy: The most useful length is not restricted, and each
+    // other length is restricted in proportion to its relative usefulness, but never
+    // below the min. share so that its usefulness can still be observed.
+    std::vector<float> getExportShares() const {
+        std::vector<float> shares(_max_eff_clause_length, 1);
+        float maxUsefulness = 0;
+        for (int len = _max_free_eff_clause_length+1; len <= _max_eff_clause_length; len++)
+            if (_has_estimate[len-1]) maxUsefulness = std::max(maxUsefulness, _usefulness[len-1]);
+        if (maxUsefulness <= 0) return shares;
+        for (int len = _max_free_eff_clause_length+1; len <= _max_eff_clause_length; len++) {
+            if (!_has_estimate[len-1]) continue;
+            shares[len-1] = std::max(_min_share, _usefulness[len-1] / maxUsefulness);
+        }
+        return shares;
+    }
+
+    // Factor for the overall sharing volume: the mean usefulness of the recently offered
+    // literals, but at least the min. share.
+    float getVolumeFactor() const {
+        float factor = 0;
+        float coveredShare = 0;
+        for (int len = 1; len <= _max_eff_clause_length; len++) {
+            if (!_has_estimate[len-1]) continue;
+            factor += _offered_lits_share[len-1] * _usefulness[len-1];
+            coveredShare += _offered_lits_share[len-1];
+        }
+        if (coveredShare <= 0) return 1;
+        return std::max(_min_share, std::min(1.f, factor / coveredShare));
+    }
+
+    float getUsefulness(int effClauseLength) const {
+        return _usefulness[effClauseLength-1];
+    }
+
+    std::string getReport() const {
+        std::string out;
+        for (int len = 1; len <= _max_eff_clause_length; len++) {
+            if (!_has_estimate[len-1]) continue;
+            out += " " + std::to_string(len) + ":" + std::to_string(_usefulness[len-1]).substr(0, 4);
+        }
+        return out;
+    }
+};
@@ -0,0 +1,83 @@
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+
+#include "app/sat/data/clause.hpp"
+#include "app/sat/data/clause_metadata.hpp"
+
+// Literals which render a shared clause useless to a particular solver:
+// A clause containing a variable the solver eliminated cannot be imported,
+// and a clause containing a literal the solver fixed to true at the root level
+// is satisfied for good. The solver's thread marks such literals incrementally
+// while the sharing thread tests incoming clauses against them concurrently,
+// so the two bits per variable are kept in atomic words. The set covers the
+// variables known at construction; other variables are never blocked.
+class BlockedLiterals {
+
+private:
+    const int _num_vars;
+    std::unique_ptr<std::atomic<uint64_t>[]> _words;
+    std::atomic_int _num_blocked_vars {0};
+
+public:
+    BlockedLiterals(int numVars) : _num_vars(std::max(0, numVars)),
+            _words(new std::atomic<uint64_t>[getNumWords()]) {
+        for (size_t i = 0; i < getNumWords(); i++) _words[i].store(0, std::memory_order_relaxed);
+    }
+
+    // The solver fixed lit to true at the root level.
+    void blockLiteral(int lit) {
+        if (!covers(lit)) return;
+        const size_t bit = getBit(lit);
+        uint64_t before = _words[bit / 64].fetch_or(1UL << (bit % 64), std::memory_order_relaxed);
+        if ((before & (3UL << ((bit % 64) & ~1UL))) == 0) _num_blocked_vars.fetch_add(1, std::memory_order_relaxed);
+    }
+    // The solver eliminated var.
+    void blockVariable(int var) {
+        if (!covers(var)) return;
+        const size_t bit = getBit(var);
+        uint64_t before = _words[bit / 64].fetch_or(3UL << (bit % 64), std::memory_order_relaxed);
+        if ((before & (3UL << (bit % 64))) == 0) _num_blocked_vars.fetch_add(1, std::memory_order_relaxed);
+    }
+    // The solver reintroduced the (previously eliminated) var, e.g., for a new increment.
+    void unblockVariable(int var) {
+        if (!covers(var)) return;
+        const size_t bit = getBit(var);
+        uint64_t before = _words[bit / 64].fetch_and(~(3UL << (bit % 64)), std::memory_order_relaxed);
+        if ((before & (3UL << (bit % 64))) != 0) _num_blocked_vars.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    bool isBlocked(int lit) const {
+        if (!covers(lit)) return false;
+        const size_t bit = getBit(lit);
+        return (_words[bit / 64].load(std::memory_order_relaxed) >> (bit % 64)) & 1UL;
+    }
+    // Whether the clause (with metadata) contains some blocked literal.
+    bool blocks(const Mallob::Clause& clause) const {
+        if (_num_blocked_vars.load(std::memory_order_relaxed) == 0) return false;
+        for (int i = ClauseMetadata::numInts(); i < clause.size; i++) {
+            if (isBlocked(clause.begin[i])) return true;
+        }
+        return false;
+    }
+    int getNumBlockedVariables() const {
+        return _num_blocked_vars.load(std::memory_order_relaxed);
+    }
+
+private:
+    size_t getNumWords() const {
+        return (2*((size_t) _num_vars+1) + 63) / 64;
+    }
+    bool covers(int lit) const {
+        return lit != 0 && std::abs(lit) <= _num_vars;
+    }
+    // The positive and the negative literal of a variable share an aligned bit pair.
+    static size_t getBit(int lit) {
+        return 2*(size_t)std::abs(lit) + (lit < 0);
+    }
+};
@@ -10,6 +10,7 @@ struct ImportingSolver {
     PortfolioSolverInterface* solver;
     SolverStatistics* solverStats;
     std::vector<bool> filter;
+    size_t numBlockedLits {0};
 
     ClauseIdAlignment* _id_alignment {nullptr};
     
@@ -41,6 +42,14 @@ private:
             solverStats->receivedClausesFiltered++;
             return true;
         }
+        if (solver->getBlockedLiterals().blocks(clause)) {
+            // contains a literal the solver fixed to true:
+            // the solver would discard the clause anyway, so don't buffer it
+            solverStats->receivedClausesBlocked++;
+            solverStats->receivedLitsBlocked += clause.size - ClauseMetadata::numInts();
+            numBlockedLits += clause.size - ClauseMetadata::numInts();
+            return true;
+        }
         // admitted by solver filter
         return false;
     }
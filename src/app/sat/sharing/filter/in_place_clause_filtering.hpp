@@ -31,29 +31,14 @@ public:
 
     int applyAndGetNewSize() {
 
-        const int bitsPerElem = sizeof(int)*8;
-		int shift = bitsPerElem;
-		int filterPos = -1 + (ClauseMetadata::enabled() ? 2 : 0);
+		const int filterOffset = ClauseMetadata::enabled() ? 2 : 0;
+		assert(_filter_size >= filterOffset);
 
         BufferReducer reducer(_clause_buffer, _clause_bufsize, 
             _params.strictClauseLengthLimit()+ClauseMetadata::numInts(), _params.groupClausesByLengthLbdSum());
 
-        size_t newSize = reducer.reduce([&]() {
-			_num_cls++;
-			if (shift == bitsPerElem) {
-				filterPos++;
-				shift = 0;
-			}
-			assert(filterPos < _filter_size);
-			bool admitted = ((_filter[filterPos] & (1 << shift)) == 0);
-			if (admitted) {
-				_num_admitted_cls++;
-			}
-			shift++;
-			return admitted;
-		});
-
-        return newSize;
+        return reducer.reduceByFilterBitset(_filter + filterOffset, _filter_size - filterOffset,
+			_num_cls, _num_admitted_cls);
     }
 
     int getNumClauses() const {
@@ -0,0 +1,214 @@
+
+#pragma once
+
+#include <stdint.h>
+#include <algorithm>
+#include <list>
+#include <utility>
+#include <vector>
+
+#include "app/sat/data/clause_metadata.hpp"
+#include "util/assert.hpp"
+
+// Compact encoding of the filter bit vectors which are OR-reduced along the job tree
+// in the distributed clause filtering mode (one bit per shared clause, set if the
+// clause is filtered). Each filter is encoded in whichever form is smallest:
+// as plain bit vector (DENSE), as a sorted list of set bit indices (INDICES), or as
+// a sorted list of (begin, length) runs of set bits (RUNS). Sparse forms are merged
+// without expanding them. Any clause metadata prefix (see ClauseMetadata) precedes
+// the encoding and is left to the caller.
+// Layout: [metadata prefix] [encoding] [#ints of dense vector] [payload]
+class SparseFilterVector {
+
+public:
+    enum Encoding {DENSE = 0, INDICES = 1, RUNS = 2};
+
+private:
+    typedef std::pair<int, int> Run; // begin, length
+
+    struct Decoded {
+        int numInts {0};
+        bool dense {false};
+        const int* words {nullptr};
+        std::vector<Run> runs;
+    };
+
+public:
+    static std::vector<int> compress(const std::vector<int>& filter) {
+        const int prefix = prefixSize();
+        assert(filter.size() >= prefix);
+        const int numInts = filter.size() - prefix;
+        const int* words = filter.data() + prefix;
+
+        // Extract runs of set bits unless the vector is clearly too dense
+        std::vector<Run> runs;
+        int numBits = 0;
+        bool tooDense = false;
+        for (int i = 0; i < numInts && !tooDense; i++) {
+            uint32_t word = words[i];
+            while (word != 0) {
+                int bit = __builtin_ctz(word);
+                int begin = 32*i + bit;
+                if (!runs.empty() && runs.back().first + runs.back().second == begin) runs.back().second++;
+                else runs.emplace_back(begin, 1);
+                numBits++;
+                word &= word - 1;
+            }
+            tooDense = numBits > numInts && 2*runs.size() > numInts;
+        }
+
+        std::vector<int> out(filter.begin(), filter.begin() + prefix);
+        if (tooDense || chooseEncoding(numInts, numBits, runs.size()) == DENSE) {
+            out.push_back(DENSE);
+            out.push_back(numInts);
+            out.insert(out.end(), words, words + numInts);
+        } else {
+            writeSparse(numInts, numBits, runs, out);
+        }
+        return out;
+    }
+
+    static std::vector<int> decompress(const std::vector<int>& encoded) {
+        const int prefix = prefixSize();
+        assert(encoded.size() >= prefix);
+        std::vector<int> out(encoded.begin(), encoded.begin() + prefix);
+        auto dec = decode(encoded);
+        if (dec.dense) {
+            out.insert(out.end(), dec.words, dec.words + dec.numInts);
+        } else {
+            out.resize(prefix + dec.numInts, 0);
+            for (auto& run : dec.runs) setBits(out.data() + prefix, run);
+        }
+        return out;
+    }
+
+    // Bitwise OR of all provided encoded filters. The metadata prefix of the result
+    // is copied from the first filter.
+    static std::vector<int> merge(const std::list<std::vector<int>>& elems) {
+        const int prefix = prefixSize();
+        assert(!elems.empty());
+
+        std::vector<Decoded> decoded;
+        int numInts = 0;
+        bool anyDense = false;
+        for (auto& elem : elems) {
+            decoded.push_back(decode(elem));
+            numInts = std::max(numInts, decoded.back().numInts);
+            anyDense |= decoded.back().dense;
+        }
+
+        std::vector<int> out(elems.front().begin(), elems.front().begin() + prefix);
+        if (anyDense) {
+            // OR everything into a plain bit vector, then re-encode
+            out.resize(prefix + numInts, 0);
+            int* words = out.data() + prefix;
+            for (auto& dec : decoded) {
+                if (dec.dense) for (int i = 0; i < dec.numInts; i++) words[i] |= dec.words[i];
+                else for (auto& run : dec.runs) setBits(words, run);
+            }
+            return compress(out);
+        }
+
+        // Union of sorted runs
+        std::vector<Run> runs;
+        for (auto& dec : decoded) {
+            size_t mid = runs.size();
+            runs.insert(runs.end(), dec.runs.begin(), dec.runs.end());
+            std::inplace_merge(runs.begin(), runs.begin() + mid, runs.end());
+        }
+        std::vector<Run> merged;
+        int numBits = 0;
+        for (auto& run : runs) {
+            if (!merged.empty() && merged.back().first + merged.back().second >= run.first) {
+                int end = std::max(merged.back().first + merged.back().second, run.first + run.second);
+                numBits += end - (merged.back().first + merged.back().second);
+                merged.back().second = end - merged.back().first;
+            } else {
+                merged.push_back(run);
+                numBits += run.second;
+            }
+        }
+
+        if (chooseEncoding(numInts, numBits, merged.size()) == DENSE) {
+            out.push_back(DENSE);
+            out.push_back(numInts);
+            out.resize(out.size() + numInts, 0);
+            for (auto& run : merged) setBits(out.data() + prefix + 2, run);
+        } else {
+            writeSparse(numInts, numBits, merged, out);
+        }
+        return out;
+    }
+
+    static Encoding getEncoding(const std::vector<int>& encoded) {
+        const int prefix = prefixSize();
+        if (encoded.size() < prefix+2) return DENSE;
+        return (Encoding) encoded[prefix];
+    }
+
+private:
+    static int prefixSize() {
+        return ClauseMetadata::enabled() ? 2 : 0;
+    }
+
+    static Encoding chooseEncoding(int numInts, int numBits, int numRuns) {
+        if (numBits <= 2*numRuns && numBits <= numInts) return INDICES;
+        if (2*numRuns <= numInts) return RUNS;
+        return DENSE;
+    }
+
+    static void writeSparse(int numInts, int numBits, const std::vector<Run>& runs, std::vector<int>& out) {
+        if (chooseEncoding(numInts, numBits, runs.size()) == INDICES) {
+            out.push_back(INDICES);
+            out.push_back(numInts);
+            for (auto& [begin, length] : runs)
+                for (int i = begin; i < begin+length; i++) out.push_back(i);
+        } else {
+            out.push_back(RUNS);
+            out.push_back(numInts);
+            for (auto& [begin, length] : runs) {
+                out.push_back(begin);
+                out.push_back(length);
+            }
+        }
+    }
+
+    static Decoded decode(const std::vector<int>& encoded) {
+        const int prefix = prefixSize();
+        Decoded dec;
+        // Neutral element: no encoding, empty filter
+        if (encoded.size() < prefix+2) return dec;
+        Encoding encoding = (Encoding) encoded[prefix];
+        dec.numInts = encoded[prefix+1];
+        const int* payload = encoded.data() + prefix + 2;
+        const size_t payloadSize = encoded.size() - prefix - 2;
+        if (encoding == DENSE) {
+            assert(payloadSize == dec.numInts);
+            dec.dense = true;
+            dec.words = payload;
+        } else if (encoding == INDICES) {
+            for (size_t i = 0; i < payloadSize; i++) {
+                if (!dec.runs.empty() && dec.runs.back().first + dec.runs.back().second == payload[i])
+                    dec.runs.back().second++;
+                else dec.runs.emplace_back(payload[i], 1);
+            }
+        } else {
+            assert(encoding == RUNS);
+            assert(payloadSize % 2 == 0);
+            for (size_t i = 0; i < payloadSize; i += 2) dec.runs.emplace_back(payload[i], payload[i+1]);
+        }
+        return dec;
+    }
+
+    static void setBits(int* words, const Run& run) {
+        int bit = run.first;
+        const int end = run.first + run.second;
+        while (bit < end) {
+            const int shift = bit % 32;
+            const int numBits = std::min(32 - shift, end - bit);
+            const uint32_t mask = (numBits == 32 ? ~0U : ((1U << numBits) - 1)) << shift;
+            words[bit / 32] |= mask;
+            bit += numBits;
+        }
+    }
+};
@@ -39,6 +39,12 @@ public:
 	ClauseHistogram& getAdmittedHistogram() {return _hist_admitted_to_db;}
 	ClauseHistogram& getDroppedHistogram() {return _hist_dropped_before_db;}
 
+    // Clauses currently waiting in a backlog, the peak thereof,
+    // and clauses dropped because the backlog was full (if applicable)
+    virtual size_t getNumBackloggedClauses() const {return 0;}
+    virtual size_t getMaxNumBackloggedClauses() const {return 0;}
+    virtual unsigned long getNumDroppedFromBacklog() const {return 0;}
+
 protected:
     void handleResult(int producerId, GenericClauseFilter::ExportResult result, int effClauseLength) {
         auto solverStats = _solver_stats.at(producerId);
@@ -0,0 +1,11 @@
+
+#pragma once
+
+#include "util/sys/counter_registry.hpp"
+
+// Event counters of the SAT subprocess, incremented by its solver and main threads.
+// The subprocess forwards their increments to its worker process (CLAUSE_PIPE_COUNTERS),
+// which includes this header as well so that it registers the same counters.
+static Counter cntSatClausesProduced("sat.clauses_produced");
+static Counter cntSatClausesImported("sat.clauses_imported");
+static Counter cntSatSharingDigests("sat.sharing_digests");
@@ -6,6 +6,8 @@
 #include <utility>
 
 #include "app/sat/sharing/clause_logger.hpp"
+#include "app/sat/sharing/clause_usefulness_tracker.hpp"
+#include "app/sat/sharing/sat_counters.hpp"
 #include "app/sat/sharing/filter/clause_buffer_lbd_scrambler.hpp"
 #include "app/sat/sharing/filter/generic_clause_filter.hpp"
 #include "app/sat/sharing/store/generic_clause_store.hpp"
@@ -131,7 +133,13 @@ SharingManager::SharingManager(
 	}
 
 	if (_job_index == 0 && _params.clauseLog.isSet()) {
-		_clause_logger.reset(new ClauseLogger(_params.clauseLog()));
+		_clause_logger.reset(new ClauseLogger(_params.clauseLog(),
+			_params.clauseLogBinary() ? ClauseLogger::BINARY : ClauseLogger::TEXT));
+	}
+
+	if (_params.clauseUsefulnessFeedback()) {
+		_usefulness.reset(new ClauseUsefulnessTracker(_params.strictClauseLengthLimit()+ClauseMetadata::numInts(),
+			_params.freeClauseLengthLimit()+ClauseMetadata::numInts(), _params.clauseUsefulnessMinShare()));
 	}
 }
 
@@ -144,6 +152,7 @@ void SharingManager::onProduceClause(int solverId, int solverRevision, const Cla
 	}
 
 	if (_solver_revisions[solverId] != solverRevision) return;
+	cntSatClausesProduced.add();
 
 	if (_params.crashMonkeyProbability() > 0) {
 		if (Random::rand() < _params.crashMonkeyProbability()) {
@@ -231,7 +240,9 @@ std::vector<int> SharingManager::prepareSharing(int totalLiteralLimit, int& outS
 	if (_det_sync) {
 		if (!_det_sync->areAllSolversSyncReady()) return std::vector<int>();
 		outSuccessfulSolverId = _det_sync->waitUntilSyncReadyAndReturnSolverIdWithResult();
-		LOGGER(_logger, V4_VVER, "All solvers synced\n");
+		LOGGER(_logger, V4_VVER, "All solvers synced, det. non-waiting time share %.3f\n", _det_sync->getNonWaitingTimeShare());
+		// Admit the clauses produced since the last sync in a deterministic order
+		_det_sync->admitLoggedClauses();
 		if (outSuccessfulSolverId >= 0) {
 			LOGGER(_logger, V4_VVER, "Emit successful solver ID %i\n", outSuccessfulSolverId);
 		}
@@ -239,6 +250,8 @@ std::vector<int> SharingManager::prepareSharing(int totalLiteralLimit, int& outS
 
 	_sharing_op_ongoing = true;
 
+	updateClauseUsefulness();
+
 	// Flushing the priority clause buffer results in owning locks
 	// for an extended period, which may block solver threads.
 	// Lock all filters such that solvers write to backlogs instead.
@@ -383,6 +396,7 @@ void SharingManager::digestSharingWithFilter(std::vector<int>& clauseBuf, std::v
 	ClauseHistogram hist(_params.strictClauseLengthLimit()+ClauseMetadata::numInts());
 
 	_logger.log(verb, "digesting len=%ld\n", clauseBuf.size());
+	cntSatSharingDigests.add();
 
 	std::vector<ImportingSolver> importingSolvers;
 	for (size_t i = 0; i < _solvers.size(); i++) {
@@ -421,8 +435,6 @@ void SharingManager::digestSharingWithFilter(std::vector<int>& clauseBuf, std::v
 			memcpy(&id, clause.begin, sizeof(uint64_t));
 		}
 
-		if (_clause_logger) _clause_logger->append(clause);
-
 		if (filterSizeBeingLocked != clause.size) {
 			if (filterSizeBeingLocked != -1) _clause_filter->releaseLock(filterSizeBeingLocked);
 			filterSizeBeingLocked = clause.size;
@@ -435,6 +447,8 @@ void SharingManager::digestSharingWithFilter(std::vector<int>& clauseBuf, std::v
 		// bitset of producing solvers
 		auto producers = _clause_filter->confirmSharingAndGetProducers(clause, _internal_epoch);
 
+		if (_clause_logger) _clause_logger->append(clause, _internal_epoch, producers);
+
 		if (_params.clauseErrorChancePerMille() > 0) {
 			if (1000*Random::rand() <= _params.clauseErrorChancePerMille()) {
 				// Tamper with a random (non meta data) literal
@@ -456,6 +470,7 @@ void SharingManager::digestSharingWithFilter(std::vector<int>& clauseBuf, std::v
 	if (filterSizeBeingLocked != -1) _clause_filter->releaseLock(filterSizeBeingLocked);
 
 	if (!_params.noImport()) {
+		if (_usefulness) _usefulness->recordOffered(hist);
 		for (auto& slv : importingSolvers) {
 			BufferReader reader = _clause_store->getBufferReader(clauseBuf.data(), clauseBuf.size());
 			reader.setFilterBitset(slv.filter);
@@ -465,8 +480,10 @@ void SharingManager::digestSharingWithFilter(std::vector<int>& clauseBuf, std::v
 	
 	// Process-wide stats
 	time = Timer::elapsedSeconds() - time;
-	_logger.log(verb, "sharing time:%.4f adm:%i/%i %s\n", time, 
-		_last_num_admitted_cls_to_import, _last_num_cls_to_import, hist.getReport().c_str());
+	size_t numBlockedLits = 0;
+	for (auto& slv : importingSolvers) numBlockedLits += slv.numBlockedLits;
+	_logger.log(verb, "sharing time:%.4f adm:%i/%i blkdlits:%lu %s\n", time, 
+		_last_num_admitted_cls_to_import, _last_num_cls_to_import, numBlockedLits, hist.getReport().c_str());
 
 	// Signal next garbage collection
 	_gc_pending = true;
@@ -474,6 +491,32 @@ void SharingManager::digestSharingWithFilter(std::vector<int>& clauseBuf, std::v
 	if (_clause_logger) _clause_logger->publish();
 }
 
+void SharingManager::updateClauseUsefulness() {
+	if (!_usefulness) return;
+
+	std::vector<ClauseHistogram*> digested;
+	unsigned long imported = 0, discarded = 0;
+	for (size_t i = 0; i < _solvers.size(); i++) {
+		auto& solver = _solvers[i];
+		if (!solver || !_solver_stats[i]) continue; // solver was cleaned up
+		if (!solver->isClauseSharingEnabled()) continue;
+		// imported / discarded counts are only as recent as the last refresh of the
+		// solver's statistics (see SatEngine::dumpStats)
+		auto& stats = *_solver_stats[i];
+		digested.push_back(stats.histDigested);
+		imported += stats.imported;
+		discarded += stats.discarded;
+	}
+	_usefulness->update(digested, imported, discarded);
+	_clause_store->setExportShares(_usefulness->getExportShares());
+	LOGGER(_logger, V4_VVER, "usefulness vol=%.3f len:use%s\n", _usefulness->getVolumeFactor(),
+		_usefulness->getReport().c_str());
+}
+
+float SharingManager::getUsefulnessVolumeFactor() const {
+	return _usefulness ? _usefulness->getVolumeFactor() : 1;
+}
+
 void SharingManager::applyFilterToBuffer(std::vector<int>& clauseBuf, std::vector<int>* filter) {
 	if (!filter) return;
 	int verb = _job_index == 0 ? V3_VERB : V5_DEBG;
@@ -513,6 +556,12 @@ void SharingManager::digestHistoricClauses(int epochBegin, int epochEnd, std::ve
 	}
 }
 
+void SharingManager::digestClauseSnapshot(std::vector<int>& clauseBuf) {
+	// Clauses from arbitrary past epochs (see ClauseSnapshot): always import
+	_logger.log(V3_VERB, "Import clause snapshot, buflen=%lu\n", clauseBuf.size());
+	digestSharingWithoutFilter(clauseBuf);
+}
+
 void SharingManager::collectGarbageInFilter() {
 	if (!_gc_pending) return;
 	_clause_filter->collectGarbage(_logger);
@@ -539,6 +588,9 @@ SharingStatistics SharingManager::getStatistics() {
 		_observed_nonunit_lbd_of_two, 
 		_observed_nonunit_lbd_of_length_minus_one, 
 		_observed_nonunit_lbd_of_length);
+	_stats.backloggedClauses = _export_buffer->getNumBackloggedClauses();
+	_stats.maxBackloggedClauses = _export_buffer->getMaxNumBackloggedClauses();
+	_stats.clausesDroppedFromBacklog = _export_buffer->getNumDroppedFromBacklog();
 	return _stats;
 }
 
@@ -19,6 +19,7 @@
 #include "util/tsl/robin_set.h"                     // for robin_set
 
 class ClauseLogger;
+class ClauseUsefulnessTracker;
 class DeterministicClauseSynchronizer;
 class GenericClauseFilter;
 class GenericClauseStore;
@@ -97,6 +98,7 @@ protected:
 	bool _sharing_op_ongoing {false};
 
 	std::unique_ptr<ClauseLogger> _clause_logger;
+	std::unique_ptr<ClauseUsefulnessTracker> _usefulness;
 
 public:
 	SharingManager(std::vector<std::shared_ptr<PortfolioSolverInterface>>& solvers,
@@ -111,6 +113,7 @@ public:
 	void digestSharingWithoutFilter(std::vector<int>& clauseBuf);
 	void returnClauses(std::vector<int>& clauseBuf);
 	void digestHistoricClauses(int epochBegin, int epochEnd, std::vector<int>& clauseBuf);
+	void digestClauseSnapshot(std::vector<int>& clauseBuf);
 	void collectGarbageInFilter();
 
 	void setWinningSolverId(int globalId);
@@ -125,6 +128,7 @@ public:
 	int getLastNumClausesToImport() const {return _last_num_cls_to_import;}
 	int getLastNumAdmittedClausesToImport() const {return _last_num_admitted_cls_to_import;}
 	int getLastNumAdmittedLitsToImport() const {return _last_num_admitted_lits_to_import;}
+	float getUsefulnessVolumeFactor() const;
 
 	int getGlobalStartOfSuccessEpoch() {
 		return !_id_alignment ? 0 : _id_alignment->getGlobalStartOfSuccessEpoch();
@@ -150,6 +154,8 @@ private:
 		};
 	};
 
+	void updateClauseUsefulness();
+
 	void tryReinsertDeferredClauses(int solverId, std::list<Mallob::Clause>& clauses, SolverStatistics* stats);
 	void digestDeferredFutureClauses();
 
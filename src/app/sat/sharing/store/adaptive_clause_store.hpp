@@ -39,6 +39,10 @@ private:
     bool _reset_pop_idx {false};
     unsigned long _pop_op_count {1};
 
+    // Max. share of an export's literal limit per (effective) clause length
+    // (index = length-1); empty if unrestricted
+    std::vector<float> _export_shares;
+
 public:
     struct Setup {
         int numLiterals = 1000;
@@ -160,9 +164,7 @@ public:
         }
         if (_pop_op_count % 131072 == 0) {
             // Perform a flush over all slots to shrink slots and discard old clauses
-            BufferBuilder dummyBuilder = getBufferBuilder(nullptr, 0);
-            for (auto& slot : _slots) slot->flushAndShrink(dummyBuilder);
-            assert(dummyBuilder.getNumAddedClauses() == 0);
+            discardFreedClauses();
         }
         // Cycle once over all slots, beginning with the (cached) slot index,
         // until success. Remember if a spurious fail occurred somewhere.
@@ -206,10 +208,21 @@ public:
             bool updateMaxAdmissibleIndex = nbLitsContained >= 0.9*_total_literal_limit;
             int nbLitsEncountered = 0;
             ClauseSlot::FlushMode flushMode {ClauseSlot::FLUSH_FITTING};
+            std::vector<int> nbExportedLitsPerLength(_export_shares.size(), 0);
             for (int i = 1; i < _slots.size(); i++) {
+                // Restrict the literals exported from this slot if desired
+                int maxNbLits = std::numeric_limits<int>::max();
+                int clauseLength = _slots[i]->getClauseLength();
+                if (sizeLimit >= 0 && clauseLength <= _export_shares.size()) {
+                    maxNbLits = std::max(0, (int) (_export_shares[clauseLength-1] * sizeLimit)
+                        - nbExportedLitsPerLength[clauseLength-1]);
+                }
                 // Get number of a priori stored literals, flush slot
                 nbLitsEncountered += _slots[i]->getNbStoredLiterals();
-                _slots[i]->flushAndShrink(builder, clauseDataConverter, flushMode, _reset_lbd_at_export);
+                int nbAddedLitsBefore = builder.getNumAddedLits();
+                _slots[i]->flushAndShrink(builder, clauseDataConverter, flushMode, _reset_lbd_at_export, maxNbLits);
+                if (clauseLength <= _export_shares.size())
+                    nbExportedLitsPerLength[clauseLength-1] += builder.getNumAddedLits() - nbAddedLitsBefore;
                 // Enough literals encountered to make the cut for updating max. admissible slot?
                 if (updateMaxAdmissibleIndex && nbLitsEncountered >= 0.95 * nbLitsContained) {
                     //LOG(V2_INFO, "LIMIT pcb adm. slot to %i\n", i);
@@ -226,9 +239,21 @@ public:
         return builder.extractBuffer();
     }
 
+    void setExportShares(const std::vector<float>& sharePerClauseLength) override {
+        _export_shares = sharePerClauseLength;
+    }
+
+    // Physically removes all clauses which were freed to make room for better clauses,
+    // notifying any clause deletion callbacks, and shrinks the slots.
+    void discardFreedClauses() {
+        BufferBuilder dummyBuilder = getBufferBuilder(nullptr, 0);
+        for (auto& slot : _slots) slot->flushAndShrink(dummyBuilder);
+        assert(dummyBuilder.getNumAddedClauses() == 0);
+    }
+
     std::vector<int> readBuffer() override {
 
-        BufferBuilder builder(INT_MAX, _max_eff_clause_length, _slots_for_sum_of_length_and_lbd);
+        BufferBuilder builder(-1, _max_eff_clause_length, _slots_for_sum_of_length_and_lbd); // unlimited, no reservation
         builder.setFreeClauseLengthLimit(_max_free_eff_clause_length);
         for (auto& slot : _slots) {
             slot->readAll(builder);
@@ -3,6 +3,7 @@
 
 #include <atomic>
 #include <memory>
+#include <limits>
 #include <cmath>
 #include "app/sat/data/clause.hpp"
 #include "app/sat/data/clause_histogram.hpp"
@@ -130,7 +131,7 @@ public:
 
     enum FlushMode {FLUSH_FITTING, FLUSH_OR_DISCARD_ALL};
     void flushAndShrink(BufferBuilder& buf, std::function<void(int*)> clauseDataConverter = [](int*){},
-        FlushMode flushMode = FLUSH_FITTING, bool resetLbd = false) {
+        FlushMode flushMode = FLUSH_FITTING, bool resetLbd = false, int maxNbLits = std::numeric_limits<int>::max()) {
 
         // Acquire lock
         auto lock = _mtx.getLock();
@@ -141,7 +142,7 @@ public:
 
         // Fetch clauses as long as possible
         std::vector<Mallob::Clause> flushedClauses;
-        int nbRemainingLits = buf.getMaxRemainingLits();
+        int nbRemainingLits = std::min(buf.getMaxRemainingLits(), maxNbLits);
         nbRemainingLits -= (nbRemainingLits % _clause_length);
         const int nbStoredLits = getNbStoredLiterals();
         int nbFreedLits = tryFreeStoredLiterals(nbRemainingLits, true);
@@ -185,6 +186,9 @@ public:
         // Acquire lock
         auto lock = _mtx.getLock();
 
+        // Do not read clauses which were freed by other slots
+        discardFreedClauses();
+
         std::vector<Mallob::Clause> flushedClauses;
         int dataIdx = _data_size - _effective_clause_length;
         while (dataIdx >= 0) {
@@ -39,6 +39,8 @@ public:
     virtual void setClauseDeletionCallback(std::function<void(Mallob::Clause&)> cb) {}
     virtual void setClauseDeletionCallback(int clauseLength, std::function<void(Mallob::Clause&)> cb) {}
     virtual void clearClauseDeletionCallbacks() {}
+    // Restrict the share of an export's literal limit per (effective) clause length
+    virtual void setExportShares(const std::vector<float>& sharePerClauseLength) {}
 
     virtual int getCurrentlyUsedLiterals() const {return 0;}
     virtual std::string getCurrentlyUsedLiteralsReport() const {return std::string();}
@@ -8,6 +8,7 @@
 #include "app/sat/data/clause_metadata.hpp"
 #include "app/sat/sharing/adaptive_import_manager.hpp"
 #include "app/sat/sharing/ring_buffer_import_manager.hpp"
+#include "app/sat/sharing/sat_counters.hpp"
 #include "app/sat/sharing/store/generic_clause_store.hpp"
 #include "util/random.hpp"
 #include "util/sys/threading.hpp"
@@ -55,7 +56,7 @@ PortfolioSolverInterface::PortfolioSolverInterface(const SolverSetup& setup)
 			} else {
 				return new RingBufferImportManager(setup, _stats);
 			}
-		  }()), _rng(_setup.globalId) {
+		  }()), _blocked_literals(setup.eliminationAwareImport ? setup.numVars : 0), _rng(_setup.globalId) {
 	updateTimer(_job_name);
 	_global_name = "<h-" + _job_name + "_S" + std::to_string(_global_id) + ">";
 	_stats.histProduced = new ClauseHistogram(setup.strictMaxLitsPerClause+ClauseMetadata::numInts());
@@ -76,7 +77,8 @@ PortfolioSolverInterface::PortfolioSolverInterface(const SolverSetup& setup)
 			// ONLY IF desired and there is no pre-created LRATConnector instance for this purpose.
 			LOGGER(_logger, V3_VERB, "Creating full LratConnector%s\n", createModelCheckingLratConn?" with checking models":"");
 			_lrat = new LratConnector(_logger, _setup.localId, _setup.numVars,
-				createModelCheckingLratConn, _setup.maxNumSolvers, _setup.globalId, _setup.plratProofOutput, _setup.proofDir
+				createModelCheckingLratConn, _setup.maxNumSolvers, _setup.globalId, _setup.plratProofOutput, _setup.proofDir,
+				_setup.onTheFlyBatchImports
 			);
 			if (createModelCheckingLratConn) _setup.modelCheckingLratConnector = _lrat;
 		} else {
@@ -84,7 +86,8 @@ PortfolioSolverInterface::PortfolioSolverInterface(const SolverSetup& setup)
 			if (createModelCheckingLratConn) {
 				LOGGER(_logger, V3_VERB, "Creating dedicated LratConnector for checking models\n");
 				_setup.modelCheckingLratConnector = new LratConnector(
-					_logger, _setup.localId, _setup.numVars, true, _setup.maxNumSolvers, _setup.globalId, _setup.plratProofOutput, _setup.proofDir
+					_logger, _setup.localId, _setup.numVars, true, _setup.maxNumSolvers, _setup.globalId, _setup.plratProofOutput, _setup.proofDir,
+					_setup.onTheFlyBatchImports
 				);
 				_setup.owningModelCheckingLratConnector = true;
 			}
@@ -137,9 +140,12 @@ void PortfolioSolverInterface::setTerminate() {
 
 void PortfolioSolverInterface::setExtLearnedClauseCallback(const ExtLearnedClauseCallback& callback) {
 	auto cb = ([callback, this](const Mallob::Clause& c, int solverId) {
-		if (_terminated || !_setup.exportClauses) return;
 		int condVar = _current_cond_var_or_zero;
 		assert(condVar >= 0);
+		// An unconditional learned unit is fixed at this solver's root level
+		if (condVar == 0 && c.size - ClauseMetadata::numInts() == 1)
+			_blocked_literals.blockLiteral(c.begin[ClauseMetadata::numInts()]);
+		if (_terminated || !_setup.exportClauses) return;
 		callback(c, solverId, getSolverSetup().solverRevision, condVar);
 	});
 	setLearnedClauseCallback(cb);
@@ -159,12 +165,16 @@ void PortfolioSolverInterface::addLearnedClause(const Mallob::Clause& c) {
 bool PortfolioSolverInterface::fetchLearnedClause(Mallob::Clause& clauseOut, GenericClauseStore::ExportMode mode) {
 	if (_clause_sharing_disabled) return false;
 	clauseOut = _import_manager->getClause(mode);
-	return clauseOut.begin != nullptr && clauseOut.size >= 1;
+	if (clauseOut.begin == nullptr || clauseOut.size < 1) return false;
+	cntSatClausesImported.add();
+	return true;
 }
 
 std::vector<int> PortfolioSolverInterface::fetchLearnedUnitClauses() {
 	if (_clause_sharing_disabled) return std::vector<int>();
-	return _import_manager->getUnitsBuffer();
+	auto units = _import_manager->getUnitsBuffer();
+	cntSatClausesImported.add(units.size());
+	return units;
 }
 
 PortfolioSolverInterface::~PortfolioSolverInterface() {
@@ -12,6 +12,7 @@
 #include "app/sat/data/definitions.hpp"
 #include "app/sat/data/solver_statistics.hpp"
 #include "app/sat/execution/solver_setup.hpp"
+#include "app/sat/sharing/filter/blocked_literals.hpp"
 #include "app/sat/sharing/generic_import_manager.hpp"
 #include "app/sat/sharing/store/generic_clause_store.hpp"
 #include "util/random.hpp"
@@ -176,6 +177,9 @@ public:
 		_import_manager->performImport(reader);
 	}
 
+	// Literals due to which shared clauses are useless to this solver (see BlockedLiterals).
+	const BlockedLiterals& getBlockedLiterals() const {return _blocked_literals;}
+
 	// Within the solver, fetch a clause that was previously added as a learned clause.
 	bool fetchLearnedClause(Mallob::Clause& clauseOut, GenericClauseStore::ExportMode mode = GenericClauseStore::ANY);
 	std::vector<int> fetchLearnedUnitClauses();
@@ -202,6 +206,7 @@ private:
 
 	SolverStatistics _stats;
 	std::unique_ptr<GenericImportManager> _import_manager;
+	BlockedLiterals _blocked_literals;
 
 	SplitMix64Rng _rng;
 };
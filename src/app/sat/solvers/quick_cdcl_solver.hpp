@@ -0,0 +1,342 @@
+
+#pragma once
+
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+#include "app/sat/job/sat_constants.h"
+#include "util/sys/timer.hpp"
+
+// A small, self-contained sequential CDCL solver for deciding easy formulas within
+// a strict budget of conflicts and wallclock time, e.g., by a client before a job
+// is scheduled at all. It features two watched literals with blockers, first-UIP
+// learning, VSIDS branching, phase saving and Luby restarts, but no preprocessing
+// and no clause deletion, which is acceptable for short budgets only.
+class QuickCdclSolver {
+
+private:
+    struct Watcher {
+        int cref;
+        int blocker;
+    };
+
+    int _nb_vars {0};
+    bool _unsat {false};
+
+    // clause arena: size, lit_1, ..., lit_size (the first two literals are watched)
+    std::vector<int> _arena;
+    // indexed by literal: clauses to visit when the literal becomes false
+    std::vector<std::vector<Watcher>> _watches;
+
+    std::vector<signed char> _values; // per var: 1 true, -1 false, 0 unassigned
+    std::vector<int> _levels;
+    std::vector<int> _reasons;
+    std::vector<bool> _phases;
+    std::vector<bool> _seen;
+    std::vector<int> _trail;
+    std::vector<int> _trail_limits;
+    size_t _prop_head {0};
+
+    // VSIDS
+    std::vector<double> _activity;
+    double _var_inc {1};
+    std::vector<int> _heap;
+    std::vector<int> _heap_pos; // -1 if not in heap
+
+    unsigned long _nb_conflicts {0};
+
+public:
+    // Reads a formula given as a sequence of zero-terminated clauses.
+    QuickCdclSolver(const int* lits, size_t size) {
+        for (size_t i = 0; i < size; i++) _nb_vars = std::max(_nb_vars, std::abs(lits[i]));
+        _watches.resize(2*(_nb_vars+1));
+        _values.assign(_nb_vars+1, 0);
+        _levels.assign(_nb_vars+1, 0);
+        _reasons.assign(_nb_vars+1, -1);
+        _phases.assign(_nb_vars+1, false);
+        _seen.assign(_nb_vars+1, false);
+        _activity.assign(_nb_vars+1, 0);
+        _heap_pos.assign(_nb_vars+1, -1);
+        for (int v = 1; v <= _nb_vars; v++) heapInsert(v);
+
+        std::vector<int> clause;
+        for (size_t i = 0; i < size; i++) {
+            if (lits[i] != 0) {
+                clause.push_back(lits[i]);
+                continue;
+            }
+            addOriginalClause(clause);
+            clause.clear();
+        }
+        if (!clause.empty()) addOriginalClause(clause);
+    }
+
+    // Returns RESULT_SAT, RESULT_UNSAT, or 0 if the budget was exhausted.
+    int solve(unsigned long maxConflicts, float maxSeconds) {
+        if (_unsat || propagate() >= 0) return RESULT_UNSAT;
+
+        const float startTime = Timer::elapsedSeconds();
+        unsigned long restartIndex = 0;
+        unsigned long conflictsUntilRestart = 100 * luby(restartIndex++);
+
+        while (true) {
+            int conflict = propagate();
+            if (conflict >= 0) {
+                _nb_conflicts++;
+                if (decisionLevel() == 0) return RESULT_UNSAT;
+                int backjumpLevel;
+                std::vector<int> learnt = analyze(conflict, backjumpLevel);
+                backtrack(backjumpLevel);
+                if (learnt.size() == 1) {
+                    assign(learnt[0], -1);
+                } else {
+                    int cref = addClause(learnt);
+                    assign(learnt[0], cref);
+                }
+                decayActivities();
+
+                if (_nb_conflicts >= maxConflicts) return 0;
+                if (_nb_conflicts % 256 == 0 && maxSeconds > 0
+                        && Timer::elapsedSeconds() - startTime >= maxSeconds) return 0;
+                if (--conflictsUntilRestart == 0) {
+                    backtrack(0);
+                    conflictsUntilRestart = 100 * luby(restartIndex++);
+                }
+                continue;
+            }
+
+            int var = pickBranchVariable();
+            if (var == 0) return RESULT_SAT;
+            _trail_limits.push_back(_trail.size());
+            assign(_phases[var] ? var : -var, -1);
+        }
+    }
+
+    // Model in the format of a job result's solution: [0, ±1, ±2, ..., ±n]
+    std::vector<int> getModel() const {
+        std::vector<int> model(_nb_vars+1, 0);
+        for (int v = 1; v <= _nb_vars; v++) model[v] = _values[v] > 0 ? v : -v;
+        return model;
+    }
+
+    unsigned long getNumConflicts() const {return _nb_conflicts;}
+
+private:
+    static inline size_t idx(int lit) {return 2*std::abs(lit) + (lit < 0);}
+    inline int value(int lit) const {return lit > 0 ? _values[lit] : -_values[-lit];}
+    inline int decisionLevel() const {return _trail_limits.size();}
+
+    void addOriginalClause(std::vector<int>& clause) {
+        if (_unsat) return;
+        // remove duplicates and satisfied (tautological) clauses
+        std::sort(clause.begin(), clause.end(), [](int a, int b) {
+            return std::abs(a) < std::abs(b) || (std::abs(a) == std::abs(b) && a < b);
+        });
+        clause.erase(std::unique(clause.begin(), clause.end()), clause.end());
+        for (size_t i = 1; i < clause.size(); i++) if (clause[i] == -clause[i-1]) return;
+
+        if (clause.empty()) {
+            _unsat = true;
+        } else if (clause.size() == 1) {
+            if (value(clause[0]) < 0) _unsat = true;
+            else if (value(clause[0]) == 0) assign(clause[0], -1);
+        } else addClause(clause);
+    }
+
+    int addClause(const std::vector<int>& clause) {
+        int cref = _arena.size();
+        _arena.push_back(clause.size());
+        _arena.insert(_arena.end(), clause.begin(), clause.end());
+        _watches[idx(clause[0])].push_back(Watcher{cref, clause[1]});
+        _watches[idx(clause[1])].push_back(Watcher{cref, clause[0]});
+        return cref;
+    }
+
+    void assign(int lit, int reason) {
+        int var = std::abs(lit);
+        _values[var] = lit > 0 ? 1 : -1;
+        _levels[var] = decisionLevel();
+        _reasons[var] = reason;
+        _trail.push_back(lit);
+    }
+
+    // Returns the reference of a conflicting clause or -1.
+    int propagate() {
+        while (_prop_head < _trail.size()) {
+            const int falseLit = -_trail[_prop_head++];
+            auto& watchers = _watches[idx(falseLit)];
+            size_t i = 0, j = 0;
+            while (i < watchers.size()) {
+                Watcher w = watchers[i++];
+                if (value(w.blocker) > 0) {
+                    watchers[j++] = w;
+                    continue;
+                }
+                int* lits = _arena.data() + w.cref + 1;
+                const int size = _arena[w.cref];
+                if (lits[0] == falseLit) std::swap(lits[0], lits[1]);
+                const int first = lits[0];
+                w.blocker = first;
+                if (value(first) > 0) {
+                    watchers[j++] = w;
+                    continue;
+                }
+                // find a new literal to watch
+                bool found = false;
+                for (int k = 2; k < size; k++) {
+                    if (value(lits[k]) >= 0) {
+                        lits[1] = lits[k];
+                        lits[k] = falseLit;
+                        _watches[idx(lits[1])].push_back(w);
+                        found = true;
+                        break;
+                    }
+                }
+                if (found) continue;
+                watchers[j++] = w;
+                if (value(first) < 0) {
+                    // conflict
+                    while (i < watchers.size()) watchers[j++] = watchers[i++];
+                    watchers.resize(j);
+                    _prop_head = _trail.size();
+                    return w.cref;
+                }
+                assign(first, w.cref);
+            }
+            watchers.resize(j);
+        }
+        return -1;
+    }
+
+    // First-UIP conflict analysis. The asserting literal is placed first
+    // and a literal of the backjump level second.
+    std::vector<int> analyze(int conflict, int& backjumpLevel) {
+        std::vector<int> learnt(1, 0);
+        int pathCount = 0;
+        int uip = 0;
+        int trailIdx = _trail.size()-1;
+        int cref = conflict;
+        do {
+            const int size = _arena[cref];
+            const int* lits = _arena.data() + cref + 1;
+            for (int k = (uip == 0 ? 0 : 1); k < size; k++) {
+                const int var = std::abs(lits[k]);
+                if (_seen[var] || _levels[var] == 0) continue;
+                _seen[var] = true;
+                bumpActivity(var);
+                if (_levels[var] >= decisionLevel()) pathCount++;
+                else learnt.push_back(lits[k]);
+            }
+            while (!_seen[std::abs(_trail[trailIdx])]) trailIdx--;
+            uip = _trail[trailIdx--];
+            cref = _reasons[std::abs(uip)];
+            _seen[std::abs(uip)] = false;
+            pathCount--;
+        } while (pathCount > 0);
+        learnt[0] = -uip;
+
+        backjumpLevel = 0;
+        for (size_t k = 1; k < learnt.size(); k++) {
+            const int var = std::abs(learnt[k]);
+            _seen[var] = false;
+            if (_levels[var] > backjumpLevel) {
+                backjumpLevel = _levels[var];
+                std::swap(learnt[1], learnt[k]);
+            }
+        }
+        return learnt;
+    }
+
+    void backtrack(int level) {
+        if (decisionLevel() <= level) return;
+        for (int i = _trail.size()-1; i >= _trail_limits[level]; i--) {
+            const int var = std::abs(_trail[i]);
+            _phases[var] = _trail[i] > 0;
+            _values[var] = 0;
+            _reasons[var] = -1;
+            if (_heap_pos[var] < 0) heapInsert(var);
+        }
+        _trail.resize(_trail_limits[level]);
+        _trail_limits.resize(level);
+        _prop_head = _trail.size();
+    }
+
+    int pickBranchVariable() {
+        while (!_heap.empty()) {
+            int var = heapPopMax();
+            if (_values[var] == 0) return var;
+        }
+        return 0;
+    }
+
+    // x-th element (0-based) of the Luby sequence 1 1 2 1 1 2 4 ...
+    static unsigned long luby(unsigned long x) {
+        unsigned long size = 1, seq = 0;
+        while (size < x+1) {
+            seq++;
+            size = 2*size+1;
+        }
+        while (size-1 != x) {
+            size = (size-1) >> 1;
+            seq--;
+            x = x % size;
+        }
+        return 1UL << seq;
+    }
+
+    void bumpActivity(int var) {
+        _activity[var] += _var_inc;
+        if (_activity[var] > 1e100) {
+            for (auto& a : _activity) a *= 1e-100;
+            _var_inc *= 1e-100;
+        }
+        if (_heap_pos[var] >= 0) heapSiftUp(_heap_pos[var]);
+    }
+    void decayActivities() {
+        _var_inc /= 0.95;
+    }
+
+    void heapInsert(int var) {
+        _heap_pos[var] = _heap.size();
+        _heap.push_back(var);
+        heapSiftUp(_heap.size()-1);
+    }
+    int heapPopMax() {
+        int top = _heap[0];
+        _heap_pos[top] = -1;
+        int last = _heap.back();
+        _heap.pop_back();
+        if (!_heap.empty()) {
+            _heap[0] = last;
+            _heap_pos[last] = 0;
+            heapSiftDown(0);
+        }
+        return top;
+    }
+    void heapSiftUp(size_t pos) {
+        const int var = _heap[pos];
+        while (pos > 0) {
+            size_t parent = (pos-1) / 2;
+            if (_activity[_heap[parent]] >= _activity[var]) break;
+            _heap[pos] = _heap[parent];
+            _heap_pos[_heap[pos]] = pos;
+            pos = parent;
+        }
+        _heap[pos] = var;
+        _heap_pos[var] = pos;
+    }
+    void heapSiftDown(size_t pos) {
+        const int var = _heap[pos];
+        while (2*pos+1 < _heap.size()) {
+            size_t child = 2*pos+1;
+            if (child+1 < _heap.size() && _activity[_heap[child+1]] > _activity[_heap[child]]) child++;
+            if (_activity[_heap[child]] <= _activity[var]) break;
+            _heap[pos] = _heap[child];
+            _heap_pos[_heap[pos]] = pos;
+            pos = child;
+        }
+        _heap[pos] = var;
+        _heap_pos[var] = pos;
+    }
+};
@@ -9,6 +9,7 @@
 #include "event_driven_balancer.hpp"
 #include "app/job.hpp"
 #include "volume_calculator.hpp"
+#include "volume_hysteresis.hpp"
 #include "util/data_statistics.hpp"
 #include "app/job_tree.hpp"
 #include "balancing/balancing_entry.hpp"
@@ -18,10 +19,14 @@
 #include "data/serializable.hpp"
 #include "util/logger.hpp"
 #include "util/sys/timer.hpp"
+#include "util/tracer.hpp"
 
 class Parameters;
 
-EventDrivenBalancer::EventDrivenBalancer(MPI_Comm& comm, Parameters& params) : _comm(comm), _params(params) {
+EventDrivenBalancer::EventDrivenBalancer(MPI_Comm& comm, Parameters& params) : _comm(comm), _params(params),
+        _hysteresis(params.churnAwareBalancing(), params.churnShrinkInterval(),
+            // epochs without new events are still initiated at most once per period
+            std::max(0.01f, params.balancingPeriod())) {
 
     int size = MyMpi::size(_comm);
     int myRank = MyMpi::rank(_comm);
@@ -77,7 +82,7 @@ void EventDrivenBalancer::setBalancingDoneCallback(std::function<void()> callbac
 void EventDrivenBalancer::onProbe(int jobId) {
     _local_jobs.insert(jobId);
     pushEvent(Event({
-        jobId, /*jobRootEpoch=*/1, /*demand=*/1, /*priority=*/0.01
+        jobId, /*jobRootEpoch=*/1, /*demand=*/1, /*priority=*/0.01, /*coHosted=*/false
     }), /*recordLatency=*/false);
 }
 
@@ -109,7 +114,7 @@ void EventDrivenBalancer::onDemandChange(const Job& job, int demand) {
     assert(_job_root_epochs.at(job.getId()) > 0);
 
     pushEvent(Event({
-        job.getId(), ++_job_root_epochs[job.getId()], demand, job.getPriority()
+        job.getId(), ++_job_root_epochs[job.getId()], demand, job.getPriority(), job.isCoHosted(), getStartupCost(job)
     }));
 }
 
@@ -120,7 +125,16 @@ void EventDrivenBalancer::onSuspend(const Job& job) {
 
     assert(_job_root_epochs.at(job.getId()) > 0);
     pushEvent(Event({
-        job.getId(), ++_job_root_epochs[job.getId()], /*demand=*/1, job.getPriority()
+        job.getId(), ++_job_root_epochs[job.getId()], /*demand=*/1, job.getPriority(), job.isCoHosted(), getStartupCost(job)
+    }));
+}
+
+void EventDrivenBalancer::onCoHostingChange(const Job& job) {
+
+    if (!job.getJobTree().isRoot() || !_job_root_epochs.count(job.getId())) return;
+    pushEvent(Event({
+        job.getId(), ++_job_root_epochs[job.getId()], std::max(1, job.getLastDemand()), job.getPriority(), 
+        job.isCoHosted(), getStartupCost(job)
     }));
 }
 
@@ -140,6 +154,10 @@ void EventDrivenBalancer::onTerminate(const Job& job) {
     }), /*recordLatency=*/false);
     _job_root_epochs.erase(job.getId());
 
+    auto churn = _hysteresis.getChurnStats(job.getId());
+    LOG(V3_VERB, "%s balancing churn={grows:%i shrinks:%i spawned:%i}\n",
+        job.toStr(), churn.numGrows, churn.numShrinks, churn.numSpawned);
+
     if (!_balancing_latencies.count(job.getId())) return;
     auto& latencies = _balancing_latencies[job.getId()];
     if (!latencies.empty()) {
@@ -169,8 +187,9 @@ void EventDrivenBalancer::pushEvent(const Event& event, bool recordLatency) {
 }
 
 void EventDrivenBalancer::advance() {
-    // Have anything to reduce?
-    if (_diffs.isEmpty()) return;
+    // Have anything to reduce? The root also initiates epochs without any events
+    // as long as there are deferred volume changes to revisit.
+    if (_diffs.isEmpty() && !(_hysteresis.hasDeferredChanges() && isRoot(MyMpi::rank(_comm)))) return;
 
     // Is ready to perform balancing again?
     if (!_periodic_balancing.ready(Timer::elapsedSecondsCached())) return;
@@ -192,11 +211,13 @@ void EventDrivenBalancer::handleData(EventMap& data, int tag, bool checkedReady)
             if (isRoot(MyMpi::rank(_comm))) {
                 // Switch to broadcast, continue below @ other branch
                 _diffs.setGlobalEpoch(_balancing_epoch+1);
+                Tracer::instant("balancing", "broadcast", {"epoch", (long) _balancing_epoch+1});
                 tag = MSG_BROADCAST_DATA;
                 handleData(_diffs, MSG_BROADCAST_DATA, /*checkedReady=*/true);
             } else { 
                 // send diff upwards
                 MyMpi::isend(getParentRank(), MSG_REDUCE_DATA, _diffs);
+                Tracer::instant("balancing", "reduce", {"events", (long) _diffs.getEntries().size()});
                 _diffs.clear();
             }
         }
@@ -215,6 +236,7 @@ void EventDrivenBalancer::handleData(EventMap& data, int tag, bool checkedReady)
 
 void EventDrivenBalancer::digest(const EventMap& data) {
     
+    Tracer::Span span("balancing", "digest", {"epoch", (long) data.getGlobalEpoch(), "events", (long) data.getEntries().size()});
     LOG(V5_DEBG, "BLC DIGEST epoch=%ld size=%ld\n", data.getGlobalEpoch(), data.getEntries().size());
     LOG(V5_DEBG, "BLC DIGEST diff=%s\n", _diffs.toStr().c_str());
     LOG(V5_DEBG, "BLC DIGEST data=%s\n", data.toStr().c_str());
@@ -242,12 +264,16 @@ void EventDrivenBalancer::computeBalancingResult() {
     //int verb = rank == 0 ? V4_VVER : V6_DEBGV;
     _job_volumes.clear();
 
-    if (_states.isEmpty()) return;
+    if (_states.isEmpty()) {
+        _hysteresis.clear();
+        return;
+    }
 
     if (rank == 0) LOG(V5_DEBG, "BLC: calc result\n");
 
     VolumeCalculator calc(_states, _params, MyMpi::size(_comm), /*logging=*/rank == 0);
     calc.calculateResult();
+    _hysteresis.apply(_balancing_epoch, calc.getMutableEntries(), _states, calc.getAvailableVolume());
 
     std::string msg = "";
     for (const auto& entry : calc.getEntries()) {
@@ -320,6 +346,16 @@ float EventDrivenBalancer::getPriority(int jobId) {
     return _states.getEntries().at(jobId).priority;
 }
 
+float EventDrivenBalancer::getStartupCost(const Job& job) {
+    size_t descriptionSize = 0;
+    if (job.hasDescription()) {
+        const auto& desc = job.getDescription();
+        for (int rev = 0; rev <= desc.getMaxConsecutiveRevision(); rev++)
+            descriptionSize += desc.getTransferSize(rev);
+    }
+    return _params.churnSpawnLatency() + descriptionSize / (1'000'000 * _params.churnTransferRate());
+}
+
 size_t EventDrivenBalancer::getGlobalEpoch() const {
     return _states.getGlobalEpoch();
 }
@@ -335,4 +371,8 @@ EventDrivenBalancer::~EventDrivenBalancer() {
     LOG(V3_VERB, "STATS balancing_latencies num:%ld min:%.6f max:%.6f med:%.6f mean:%.6f\n", 
         stats.num(), stats.min(), stats.max(), stats.median(), stats.mean());
     stats.logFullDataIntoFile(".balancing-latencies");
+
+    const auto& churn = _hysteresis.getTotalChurnStats();
+    LOG(V3_VERB, "STATS balancing_churn grows:%i shrinks:%i spawned:%i\n",
+        churn.numGrows, churn.numShrinks, churn.numSpawned);
 }
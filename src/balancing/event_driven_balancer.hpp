@@ -15,6 +15,7 @@
 #include "data/reduceable.hpp"
 #include "util/logger.hpp"
 #include "balancing/event_map.hpp"
+#include "balancing/volume_hysteresis.hpp"
 #include "util/periodic_event.hpp"
 #include "comm/mpi_base.hpp"
 #include "util/robin_hood.hpp"
@@ -36,6 +37,7 @@ public:
     void onActivate(const Job& job, int demand);
     void onDemandChange(const Job& job, int demand);
     void onSuspend(const Job& job);
+    void onCoHostingChange(const Job& job);
     void onTerminate(const Job& job);
 
     void advance();
@@ -61,6 +63,7 @@ private:
     robin_hood::unordered_set<int> _local_jobs;
     robin_hood::unordered_map<int, int> _job_root_epochs;
     robin_hood::unordered_map<int, int> _job_volumes;
+    VolumeHysteresis _hysteresis;
 
     robin_hood::unordered_map<int, std::vector<float>> _balancing_latencies;
     std::list<std::vector<float>> _past_balancing_latencies;
@@ -93,6 +96,7 @@ private:
 
     int getNewDemand(int jobId);
     float getPriority(int jobId);
+    float getStartupCost(const Job& job);
 };
 
 #endif
\ No newline at end of file
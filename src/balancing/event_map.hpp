@@ -14,6 +14,8 @@ struct Event {
     int epoch;
     int demand;
     float priority;
+    bool coHosted; // light job which runs next to another job on its PE and occupies no PE of its own
+    float startupCost; // expected time (s) to bring up the job on a further PE, estimated at its root
 
     // only for balancing - not serialized in EventMap serialization
     double assignment;
@@ -21,7 +23,8 @@ struct Event {
 
     bool operator==(const Event& other) const {
         return jobId == other.jobId && epoch == other.epoch 
-                && demand == other.demand && priority == other.priority;
+                && demand == other.demand && priority == other.priority
+                && coHosted == other.coHosted;
     }
 
     bool operator!=(const Event& other) const {
@@ -39,7 +42,7 @@ private:
     size_t _global_epoch = 0;
     std::map<int, Event> _map;
 
-    const int _size_per_event = 3*sizeof(int)+sizeof(float);
+    const int _size_per_event = 3*sizeof(int)+2*sizeof(float)+sizeof(bool);
 
 public:
     virtual std::vector<uint8_t> serialize() const override {
@@ -51,6 +54,8 @@ public:
             n = sizeof(int); memcpy(result.data()+i, &entry.second.epoch, n); i += n;
             n = sizeof(int); memcpy(result.data()+i, &entry.second.demand, n); i += n;
             n = sizeof(float); memcpy(result.data()+i, &entry.second.priority, n); i += n;
+            n = sizeof(bool); memcpy(result.data()+i, &entry.second.coHosted, n); i += n;
+            n = sizeof(float); memcpy(result.data()+i, &entry.second.startupCost, n); i += n;
         }
         return result;
     }
@@ -66,6 +71,8 @@ public:
             n = sizeof(int); memcpy(&newEvent.epoch, packed.data()+i, n); i += n;
             n = sizeof(int); memcpy(&newEvent.demand, packed.data()+i, n); i += n;
             n = sizeof(float); memcpy(&newEvent.priority, packed.data()+i, n); i += n;
+            n = sizeof(bool); memcpy(&newEvent.coHosted, packed.data()+i, n); i += n;
+            n = sizeof(float); memcpy(&newEvent.startupCost, packed.data()+i, n); i += n;
             _map[newEvent.jobId] = newEvent;
         }
         return *this;
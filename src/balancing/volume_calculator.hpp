@@ -46,6 +46,7 @@ public:
         // For each event
         if (_logging) LOG(V5_DEBG, "BLC Collecting %i entries\n", events.getEntries().size());
         _entries.reserve(events.getEntries().size());
+        int numCoHostedJobs = 0;
         for (const auto& [jobId, ev] : events.getEntries()) {
             assert(ev.demand >= 0);
             if (ev.demand == 0) _zero_entries.emplace_back(ev.jobId, ev.demand, ev.priority); // job has no demand
@@ -53,10 +54,19 @@ public:
                 assert((ev.priority > 0) || LOG_RETURN_FALSE("#%i has priority %.2f!\n", ev.jobId, ev.priority));
                 _entries.emplace_back(ev.jobId, ev.demand, ev.priority);
                 _sum_of_priorities += ev.priority;
+                if (ev.coHosted) numCoHostedJobs++;
             }
         }
 
         _available_volume = _num_workers * _params.loadFactor();
+
+        // A co-hosted light job shares the PE of another job, so the PE its volume
+        // accounts for is made available to the other jobs. Only co-hosting which
+        // actually takes place is credited, as reported by the jobs' roots.
+        if (numCoHostedJobs > 0) {
+            _available_volume += numCoHostedJobs;
+            if (_logging) LOG(V5_DEBG, "BLC %i co-hosted light jobs\n", numCoHostedJobs);
+        }
     }
 
     void calculateResult() {
@@ -85,9 +95,15 @@ public:
     const std::vector<BalancingEntry>& getEntries() {
         return _entries;
     }
+    std::vector<BalancingEntry>& getMutableEntries() {
+        return _entries;
+    }
     const std::vector<BalancingEntry>& getZeroEntries() {
         return _zero_entries;
     }
+    int getAvailableVolume() const {
+        return _available_volume;
+    }
 
 private:
 
@@ -0,0 +1,159 @@
+
+#ifndef DOMPASCH_MALLOB_VOLUME_HYSTERESIS_HPP
+#define DOMPASCH_MALLOB_VOLUME_HYSTERESIS_HPP
+
+#include <algorithm>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "balancing/balancing_entry.hpp"
+#include "balancing/event_map.hpp"
+#include "util/robin_hood.hpp"
+
+// Damps the volumes computed by the VolumeCalculator in order to reduce the
+// churn of job trees: each growth costs a description transfer and a spawn on
+// the new PEs, and each shrink a suspension. Every PE runs this with the same
+// input in the same sequence of balancing epochs, so all PEs agree on the
+// damped volumes without any further communication.
+// - A growth is deferred until the PE time withheld from the job by deferring
+//   it outweighs the expected startup cost of the new PEs (ski rental).
+//   The startup cost of a job is estimated at its root, see Event::startupCost.
+// - A shrink is deferred while the job's volume has changed within the last
+//   few epochs - unless other jobs need the PEs. This only holds for shrinks
+//   below the job's demand: a job whose demand dropped shrinks to it at once.
+// If disabled, the volumes are passed through and only the churn is counted.
+class VolumeHysteresis {
+
+public:
+    struct ChurnStats {
+        int numGrows {0};
+        int numShrinks {0};
+        int numSpawned {0}; // PEs added to the job tree, including its initial ones
+    };
+
+private:
+    struct JobState {
+        int volume;
+        int lastChangeEpoch;
+        int lastSeenEpoch;
+        double withheldTime {0}; // PE seconds withheld by deferring the pending growth
+        ChurnStats churn;
+    };
+
+    const bool _enabled;
+    const int _shrink_interval;
+    const float _epoch_duration;
+
+    robin_hood::unordered_map<int, JobState> _jobs;
+    ChurnStats _total_churn;
+    bool _has_deferred_changes {false};
+
+public:
+    // epochDuration: the (minimum) time between two balancing epochs
+    VolumeHysteresis(bool enabled, int shrinkInterval, float epochDuration) :
+        _enabled(enabled), _shrink_interval(shrinkInterval), _epoch_duration(epochDuration) {}
+
+    // Adjusts the volumes of the provided entries in place such that
+    // their sum does not exceed the available volume unless their original sum did.
+    void apply(int epoch, std::vector<BalancingEntry>& entries, const EventMap& events, int availableVolume) {
+
+        _has_deferred_changes = false;
+        std::vector<int> volumes(entries.size());
+        int sumOfVolumes = 0;
+        std::vector<size_t> heldShrinks;
+
+        for (size_t i = 0; i < entries.size(); i++) {
+            const auto& entry = entries[i];
+            volumes[i] = entry.volume;
+            auto it = _jobs.find(entry.jobId);
+            if (_enabled && it != _jobs.end()) {
+                JobState& job = it->second;
+                if (entry.volume > job.volume) {
+                    // Grow once the withheld PE time pays for starting up the new PEs
+                    auto evIt = events.getEntries().find(entry.jobId);
+                    const float startupCost = evIt == events.getEntries().end() ? 0 : evIt->second.startupCost;
+                    if (job.withheldTime < (entry.volume - job.volume) * startupCost) {
+                        job.withheldTime += (entry.volume - job.volume) * _epoch_duration;
+                        volumes[i] = job.volume;
+                        _has_deferred_changes = true;
+                    }
+                } else {
+                    job.withheldTime = 0;
+                    const int heldVolume = std::min(job.volume, entry.demand);
+                    if (entry.volume < heldVolume && epoch - job.lastChangeEpoch < _shrink_interval) {
+                        volumes[i] = heldVolume;
+                        heldShrinks.push_back(i);
+                        _has_deferred_changes = true;
+                    }
+                }
+            }
+            sumOfVolumes += volumes[i];
+        }
+
+        // Release held shrinks, largest first, as far as other jobs need the PEs
+        if (sumOfVolumes > availableVolume) {
+            std::sort(heldShrinks.begin(), heldShrinks.end(), [&](size_t a, size_t b) {
+                int excessA = volumes[a] - entries[a].volume;
+                int excessB = volumes[b] - entries[b].volume;
+                if (excessA != excessB) return excessA > excessB;
+                return entries[a].jobId < entries[b].jobId;
+            });
+            for (size_t i : heldShrinks) {
+                if (sumOfVolumes <= availableVolume) break;
+                sumOfVolumes -= volumes[i] - entries[i].volume;
+                volumes[i] = entries[i].volume;
+            }
+        }
+
+        for (size_t i = 0; i < entries.size(); i++) {
+            auto& entry = entries[i];
+            entry.volume = volumes[i];
+            auto [it, inserted] = _jobs.try_emplace(entry.jobId, JobState {0, epoch, epoch});
+            JobState& job = it->second;
+            job.lastSeenEpoch = epoch;
+            if (entry.volume > job.volume) {
+                if (!inserted) {
+                    job.churn.numGrows++;
+                    _total_churn.numGrows++;
+                }
+                job.churn.numSpawned += entry.volume - job.volume;
+                _total_churn.numSpawned += entry.volume - job.volume;
+                job.lastChangeEpoch = epoch;
+                job.withheldTime = 0;
+            } else if (entry.volume < job.volume) {
+                job.churn.numShrinks++;
+                _total_churn.numShrinks++;
+                job.lastChangeEpoch = epoch;
+            }
+            job.volume = entry.volume;
+        }
+
+        // Forget jobs which left the balancing
+        for (auto it = _jobs.begin(); it != _jobs.end();) {
+            if (it->second.lastSeenEpoch != epoch) it = _jobs.erase(it);
+            else ++it;
+        }
+    }
+
+    void clear() {
+        _jobs.clear();
+        _has_deferred_changes = false;
+    }
+
+    // Whether a growth or shrink was deferred in the last epoch, so that
+    // another epoch should be run even without any new events.
+    bool hasDeferredChanges() const {
+        return _has_deferred_changes;
+    }
+
+    ChurnStats getChurnStats(int jobId) const {
+        auto it = _jobs.find(jobId);
+        return it == _jobs.end() ? ChurnStats() : it->second.churn;
+    }
+    const ChurnStats& getTotalChurnStats() const {
+        return _total_churn;
+    }
+};
+
+#endif
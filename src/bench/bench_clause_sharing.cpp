@@ -0,0 +1,201 @@
+#include <stdlib.h>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "bench/microbench.hpp"
+#include "util/random.hpp"
+#include "util/logger.hpp"
+#include "util/sys/timer.hpp"
+#include "app/sat/data/clause.hpp"
+#include "app/sat/data/produced_clause_candidate.hpp"
+#include "app/sat/sharing/store/adaptive_clause_store.hpp"
+#include "app/sat/sharing/buffer/buffer_merger.hpp"
+#include "app/sat/sharing/buffer/buffer_reader.hpp"
+#include "app/sat/sharing/filter/exact_clause_filter.hpp"
+#include "app/sat/sharing/clause_logger.hpp"
+#include "util/sys/proc.hpp"
+
+// Synthetic clauses with sorted, distinct literals and plausible LBD values.
+std::vector<std::vector<int>> generateClauses(int numClauses, int maxLength, int numVars, int seed) {
+    SplitMix64Rng rng(seed);
+    std::vector<std::vector<int>> clauses(numClauses);
+    for (auto& lits : clauses) {
+        int length = 1 + rng() % maxLength;
+        while ((int) lits.size() < length) {
+            int lit = (1 + rng() % numVars) * (rng() % 2 == 0 ? 1 : -1);
+            if (std::find_if(lits.begin(), lits.end(), [&](int l) {return std::abs(l) == std::abs(lit);}) == lits.end())
+                lits.push_back(lit);
+        }
+        std::sort(lits.begin(), lits.end());
+    }
+    return clauses;
+}
+
+int getLbd(const std::vector<int>& lits) {
+    return std::max(1, std::min((int) lits.size(), 2 + (int) (lits.size() / 3)));
+}
+
+AdaptiveClauseStore::Setup getSetup(int numLiterals) {
+    AdaptiveClauseStore::Setup setup;
+    setup.numLiterals = numLiterals;
+    setup.maxEffectiveClauseLength = 20;
+    setup.maxLbdPartitionedSize = 2;
+    return setup;
+}
+
+// Arg 0: number of clauses to insert
+void BM_AdaptiveClauseStoreInsert(Microbench::State& state) {
+    const int numClauses = state.range(0);
+    auto clauses = generateClauses(numClauses, 20, 100'000, 1);
+    while (state.keepRunning()) {
+        AdaptiveClauseStore store(getSetup(numClauses * 4));
+        for (auto& lits : clauses) {
+            Microbench::doNotOptimize(store.addClause(Mallob::Clause(lits.data(), lits.size(), getLbd(lits))));
+        }
+    }
+    state.setItemsProcessed(state.iterations() * numClauses);
+}
+MALLOB_BENCHMARK(BM_AdaptiveClauseStoreInsert)->range(1'000, 100'000, 10);
+
+// Arg 0: number of clauses in the store
+void BM_AdaptiveClauseStoreExport(Microbench::State& state) {
+    const int numClauses = state.range(0);
+    auto clauses = generateClauses(numClauses, 20, 100'000, 2);
+    int numExportedClauses, numExportedLits;
+    while (state.keepRunning()) {
+        state.pauseTiming();
+        AdaptiveClauseStore store(getSetup(numClauses * 4));
+        for (auto& lits : clauses) store.addClause(Mallob::Clause(lits.data(), lits.size(), getLbd(lits)));
+        state.resumeTiming();
+        auto buf = store.exportBuffer(numClauses * 4, numExportedClauses, numExportedLits);
+        Microbench::doNotOptimize(buf.data());
+    }
+    state.setItemsProcessed(state.iterations() * numClauses);
+}
+MALLOB_BENCHMARK(BM_AdaptiveClauseStoreExport)->range(1'000, 100'000, 10);
+
+// Arg 0: number of clauses, arg 1: number of distinct clauses (controls the filtering rate)
+void BM_ExactClauseFilter(Microbench::State& state) {
+    const int numClauses = state.range(0);
+    const int numDistinct = state.range(1);
+    auto distinct = generateClauses(numDistinct, 20, 100'000, 3);
+    size_t nbAdmitted = 0;
+    while (state.keepRunning()) {
+        state.pauseTiming();
+        AdaptiveClauseStore store(getSetup(numClauses * 20));
+        ExactClauseFilter filter(store, /*epochHorizon=*/-1, /*maxEffClauseLength=*/20);
+        state.resumeTiming();
+        for (int i = 0; i < numClauses; i++) {
+            auto& lits = distinct[i % numDistinct];
+            ProducedClauseCandidate pcc(lits.data(), lits.size(), getLbd(lits), i % 8, 0);
+            if (filter.tryRegisterAndInsert(std::move(pcc)) == GenericClauseFilter::ADMITTED) nbAdmitted++;
+        }
+    }
+    state.setItemsProcessed(state.iterations() * numClauses);
+    state.counter("admitted_ratio") = nbAdmitted / (double) (state.iterations() * numClauses);
+}
+MALLOB_BENCHMARK(BM_ExactClauseFilter)->args({10'000, 10'000})->args({10'000, 1'000})->args({100'000, 100'000});
+
+// Arg 0: number of buffers to merge, arg 1: number of clauses per buffer
+void BM_BufferMerger(Microbench::State& state) {
+    const int numBuffers = state.range(0);
+    const int numClausesPerBuffer = state.range(1);
+    auto setup = getSetup(numClausesPerBuffer * 20);
+    std::vector<std::vector<int>> buffers;
+    int numExportedClauses, numExportedLits;
+    for (int b = 0; b < numBuffers; b++) {
+        AdaptiveClauseStore store(setup);
+        for (auto& lits : generateClauses(numClausesPerBuffer, 20, 100'000, 100+b))
+            store.addClause(Mallob::Clause(lits.data(), lits.size(), getLbd(lits)));
+        buffers.push_back(store.exportBuffer(setup.numLiterals, numExportedClauses, numExportedLits));
+    }
+    AdaptiveClauseStore store(setup);
+    size_t inputSize = 0;
+    for (auto& buf : buffers) inputSize += buf.size();
+    std::vector<int> excess;
+    while (state.keepRunning()) {
+        auto merger = store.getBufferMerger(setup.numLiterals);
+        for (auto& buf : buffers) merger.add(store.getBufferReader(buf.data(), buf.size()));
+        auto merged = merger.mergePreservingExcess(excess);
+        Microbench::doNotOptimize(merged.data());
+    }
+    state.setBytesProcessed(state.iterations() * inputSize * sizeof(int));
+}
+MALLOB_BENCHMARK(BM_BufferMerger)->args({2, 10'000})->args({8, 10'000})->args({32, 10'000});
+
+// Arg 0: number of clauses to log
+void BM_BinaryClauseLogger(Microbench::State& state) {
+    const int numClauses = state.range(0);
+    auto clauses = generateClauses(numClauses, 20, 100'000, 4);
+    const std::string path = "/tmp/mallob_bench_clause_log." + std::to_string(Proc::getPid());
+    while (state.keepRunning()) {
+        state.resumeTiming();
+        ClauseLogger logger(path, ClauseLogger::BINARY);
+        for (int i = 0; i < numClauses; i++) {
+            auto& lits = clauses[i];
+            logger.append(Mallob::Clause(lits.data(), lits.size(), getLbd(lits)), i / 1000, 1);
+        }
+        // Only measure the cost on the sharing path, not draining the writer
+        state.pauseTiming();
+    }
+    remove(path.c_str());
+    state.setItemsProcessed(state.iterations() * numClauses);
+}
+MALLOB_BENCHMARK(BM_BinaryClauseLogger)->range(10'000, 1'000'000, 10);
+
+// Replays a binary clause log (path in environment variable MALLOB_BENCH_CLAUSE_LOG,
+// otherwise a synthetic log) through a clause filter and a clause store, epoch by epoch.
+void BM_ClauseLogReplay(Microbench::State& state) {
+    std::string path = getenv("MALLOB_BENCH_CLAUSE_LOG") ? getenv("MALLOB_BENCH_CLAUSE_LOG") : "";
+    bool synthetic = path.empty();
+    if (synthetic) {
+        path = "/tmp/mallob_bench_clause_log_replay." + std::to_string(Proc::getPid());
+        ClauseLogger logger(path, ClauseLogger::BINARY);
+        auto clauses = generateClauses(20'000, 20, 100'000, 5);
+        for (int epoch = 0; epoch < 10; epoch++) for (int i = 0; i < 10'000; i++) {
+            auto& lits = clauses[(epoch * 1'000 + i) % clauses.size()]; // overlapping epochs
+            logger.append(Mallob::Clause(lits.data(), lits.size(), getLbd(lits)), epoch, 1 << (i % 4));
+        }
+    }
+    std::vector<std::vector<ClauseLogReader::LoggedClause>> epochs;
+    {
+        ClauseLogReader reader(path);
+        if (!reader.valid()) {
+            LOG(V1_WARN, "[WARN] Cannot read clause log %s\n", path.c_str());
+            return;
+        }
+        int epoch;
+        std::vector<ClauseLogReader::LoggedClause> clauses;
+        while (reader.readNextEpoch(epoch, clauses)) epochs.push_back(std::move(clauses));
+    }
+    if (synthetic) remove(path.c_str());
+
+    size_t numClauses = 0;
+    for (auto& epoch : epochs) numClauses += epoch.size();
+    size_t nbAdmitted = 0;
+    int numExportedClauses, numExportedLits;
+    while (state.keepRunning()) {
+        AdaptiveClauseStore store(getSetup(1'000'000));
+        ExactClauseFilter filter(store, /*epochHorizon=*/-1, /*maxEffClauseLength=*/20);
+        for (size_t e = 0; e < epochs.size(); e++) {
+            for (auto& cls : epochs[e]) {
+                if (cls.lits.size() > 20) continue;
+                ProducedClauseCandidate pcc(cls.lits.data(), cls.lits.size(), cls.lbd, 0, e);
+                if (filter.tryRegisterAndInsert(std::move(pcc)) == GenericClauseFilter::ADMITTED) nbAdmitted++;
+            }
+            auto buf = store.exportBuffer(1'000'000, numExportedClauses, numExportedLits);
+            Microbench::doNotOptimize(buf.data());
+        }
+    }
+    state.setItemsProcessed(state.iterations() * numClauses);
+    state.counter("admitted_ratio") = nbAdmitted / (double) std::max(1UL, state.iterations() * numClauses);
+}
+MALLOB_BENCHMARK(BM_ClauseLogReplay);
+
+int main(int argc, char *argv[]) {
+    Timer::init();
+    Random::init(rand(), rand());
+    Logger::init(0, V2_INFO);
+    return Microbench::runAll(argc, argv);
+}
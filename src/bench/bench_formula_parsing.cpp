@@ -0,0 +1,68 @@
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <string>
+#include <vector>
+
+#include "bench/microbench.hpp"
+#include "util/random.hpp"
+#include "util/logger.hpp"
+#include "util/params.hpp"
+#include "util/sys/timer.hpp"
+#include "data/job_description.hpp"
+#include "app/sat/parse/sat_reader.hpp"
+#include "app/sat/parse/serialized_formula_parser.hpp"
+
+Parameters params;
+
+size_t getFileSize(const std::string& path) {
+    struct stat st;
+    if (stat(path.c_str(), &st) != 0) return 0;
+    return st.st_size;
+}
+
+// Recorded input: parses the CNF file given as input.
+void BM_SatReader(Microbench::State& state) {
+    size_t numLits = 0;
+    while (state.keepRunning()) {
+        SatReader reader(params, state.input());
+        JobDescription desc(1, 1, 0);
+        bool success = reader.read(desc);
+        if (!success) abort();
+        numLits = desc.getNumFormulaLiterals();
+    }
+    state.setBytesProcessed(state.iterations() * getFileSize(state.input()));
+    state.setItemsProcessed(state.iterations() * numLits);
+}
+MALLOB_BENCHMARK(BM_SatReader)
+    ->input("instances/r3unsat_300.cnf")
+    ->input("instances/r3unknown_10k.cnf");
+
+// Synthetic input: arg 0 = number of clauses (of length 3), arg 1 = shuffle clauses (0/1)
+void BM_SerializedFormulaParser(Microbench::State& state) {
+    const int numClauses = state.range(0);
+    const bool shuffle = state.range(1) != 0;
+    SplitMix64Rng rng(1);
+    std::vector<int> payload;
+    for (int c = 0; c < numClauses; c++) {
+        for (int l = 0; l < 3; l++) payload.push_back((1 + rng() % (numClauses/4+1)) * (rng() % 2 == 0 ? 1 : -1));
+        payload.push_back(0);
+    }
+    while (state.keepRunning()) {
+        SerializedFormulaParser parser(Logger::getMainInstance(), payload.size(), payload.data(), numClauses);
+        if (shuffle) parser.shuffle(state.iterations());
+        int lit;
+        long sum = 0;
+        while (parser.getNextLiteral(lit)) sum += lit;
+        Microbench::doNotOptimize(sum);
+    }
+    state.setItemsProcessed(state.iterations() * payload.size());
+}
+MALLOB_BENCHMARK(BM_SerializedFormulaParser)
+    ->args({100'000, 0})->args({100'000, 1})->args({1'000'000, 0})->args({1'000'000, 1});
+
+int main(int argc, char *argv[]) {
+    Timer::init();
+    Random::init(rand(), rand());
+    Logger::init(0, V1_WARN);
+    return Microbench::runAll(argc, argv);
+}
@@ -0,0 +1,63 @@
+#include <stdlib.h>
+#include <unordered_map>
+#include <vector>
+
+#include "bench/microbench.hpp"
+#include "util/random.hpp"
+#include "util/logger.hpp"
+#include "util/sys/timer.hpp"
+#include "util/robin_hood.hpp"
+#include "util/tsl/robin_map.h"
+
+std::vector<uint64_t> generateKeys(size_t n, uint64_t seed) {
+    SplitMix64Rng rng(seed);
+    std::vector<uint64_t> keys(n);
+    for (auto& key : keys) key = rng();
+    return keys;
+}
+
+// Inserts all keys, then looks up each key and the same number of absent keys.
+template <typename Map>
+void runMapBenchmark(Microbench::State& state) {
+    const size_t n = state.range(0);
+    auto keys = generateKeys(n, 1);
+    auto absentKeys = generateKeys(n, 2);
+    while (state.keepRunning()) {
+        Map map;
+        for (size_t i = 0; i < n; i++) map[keys[i]] = i;
+        size_t found = 0;
+        for (size_t i = 0; i < n; i++) {
+            found += map.count(keys[i]);
+            found += map.count(absentKeys[i]);
+        }
+        Microbench::doNotOptimize(found);
+    }
+    state.setItemsProcessed(state.iterations() * 3 * n);
+}
+
+void BM_RobinHoodFlatMap(Microbench::State& state) {
+    runMapBenchmark<robin_hood::unordered_flat_map<uint64_t, size_t>>(state);
+}
+MALLOB_BENCHMARK(BM_RobinHoodFlatMap)->range(1'000, 1'000'000, 10);
+
+void BM_RobinHoodNodeMap(Microbench::State& state) {
+    runMapBenchmark<robin_hood::unordered_node_map<uint64_t, size_t>>(state);
+}
+MALLOB_BENCHMARK(BM_RobinHoodNodeMap)->range(1'000, 1'000'000, 10);
+
+void BM_TslRobinMap(Microbench::State& state) {
+    runMapBenchmark<tsl::robin_map<uint64_t, size_t>>(state);
+}
+MALLOB_BENCHMARK(BM_TslRobinMap)->range(1'000, 1'000'000, 10);
+
+void BM_StdUnorderedMap(Microbench::State& state) {
+    runMapBenchmark<std::unordered_map<uint64_t, size_t>>(state);
+}
+MALLOB_BENCHMARK(BM_StdUnorderedMap)->range(1'000, 1'000'000, 10);
+
+int main(int argc, char *argv[]) {
+    Timer::init();
+    Random::init(rand(), rand());
+    Logger::init(0, V1_WARN);
+    return Microbench::runAll(argc, argv);
+}
@@ -0,0 +1,55 @@
+#include <stdlib.h>
+#include <vector>
+
+#include "bench/microbench.hpp"
+#include "app/sat/proof/trusted/lrat_checker.hpp"
+#include "util/random.hpp"
+#include "util/logger.hpp"
+#include "util/sys/timer.hpp"
+
+// Checks a synthetic implication chain proof: original clauses (1), (-i i+1) for all i<n,
+// and (-n); each derived unit (i+1) follows from unit (i) and (-i i+1), the previous unit
+// is deleted after each step, and the final empty clause refutes (n) with (-n).
+// Arg 0: number of variables n
+void BM_LratCheckerImplicationChain(Microbench::State& state) {
+    const int n = state.range(0);
+    std::vector<int> orig {1, 0};
+    for (int i = 1; i < n; i++) {
+        orig.push_back(-i); orig.push_back(i+1); orig.push_back(0);
+    }
+    orig.push_back(-n); orig.push_back(0);
+    const u64 idOfNegatedLast = n+1;
+
+    while (state.keepRunning()) {
+        state.pauseTiming();
+        LratChecker chk(n);
+        bool ok = chk.loadOriginalClauses(orig.data(), orig.size());
+        state.resumeTiming();
+
+        u64 unitId = 1;
+        u64 nextId = idOfNegatedLast + 1;
+        for (int i = 1; ok && i < n; i++) {
+            int lit = i+1;
+            u64 hints[2] = {unitId, (u64) (1+i)};
+            ok = chk.addClause(nextId, &lit, 1, hints, 2);
+            ok = ok && chk.deleteClause(&unitId, 1);
+            unitId = nextId++;
+        }
+        u64 hints[2] = {unitId, idOfNegatedLast};
+        ok = ok && chk.addClause(nextId, nullptr, 0, hints, 2);
+        ok = ok && chk.validateUnsat();
+        if (!ok) {
+            LOG(V0_CRIT, "[ERROR] %s\n", chk.getErrorMessage());
+            abort();
+        }
+    }
+    state.setItemsProcessed(state.iterations() * n);
+}
+MALLOB_BENCHMARK(BM_LratCheckerImplicationChain)->range(1'000, 1'000'000, 10);
+
+int main(int argc, char *argv[]) {
+    Timer::init();
+    Random::init(rand(), rand());
+    Logger::init(0, V1_WARN);
+    return Microbench::runAll(argc, argv);
+}
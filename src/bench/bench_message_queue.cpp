@@ -0,0 +1,61 @@
+#include <stdlib.h>
+#include <vector>
+
+#include "mpi.h"
+#include "bench/microbench.hpp"
+#include "util/random.hpp"
+#include "util/logger.hpp"
+#include "util/params.hpp"
+#include "util/sys/timer.hpp"
+#include "util/sys/process.hpp"
+#include "comm/mympi.hpp"
+#include "comm/msg_queue/message_queue.hpp"
+#include "comm/msg_queue/message_handle.hpp"
+#include "comm/msg_queue/message_subscription.hpp"
+#include "data/serializable.hpp"
+#include "data/job_transfer.hpp"
+
+const int TAG_BENCH_LOOPBACK = 111;
+int numReceived = 0;
+
+// Loopback through the message queue of this rank: arg 0 = number of messages
+// sent at once, arg 1 = number of ints per message
+void BM_MessageQueueLoopback(Microbench::State& state) {
+    const int numMessages = state.range(0);
+    const int msgSize = state.range(1);
+    int rank = MyMpi::rank(MPI_COMM_WORLD);
+    auto& q = MyMpi::getMessageQueue();
+
+    std::vector<uint8_t> payload = IntVec(std::vector<int>(msgSize, 1)).serialize();
+
+    while (state.keepRunning()) {
+        numReceived = 0;
+        for (int i = 0; i < numMessages; i++) MyMpi::isendCopy(rank, TAG_BENCH_LOOPBACK, payload);
+        while (numReceived < numMessages) q.advance();
+    }
+    state.setItemsProcessed(state.iterations() * numMessages);
+    state.setBytesProcessed(state.iterations() * numMessages * payload.size());
+}
+MALLOB_BENCHMARK(BM_MessageQueueLoopback)
+    ->args({1, 1})->args({100, 1})->args({100, 1'000})->args({10, 1'000'000})->args({1, 10'000'000});
+
+int main(int argc, char *argv[]) {
+    MyMpi::init();
+    Timer::init();
+    int rank = MyMpi::rank(MPI_COMM_WORLD);
+    Process::init(rank);
+    Random::init(rand(), rand());
+    Logger::init(rank, V1_WARN);
+
+    Parameters params;
+    MyMpi::setOptions(params);
+
+    // Subscribe once: the message queue warns about repeated registrations for a tag
+    MessageSubscription sub(TAG_BENCH_LOOPBACK, [&](MessageHandle& h) {
+        numReceived++;
+        Microbench::doNotOptimize(h.getRecvData().data());
+    });
+    int exitCode = Microbench::runAll(argc, argv);
+    MPI_Finalize();
+    return exitCode;
+}
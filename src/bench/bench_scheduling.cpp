@@ -0,0 +1,40 @@
+#include <stdlib.h>
+#include <vector>
+
+#include "bench/microbench.hpp"
+#include "util/random.hpp"
+#include "util/logger.hpp"
+#include "util/params.hpp"
+#include "util/sys/timer.hpp"
+#include "balancing/volume_calculator.hpp"
+#include "balancing/event_map.hpp"
+
+Parameters params;
+
+// Arg 0: number of jobs, arg 1: number of workers
+void BM_VolumeCalculator(Microbench::State& state) {
+    const int numJobs = state.range(0);
+    const int numWorkers = state.range(1);
+    SplitMix64Rng rng(1);
+    EventMap map;
+    for (int id = 1; id <= numJobs; id++) {
+        int demand = 1 + rng() % (4 * numWorkers / numJobs + 1);
+        float priority = 0.01f + (rng() % 100) / 100.0f;
+        map.insertIfNovel(Event({id, /*epoch=*/1, demand, priority}));
+    }
+    while (state.keepRunning()) {
+        VolumeCalculator calc(map, params, numWorkers, /*logging=*/false);
+        calc.calculateResult();
+        Microbench::doNotOptimize(calc.getEntries().data());
+    }
+    state.setItemsProcessed(state.iterations() * numJobs);
+}
+MALLOB_BENCHMARK(BM_VolumeCalculator)
+    ->args({10, 100})->args({100, 1'000})->args({1'000, 10'000})->args({10'000, 10'000});
+
+int main(int argc, char *argv[]) {
+    Timer::init();
+    Random::init(rand(), rand());
+    Logger::init(0, V1_WARN);
+    return Microbench::runAll(argc, argv);
+}
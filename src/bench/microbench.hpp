@@ -0,0 +1,308 @@
+#pragma once
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <functional>
+#include <list>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "util/json.hpp"
+
+// CMAKE_BUILD_TYPE of the benchmark executables, set in new_bench()
+#ifndef MALLOB_BENCH_BUILD_TYPE
+#define MALLOB_BENCH_BUILD_TYPE "unknown"
+#endif
+
+// Minimal microbenchmark harness following the conventions of Google Benchmark:
+// Each benchmark is a function taking a State object and running its measured
+// code in a "while (state.keepRunning())" loop. The harness calibrates the number
+// of iterations to reach a minimum measurement time per run and reports real and
+// CPU time per iteration. Results are emitted in Google Benchmark's JSON format,
+// so that scripts/eval/compare_benchmarks.py (or Google's own compare.py) can
+// gate performance regressions.
+//
+// Command line options (to be given before any Mallob options):
+// -bench-filter=<substring>  only run benchmarks whose name contains the substring
+// -bench-out=<file>          write JSON results to the provided file
+// -bench-min-time=<secs>     min. measured time per run (default: 0.5)
+// -bench-reps=<n>            number of repetitions per benchmark (default: 1)
+namespace Microbench {
+
+    template <typename T>
+    inline void doNotOptimize(T const& value) {
+        asm volatile("" : : "r,m"(value) : "memory");
+    }
+
+    class State {
+
+    private:
+        const std::vector<long>& _args;
+        const std::string& _input;
+        size_t _max_iterations;
+        size_t _iterations {0};
+
+        double _real_start {0}, _cpu_start {0};
+        double _real_elapsed {0}, _cpu_elapsed {0};
+        bool _running {false};
+
+        size_t _items_processed {0};
+        size_t _bytes_processed {0};
+        std::map<std::string, double> _counters;
+
+    public:
+        State(const std::vector<long>& args, const std::string& input, size_t maxIterations) :
+            _args(args), _input(input), _max_iterations(maxIterations) {}
+
+        bool keepRunning() {
+            if (_iterations == 0) resumeTiming();
+            if (_iterations < _max_iterations) {
+                _iterations++;
+                return true;
+            }
+            pauseTiming();
+            return false;
+        }
+
+        // Exclude (expensive) setup inside the measured loop from the measurement.
+        void pauseTiming() {
+            if (!_running) return;
+            _real_elapsed += realNow() - _real_start;
+            _cpu_elapsed += cpuNow() - _cpu_start;
+            _running = false;
+        }
+        void resumeTiming() {
+            if (_running) return;
+            _real_start = realNow();
+            _cpu_start = cpuNow();
+            _running = true;
+        }
+
+        long range(size_t idx = 0) const {return _args.at(idx);}
+        const std::string& input() const {return _input;}
+        size_t iterations() const {return _iterations;}
+        void setItemsProcessed(size_t items) {_items_processed = items;}
+        void setBytesProcessed(size_t bytes) {_bytes_processed = bytes;}
+        double& counter(const std::string& name) {return _counters[name];}
+
+        double realSeconds() const {return _real_elapsed;}
+        double cpuSeconds() const {return _cpu_elapsed;}
+        size_t itemsProcessed() const {return _items_processed;}
+        size_t bytesProcessed() const {return _bytes_processed;}
+        const std::map<std::string, double>& counters() const {return _counters;}
+
+    private:
+        static double realNow() {
+            timespec ts; clock_gettime(CLOCK_MONOTONIC, &ts);
+            return ts.tv_sec + 1e-9 * ts.tv_nsec;
+        }
+        static double cpuNow() {
+            timespec ts; clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+            return ts.tv_sec + 1e-9 * ts.tv_nsec;
+        }
+    };
+
+    class Benchmark {
+
+    public:
+        std::string name;
+        std::function<void(State&)> fn;
+        std::vector<std::vector<long>> argSets;
+        std::vector<std::string> inputs;
+
+        Benchmark(const std::string& name, std::function<void(State&)> fn) : name(name), fn(fn) {}
+
+        // Run the benchmark for this parameter combination (in addition to previous ones).
+        Benchmark* args(const std::vector<long>& args) {
+            argSets.push_back(args);
+            return this;
+        }
+        Benchmark* arg(long arg) {
+            return args({arg});
+        }
+        // Run the benchmark for each argument x in {lo, lo*mult, lo*mult^2, ..., hi}.
+        Benchmark* range(long lo, long hi, long mult = 8) {
+            for (long x = lo; x < hi; x *= mult) arg(x);
+            return arg(hi);
+        }
+        // Run the benchmark on this input file (for each argument combination, if any).
+        Benchmark* input(const std::string& path) {
+            inputs.push_back(path);
+            return this;
+        }
+    };
+
+    inline std::list<Benchmark>& getRegistry() {
+        static std::list<Benchmark> registry;
+        return registry;
+    }
+
+    inline Benchmark* registerBenchmark(const std::string& name, std::function<void(State&)> fn) {
+        getRegistry().emplace_back(name, fn);
+        return &getRegistry().back();
+    }
+
+    struct Options {
+        std::string filter;
+        std::string outputFile;
+        double minTime {0.5};
+        int repetitions {1};
+    };
+
+    inline Options parseOptions(int argc, char** argv) {
+        Options opts;
+        for (int i = 1; i < argc; i++) {
+            std::string arg(argv[i]);
+            auto valueOf = [&](const std::string& key) -> const char* {
+                for (std::string prefix : {"-" + key + "=", "--" + key + "="}) {
+                    if (arg.rfind(prefix, 0) == 0) return argv[i] + prefix.size();
+                }
+                return nullptr;
+            };
+            if (auto val = valueOf("bench-filter")) opts.filter = val;
+            if (auto val = valueOf("bench-out")) opts.outputFile = val;
+            if (auto val = valueOf("bench-min-time")) opts.minTime = atof(val);
+            if (auto val = valueOf("bench-reps")) opts.repetitions = std::max(1, atoi(val));
+        }
+        return opts;
+    }
+
+    inline nlohmann::json toJson(const std::string& runName, const State& state, int repetition) {
+        const double realNsPerIt = 1e9 * state.realSeconds() / state.iterations();
+        const double cpuNsPerIt = 1e9 * state.cpuSeconds() / state.iterations();
+        nlohmann::json j {
+            {"name", runName},
+            {"run_name", runName},
+            {"run_type", "iteration"},
+            {"repetition_index", repetition},
+            {"iterations", state.iterations()},
+            {"real_time", realNsPerIt},
+            {"cpu_time", cpuNsPerIt},
+            {"time_unit", "ns"}
+        };
+        if (state.itemsProcessed() > 0 && state.realSeconds() > 0)
+            j["items_per_second"] = state.itemsProcessed() / state.realSeconds();
+        if (state.bytesProcessed() > 0 && state.realSeconds() > 0)
+            j["bytes_per_second"] = state.bytesProcessed() / state.realSeconds();
+        for (auto& [name, val] : state.counters()) j[name] = val;
+        return j;
+    }
+
+    inline std::vector<nlohmann::json> aggregate(const std::string& runName, const std::vector<nlohmann::json>& runs) {
+        std::vector<nlohmann::json> aggregates;
+        if (runs.size() <= 1) return aggregates;
+        for (std::string aggregateName : {"mean", "median", "stddev"}) {
+            nlohmann::json j {
+                {"name", runName + "_" + aggregateName},
+                {"run_name", runName},
+                {"run_type", "aggregate"},
+                {"aggregate_name", aggregateName},
+                {"iterations", runs.size()},
+                {"time_unit", "ns"}
+            };
+            for (std::string key : {"real_time", "cpu_time"}) {
+                std::vector<double> vals;
+                for (auto& run : runs) vals.push_back(run[key].get<double>());
+                std::sort(vals.begin(), vals.end());
+                double mean = 0;
+                for (double v : vals) mean += v / vals.size();
+                double result;
+                if (aggregateName == "mean") result = mean;
+                else if (aggregateName == "median") result = vals.size() % 2 == 1 ? vals[vals.size()/2]
+                    : 0.5 * (vals[vals.size()/2 - 1] + vals[vals.size()/2]);
+                else {
+                    double var = 0;
+                    for (double v : vals) var += (v-mean)*(v-mean) / (vals.size()-1);
+                    result = std::sqrt(var);
+                }
+                j[key] = result;
+            }
+            aggregates.push_back(std::move(j));
+        }
+        return aggregates;
+    }
+
+    // Runs all registered benchmarks matching the command line filter.
+    // Returns the program's exit code.
+    inline int runAll(int argc, char** argv) {
+
+        Options opts = parseOptions(argc, argv);
+        std::vector<nlohmann::json> results;
+
+        char hostname[256] = {0};
+        gethostname(hostname, sizeof(hostname)-1);
+        time_t now = time(nullptr);
+        char date[64];
+        strftime(date, sizeof(date), "%FT%T%z", localtime(&now));
+        nlohmann::json context {
+            {"date", date},
+            {"host_name", hostname},
+            {"executable", argv[0]},
+            {"num_cpus", sysconf(_SC_NPROCESSORS_ONLN)},
+            {"library_build_type", MALLOB_BENCH_BUILD_TYPE},
+            {"min_time", opts.minTime},
+        };
+
+        printf("%-60s %15s %15s %12s\n", "Benchmark", "Time", "CPU", "Iterations");
+        for (auto& bench : getRegistry()) {
+            std::vector<std::vector<long>> argSets = bench.argSets;
+            if (argSets.empty()) argSets.emplace_back();
+            std::vector<std::string> inputs = bench.inputs;
+            if (inputs.empty()) inputs.emplace_back();
+
+            for (auto& input : inputs) for (auto& args : argSets) {
+                std::string runName = bench.name;
+                if (!input.empty()) runName += "/" + input.substr(input.find_last_of('/')+1);
+                for (long a : args) runName += "/" + std::to_string(a);
+                if (runName.find(opts.filter) == std::string::npos) continue;
+
+                std::vector<nlohmann::json> runs;
+                for (int rep = 0; rep < opts.repetitions; rep++) {
+                    // Calibrate the number of iterations until the min. time is reached
+                    size_t iterations = 1;
+                    while (true) {
+                        State state(args, input, iterations);
+                        bench.fn(state);
+                        double secs = std::max(state.realSeconds(), state.cpuSeconds());
+                        if (secs >= opts.minTime || iterations >= 1'000'000'000) {
+                            printf("%-60s %12.0f ns %12.0f ns %12lu\n", runName.c_str(),
+                                1e9 * state.realSeconds() / iterations,
+                                1e9 * state.cpuSeconds() / iterations, iterations);
+                            fflush(stdout);
+                            runs.push_back(toJson(runName, state, rep));
+                            break;
+                        }
+                        // Extrapolate, overshooting a little, and grow at most by 10x
+                        double factor = secs <= 0 ? 10 : std::min(10.0, 1.4 * opts.minTime / secs);
+                        iterations = std::max(iterations+1, (size_t) std::ceil(iterations * factor));
+                    }
+                }
+                for (auto& run : runs) results.push_back(run);
+                for (auto& agg : aggregate(runName, runs)) results.push_back(agg);
+            }
+        }
+
+        if (!opts.outputFile.empty()) {
+            nlohmann::json out {{"context", context}, {"benchmarks", results}};
+            std::ofstream ofs(opts.outputFile);
+            if (!ofs.good()) {
+                fprintf(stderr, "Could not write benchmark results to %s\n", opts.outputFile.c_str());
+                return 1;
+            }
+            ofs << out.dump(2) << std::endl;
+        }
+        return 0;
+    }
+}
+
+#define MALLOB_BENCHMARK_CONCAT_INNER(a, b) a##b
+#define MALLOB_BENCHMARK_CONCAT(a, b) MALLOB_BENCHMARK_CONCAT_INNER(a, b)
+// Register a benchmark function: MALLOB_BENCHMARK(myFunction)->arg(1000)->arg(10000);
+#define MALLOB_BENCHMARK(fn) static Microbench::Benchmark* MALLOB_BENCHMARK_CONCAT(_microbench_, __LINE__) \
+    = Microbench::registerBenchmark(#fn, fn)
@@ -1,6 +1,7 @@
 
 #pragma once
 
+#include "data/reduceable.hpp"
 #include "data/serializable.hpp"
 #include "mympi.hpp"
 #include "util/tsl/robin_map.h"
@@ -49,29 +50,49 @@ private:
     // Callback definition for returning a result
     typedef std::function<void(std::list<T>&)> ResultCallback;
 
+    // Reduceables with a fixed-size representation (see data/reduceable.hpp)
+    typedef FlatReduceable<T> Flat;
+    static constexpr bool isFlat = Flat::enabled;
+
     // Serializable struct for an ID-qualified list of reduceables
     struct ReduceableList : public Serializable {
+        static constexpr size_t HEADER_SIZE = 4*sizeof(int);
         int instanceId {-1};
         int callId {-1};
         int contributionId {0};
         int resultCounter {0};
         std::list<T> items;
         virtual std::vector<uint8_t> serialize() const override {
-            std::vector<uint8_t> packed(4*sizeof(int));
-            memcpy(packed.data(), &instanceId, sizeof(int));
-            memcpy(packed.data()+sizeof(int), &callId, sizeof(int));
-            memcpy(packed.data()+2*sizeof(int), &contributionId, sizeof(int));
-            memcpy(packed.data()+3*sizeof(int), &resultCounter, sizeof(int));
-            int packedSize = packed.size();
-            for (auto& item : items) {
-                auto serializedItem = item.serialize();
-                int itemSize = serializedItem.size();
-                packed.resize(packedSize + sizeof(int) + itemSize);
-                memcpy(packed.data() + packedSize, &itemSize, sizeof(int));
-                memcpy(packed.data() + packedSize + sizeof(int), serializedItem.data(), itemSize);
-                packedSize = packed.size();
+            if constexpr (isFlat) {
+                // Fixed layout: header followed by the items' flat representations
+                typedef typename Flat::Flat FlatType;
+                static_assert(std::is_trivially_copyable<FlatType>::value);
+                std::vector<uint8_t> packed(HEADER_SIZE + items.size() * sizeof(FlatType));
+                writeHeader(packed);
+                size_t i = HEADER_SIZE;
+                for (auto& item : items) {
+                    FlatType flat = Flat::toFlat(item);
+                    memcpy(packed.data()+i, &flat, sizeof(FlatType)); i += sizeof(FlatType);
+                }
+                return packed;
+            } else {
+                // Serialize all items first in order to allocate the message only once
+                std::vector<std::vector<uint8_t>> serializedItems;
+                size_t packedSize = HEADER_SIZE;
+                for (auto& item : items) {
+                    serializedItems.push_back(item.serialize());
+                    packedSize += sizeof(int) + serializedItems.back().size();
+                }
+                std::vector<uint8_t> packed(packedSize);
+                writeHeader(packed);
+                size_t i = HEADER_SIZE;
+                for (auto& serializedItem : serializedItems) {
+                    int itemSize = serializedItem.size();
+                    memcpy(packed.data()+i, &itemSize, sizeof(int)); i += sizeof(int);
+                    memcpy(packed.data()+i, serializedItem.data(), itemSize); i += itemSize;
+                }
+                return packed;
             }
-            return packed;
         }
         virtual ReduceableList& deserialize(const std::vector<uint8_t>& packed) override {
             items.clear();
@@ -80,15 +101,45 @@ private:
             memcpy(&callId, packed.data()+i, sizeof(int)); i += sizeof(int);
             memcpy(&contributionId, packed.data()+i, sizeof(int)); i += sizeof(int);
             memcpy(&resultCounter, packed.data()+i, sizeof(int)); i += sizeof(int);
-            while (i < packed.size()) {
-                int itemSize;
-                memcpy(&itemSize, packed.data()+i, sizeof(int)); i += sizeof(int);
-                std::vector<uint8_t> serializedItem(itemSize);
-                memcpy(serializedItem.data(), packed.data()+i, itemSize); i += itemSize;
-                items.push_back(Serializable::get<T>(serializedItem));
+            if constexpr (isFlat) {
+                typedef typename Flat::Flat FlatType;
+                while (i < packed.size()) {
+                    FlatType flat;
+                    memcpy(&flat, packed.data()+i, sizeof(FlatType)); i += sizeof(FlatType);
+                    items.push_back(Flat::fromFlat(flat));
+                }
+            } else {
+                while (i < packed.size()) {
+                    int itemSize;
+                    memcpy(&itemSize, packed.data()+i, sizeof(int)); i += sizeof(int);
+                    std::vector<uint8_t> serializedItem(packed.data()+i, packed.data()+i+itemSize);
+                    i += itemSize;
+                    items.push_back(Serializable::get<T>(serializedItem));
+                }
             }
             return *this;
         }
+        // In-place modifications of a serialized flat list
+        static void writeContributionId(std::vector<uint8_t>& packed, int contributionId) {
+            memcpy(packed.data()+2*sizeof(int), &contributionId, sizeof(int));
+        }
+        template <typename FlatType>
+        static FlatType readFlatItem(const std::vector<uint8_t>& packed, int index) {
+            FlatType flat;
+            memcpy(&flat, packed.data() + HEADER_SIZE + index*sizeof(flat), sizeof(flat));
+            return flat;
+        }
+        template <typename FlatType>
+        static void writeFlatItem(std::vector<uint8_t>& packed, int index, const FlatType& flat) {
+            memcpy(packed.data() + HEADER_SIZE + index*sizeof(flat), &flat, sizeof(flat));
+        }
+    private:
+        void writeHeader(std::vector<uint8_t>& packed) const {
+            memcpy(packed.data(), &instanceId, sizeof(int));
+            memcpy(packed.data()+sizeof(int), &callId, sizeof(int));
+            memcpy(packed.data()+2*sizeof(int), &contributionId, sizeof(int));
+            memcpy(packed.data()+3*sizeof(int), &resultCounter, sizeof(int));
+        }
     };
 
     // Internal state for each ongoing collective operation
@@ -346,8 +397,9 @@ private:
 
         if (h.tag == MSG_ASYNC_COLLECTIVE_UP || h.tag == MSG_ASYNC_COLLECTIVE_DOWN) {
 
-            // Deserialize data
-            auto data = Serializable::get<ReduceableList>(h.getRecvData());
+            // Deserialize data (keeping the buffer for forwarding it in place)
+            std::vector<uint8_t> packed = h.moveRecvData();
+            auto data = Serializable::get<ReduceableList>(packed);
             if (data.instanceId != _instance_id) return; // matching instance ID?
             // Retrieve local state of the associated call
             auto& state = _states_by_id[data.callId];
@@ -363,7 +415,7 @@ private:
             
             // Broadcast
             if (h.tag == MSG_ASYNC_COLLECTIVE_DOWN) {
-                auto resultList = broadcastAndDigest(state.mode, data, state.contribLeft, state.contribSelf);
+                auto resultList = broadcastAndDigest(state.mode, data, packed, state.contribLeft, state.contribSelf);
                 state.cbResult(resultList); // publish result locally
                 _states_by_id.erase(data.callId); // clean up
             }
@@ -371,8 +423,9 @@ private:
 
         if (h.tag == MSG_ASYNC_SPARSE_COLLECTIVE_UP || h.tag == MSG_ASYNC_SPARSE_COLLECTIVE_DOWN) {
 
-            // Deserialize data
-            auto data = Serializable::get<ReduceableList>(h.getRecvData());
+            // Deserialize data (keeping the buffer for forwarding it in place)
+            std::vector<uint8_t> packed = h.moveRecvData();
+            auto data = Serializable::get<ReduceableList>(packed);
             if (data.instanceId != _instance_id) return; // matching instance ID?
             // Retrieve local state of the associated call
             auto& state = _sparse_states_by_id[data.callId];
@@ -407,12 +460,12 @@ private:
                     // Just forward everything, also with contribution ID 0
                     LOG(V6_DEBGV, "SPARSE got broadcast with no personal contribution from [%i]\n", h.source);
                     T emptyContrib;
-                    resultList = broadcastAndDigest(SPARSE_PREFIXSUM_INCL_EXCL_TOTAL, data, emptyContrib, emptyContrib);
+                    resultList = broadcastAndDigest(SPARSE_PREFIXSUM_INCL_EXCL_TOTAL, data, packed, emptyContrib, emptyContrib);
                 } else {
                     // DID contribute to this broadcast
                     LOG(V6_DEBGV, "SPARSE got broadcast with contribution ID %i from [%i]\n", contribId, h.source);
                     auto& bundle = state.bundlesByContribId[contribId];
-                    resultList = broadcastAndDigest(SPARSE_PREFIXSUM_INCL_EXCL_TOTAL, data, bundle.contribLeft, bundle.contribSelf,
+                    resultList = broadcastAndDigest(SPARSE_PREFIXSUM_INCL_EXCL_TOTAL, data, packed, bundle.contribLeft, bundle.contribSelf,
                         /*leftContribId=*/bundle.contribIdLeft, /*rightContribId=*/bundle.contribIdRight);
                 }
                 state.cbResult(resultList); // publish result locally
@@ -464,8 +517,10 @@ private:
         }
     }
 
-    std::list<T> broadcastAndDigest(Mode mode, ReduceableList& data, T& contribLeft, T& contribSelf,
-            int leftContribId = 0, int rightContribId = 0) {
+    // For flat reduceables, the received buffer packed (which data was deserialized from)
+    // is modified in place and forwarded instead of re-serializing data.
+    std::list<T> broadcastAndDigest(Mode mode, ReduceableList& data, std::vector<uint8_t>& packed,
+            T& contribLeft, T& contribSelf, int leftContribId = 0, int rightContribId = 0) {
 
         std::list<T> resultList;
         auto& elem = data.items.front();
@@ -474,10 +529,14 @@ private:
         if (mode == ALLREDUCE) {
 
             // AllReduction: just forward received data to children
-            if (_left_child_rank >= 0)
-                MyMpi::isend(_left_child_rank, MSG_ASYNC_COLLECTIVE_DOWN, data);
-            if (_right_child_rank >= 0)
-                MyMpi::isend(_right_child_rank, MSG_ASYNC_COLLECTIVE_DOWN, data);
+            if (_left_child_rank >= 0) {
+                if constexpr (isFlat) MyMpi::isendCopy(_left_child_rank, MSG_ASYNC_COLLECTIVE_DOWN, packed);
+                else MyMpi::isend(_left_child_rank, MSG_ASYNC_COLLECTIVE_DOWN, data);
+            }
+            if (_right_child_rank >= 0) {
+                if constexpr (isFlat) MyMpi::isend(_right_child_rank, MSG_ASYNC_COLLECTIVE_DOWN, std::move(packed));
+                else MyMpi::isend(_right_child_rank, MSG_ASYNC_COLLECTIVE_DOWN, data);
+            }
             // Store first and only deserialized item
             resultList.push_back(std::move(elem));
 
@@ -486,6 +545,27 @@ private:
             // Prefix sum.
             int msgTag = mode == SPARSE_PREFIXSUM_INCL_EXCL_TOTAL ? 
                 MSG_ASYNC_SPARSE_COLLECTIVE_DOWN : MSG_ASYNC_COLLECTIVE_DOWN;
+            if constexpr (isFlat) {
+                // Reduce on the received prefix, which is then overwritten in place
+                // and forwarded to the right child (keeping the total, if any)
+                auto prefix = ReduceableList::template readFlatItem<typename Flat::Flat>(packed, 0);
+                if (_left_child_rank >= 0) {
+                    ReduceableList::writeContributionId(packed, leftContribId);
+                    MyMpi::isendCopy(_left_child_rank, msgTag, packed);
+                    Flat::aggregate(prefix, Flat::toFlat(contribLeft));
+                }
+                if (mode != PREFIXSUM_INCL) resultList.push_back(Flat::fromFlat(prefix));
+                Flat::aggregate(prefix, Flat::toFlat(contribSelf));
+                if (_right_child_rank >= 0) {
+                    ReduceableList::writeFlatItem(packed, 0, prefix);
+                    ReduceableList::writeContributionId(packed, rightContribId);
+                    MyMpi::isend(_right_child_rank, msgTag, std::move(packed));
+                }
+                if (mode != PREFIXSUM_EXCL) resultList.push_back(Flat::fromFlat(prefix));
+                if (mode == PREFIXSUM_INCL_EXCL_TOTAL || mode == SPARSE_PREFIXSUM_INCL_EXCL_TOTAL)
+                    resultList.push_back(std::move(data.items.back()));
+                return resultList;
+            }
             // Send received data to left child and aggregate data with left child's data
             if (_left_child_rank >= 0) {
                 data.contributionId = leftContribId;
@@ -500,10 +580,10 @@ private:
             elem.aggregate(contribSelf);
             // Send inclusive result to right child
             if (_right_child_rank >= 0) {
-                auto packed = mode == PREFIXSUM_INCL_EXCL_TOTAL || mode == SPARSE_PREFIXSUM_INCL_EXCL_TOTAL ? 
+                auto packedRight = mode == PREFIXSUM_INCL_EXCL_TOTAL || mode == SPARSE_PREFIXSUM_INCL_EXCL_TOTAL ? 
                     serialize(data.callId, elem, data.items.back(), rightContribId) : 
                     serialize(data.callId, elem, rightContribId);
-                MyMpi::isend(_right_child_rank, msgTag, std::move(packed));
+                MyMpi::isend(_right_child_rank, msgTag, std::move(packedRight));
             }
             // Store inclusive result
             if (mode != PREFIXSUM_EXCL) {
@@ -7,6 +7,7 @@
 #include "app/job_tree.hpp"
 #include "util/logger.hpp"
 #include "util/sys/thread_pool.hpp"
+#include "util/sys/timer.hpp"
 #include "data/job_transfer.hpp"
 
 class JobTreeAllReduction {
@@ -49,6 +50,11 @@ private:
     bool _has_transformation_at_root = false;
     std::function<AllReduceElement(const AllReduceElement&)> _transformation_at_root;
 
+    // Anytime mode: max. time to wait for child elements once the local element is present
+    float _child_deadline = 0;
+    float _time_of_local_elem = 0;
+    int _num_missed_child_elems = 0;
+
     bool _has_producer = false;
     bool _reduction_locally_done = false;
     bool _finished = false;
@@ -102,6 +108,17 @@ public:
         assert(!_has_producer);
         _has_producer = true;
         _local_elem = localProducer();
+        _time_of_local_elem = Timer::elapsedSeconds();
+    }
+
+    // Enable the anytime mode: Once the local element is present, wait at most
+    // the given number of seconds for the child elements. After that, aggregate
+    // and forward whatever arrived. Children which missed the deadline still
+    // receive the broadcast; their late elements are rejected by receive().
+    // If this node itself missed its parent's deadline, the broadcast may arrive
+    // before its elements were forwarded - see extractUnforwardedElems().
+    void setChildDeadline(float seconds) {
+        _child_deadline = seconds;
     }
 
     void setTransformationOfElementAtRoot(std::function<AllReduceElement(const AllReduceElement&)> transformation) {
@@ -158,6 +175,15 @@ public:
 
         if (_finished) return *this;
 
+        if (_child_deadline > 0 && _local_elem.has_value() && _child_elems.size() < _num_expected_child_elems
+                && Timer::elapsedSeconds() - _time_of_local_elem >= _child_deadline) {
+            // Deadline passed: give up on the remaining children
+            _num_missed_child_elems = _num_expected_child_elems - _child_elems.size();
+            LOG(V4_VVER, "CS deadline passed - forwarding %i/%i child elems\n",
+                _child_elems.size(), _num_expected_child_elems);
+            _num_expected_child_elems = _child_elems.size();
+        }
+
         if (_child_elems.size() == _num_expected_child_elems && _local_elem.has_value()) {
              
             _child_elems.insert({-1, std::move(_local_elem.value())});
@@ -220,6 +246,8 @@ public:
     }
 
     bool hasProducer() const {return _has_producer;}
+    // The number of child elements which were not waited for due to the deadline.
+    int getNumMissedChildElems() const {return _num_missed_child_elems;}
     bool isValid() const {return _valid;}
 
     // Whether the final result to the all-reduction is present.
@@ -233,6 +261,29 @@ public:
         return std::move(_base_msg.payload);
     }
 
+    // Anytime mode: The elements which did not make it into the final result
+    // because the broadcast arrived before this node forwarded its aggregate,
+    // i.e., the local element and the arrived child elements - or their aggregate
+    // if the aggregation had already begun (in which case this call waits for it).
+    // Returns an empty list if the aggregate was forwarded, if the final result
+    // is not present yet, or on a second call.
+    std::list<AllReduceElement> extractUnforwardedElems() {
+        std::list<AllReduceElement> elems;
+        if (!_finished || _reduction_locally_done) return elems;
+        _reduction_locally_done = true;
+        if (_future_aggregate.valid()) {
+            _future_aggregate.get();
+            if (_aggregated_elem.has_value()) elems.push_back(std::move(_aggregated_elem.value()));
+            _aggregated_elem.reset();
+            return elems;
+        }
+        if (_local_elem.has_value()) elems.push_back(std::move(_local_elem.value()));
+        _local_elem.reset();
+        for (auto& childElem : _child_elems) elems.push_back(std::move(childElem.elem));
+        _child_elems.clear();
+        return elems;
+    }
+
     // Whether this object can be destructed at this point in time 
     // without waiting for another thread.
     bool isDestructible() const {
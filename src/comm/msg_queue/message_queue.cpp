@@ -18,6 +18,11 @@
 #include "util/sys/atomics.hpp"                 // for incrementRelaxed, dec...
 #include "util/sys/background_worker.hpp"       // for BackgroundWorker
 #include "util/sys/proc.hpp"                    // for Proc
+#include "util/sys/counter_registry.hpp"        // for Counter
+
+static Counter cntSentMessages("msgq.sent_msgs");
+static Counter cntSentBytes("msgq.sent_bytes");
+static Counter cntReceivedMessages("msgq.recv_msgs");
 
 
 MessageQueue::MessageQueue(int maxMsgSize) : _max_msg_size(maxMsgSize) {
@@ -104,6 +109,8 @@ int MessageQueue::send(const DataPtr& data, int dest, int tag) {
     _send_queue.emplace_back(_running_send_id++, dest, tag, data, _max_msg_size);
     SendHandle& h = _send_queue.back();
     h.printSendMsg();
+    cntSentMessages.add();
+    cntSentBytes.add(data->size());
     if (_num_concurrent_sends < _max_concurrent_sends) {
         h.sendNext(_max_msg_size);
         _num_concurrent_sends++;
@@ -430,6 +437,7 @@ void MessageQueue::processSent() {
 void MessageQueue::digestReceivedMessage(MessageHandle& h) {
 
     auto& callbacks = _callbacks.at(h.tag);
+    cntReceivedMessages.add();
 
     if (callbacks.size() == 1) {
         callbacks.front()(h);
@@ -187,4 +187,7 @@ const int MSG_NOTIFY_READY_FOR_PROOF_SAFE_SHARING = 424;
 const int MSG_REQUEST_HISTORIC_CLAUSES = 425;
 const int MSG_FORWARD_HISTORIC_CLAUSES = 426;
 
+const int MSG_REQUEST_CLAUSE_SNAPSHOT = 427;
+const int MSG_FORWARD_CLAUSE_SNAPSHOT = 428;
+
 #endif
\ No newline at end of file
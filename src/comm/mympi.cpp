@@ -83,6 +83,18 @@ MPI_Request MyMpi::iallgather(MPI_Comm communicator, float* contribution, float*
     return req;
 }
 
+MPI_Request MyMpi::iallreduce(MPI_Comm communicator, double* contribution, double* result, int numDoubles, MPI_Op operation) {
+    MPI_Request req;
+    MPICALL(MPI_Iallreduce(contribution, result, numDoubles, MPI_DOUBLE, operation, communicator, &req), std::string("iallreduce"));
+    return req;
+}
+
+MPI_Request MyMpi::iallgather(MPI_Comm communicator, double* contribution, double* result, int numDoubles) {
+    MPI_Request req;
+    MPICALL(MPI_Iallgather(contribution, numDoubles, MPI_DOUBLE, result, numDoubles, MPI_DOUBLE, communicator, &req), std::string("iallgather"));
+    return req;
+}
+
 int MyMpi::size(MPI_Comm comm) {
     int size = 0;
     MPICALL(MPI_Comm_size(comm, &size), std::string("commSize"))
@@ -39,6 +39,8 @@ public:
     static MPI_Request iallreduce(MPI_Comm communicator, float* contribution, float* result, int numFloats, MPI_Op operation = MPI_SUM);
 
     static MPI_Request iallgather(MPI_Comm communicator, float* contribution, float* result, int numFloats);
+    static MPI_Request iallreduce(MPI_Comm communicator, double* contribution, double* result, int numDoubles, MPI_Op operation = MPI_SUM);
+    static MPI_Request iallgather(MPI_Comm communicator, double* contribution, double* result, int numDoubles);
 
     enum BufferQueryMode {LEVEL=0, LIMITED=1};
     static size_t getBinaryTreeBufferLimit(int numWorkers, int baseSize, float functionParam, BufferQueryMode mode);
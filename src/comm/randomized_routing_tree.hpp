@@ -5,6 +5,7 @@
 #include "mympi.hpp"
 #include "util/permutation.hpp"
 #include "util/random.hpp"
+#include "util/sys/fileutils.hpp"
 
 class RandomizedRoutingTree {
 
@@ -41,7 +42,7 @@ public:
         }  
 
         // Create graph, get outgoing edges from this node
-        auto permutations = AdjustablePermutation::getPermutations(_num_workers, numBounceAlternatives);
+        auto permutations = getPermutations(numBounceAlternatives);
         _hop_destinations = AdjustablePermutation::createExpanderGraph(permutations, _world_rank);
         
         // Output found bounce alternatives
@@ -55,6 +56,32 @@ public:
         _neighbor_towards_rank = AdjustablePermutation::getBestOutgoingEdgeForEachNode(permutations, _world_rank);
     }
 
+private:
+    std::vector<std::vector<int>> getPermutations(int numBounceAlternatives) {
+        if (_params.routingCacheDirectory().empty())
+            return AdjustablePermutation::getPermutations(_num_workers, numBounceAlternatives);
+
+        // The permutations only depend on the number of workers, the number of bounce
+        // alternatives, and the global random seed (see Random::init).
+        int globalSeed = MyMpi::size(MPI_COMM_WORLD) + _params.seed();
+        std::string file = _params.routingCacheDirectory() + "/mallob_routing.n" + std::to_string(_num_workers)
+            + ".r" + std::to_string(numBounceAlternatives) + ".s" + std::to_string(globalSeed) + ".bin";
+        std::vector<std::vector<int>> permutations;
+        if (AdjustablePermutation::readPermutations(file, _num_workers, numBounceAlternatives, permutations)) {
+            LOG(V4_VVER, "Read routing graph from %s\n", file.c_str());
+            return permutations;
+        }
+        permutations = AdjustablePermutation::getPermutations(_num_workers, numBounceAlternatives);
+        if (_world_rank == 0) {
+            FileUtils::mkdir(_params.routingCacheDirectory());
+            if (AdjustablePermutation::writePermutations(file, permutations))
+                LOG(V3_VERB, "Cached routing graph at %s\n", file.c_str());
+            else LOG(V1_WARN, "[WARN] Could not cache routing graph at %s\n", file.c_str());
+        }
+        return permutations;
+    }
+
+public:
     void setEpoch(int epoch) {
         _epoch = epoch;
     }
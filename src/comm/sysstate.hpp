@@ -6,6 +6,7 @@
 
 #include <vector>
 #include <atomic>
+#include <string>
 
 bool SysState_isUnresponsiveNodeCrashingEnabled();
 void SysState_disableUnresponsiveNodeCrashing();
@@ -22,8 +23,13 @@ private:
     SysStateCollective _collective;
     MPI_Op _op;
 
-    float _local_state[N];
-    std::vector<float> _global_state;
+    double _local_state[N];
+    std::vector<double> _send_buffer;
+    std::vector<double> _global_state;
+
+    // Registered counters (see CounterRegistry) which are appended to the local state
+    std::vector<std::string> _counter_names;
+    std::vector<int> _counter_ids;
     MPI_Request _request = MPI_REQUEST_NULL;
     bool _aggregating = false;
 
@@ -33,15 +39,19 @@ private:
     static std::atomic_bool _crash_if_unresponsive;
 
 public:
-    SysState(MPI_Comm& comm, float period, SysStateCollective collective, MPI_Op operation = MPI_SUM);
+    // If includeCounters is set, the values of all counters registered at this point
+    // are aggregated as well (requires an all-reduction with MPI_SUM).
+    SysState(MPI_Comm& comm, float period, SysStateCollective collective, MPI_Op operation = MPI_SUM, bool includeCounters = false);
     bool isAggregating() const;
     bool canStartAggregating(float time) const;
     void setLocal(int pos, float val);
     void setLocal(std::initializer_list<float> elems);
     void addLocal(int pos, float val);
     bool aggregate(float elapsedTime = -1);
-    float* getLocal();
-    const std::vector<float>& getGlobal();
+    double* getLocal();
+    const std::vector<double>& getGlobal();
+    // Aggregated values of all included counters as of the last aggregation
+    std::vector<std::pair<std::string, double>> getGlobalCounters() const;
     ~SysState();
 };
 
@@ -3,15 +3,23 @@
 #define DOMPASCH_MALLOB_SYSSTATE_IMPL_HPP
 
 #include "util/sys/timer.hpp"
+#include "util/sys/counter_registry.hpp"
 #include "sysstate.hpp"
 
 template <int N>
-SysState<N>::SysState(MPI_Comm& comm, float period, SysStateCollective collective, MPI_Op operation): 
+SysState<N>::SysState(MPI_Comm& comm, float period, SysStateCollective collective, MPI_Op operation, bool includeCounters): 
         _comm(comm), _period(period), _collective(collective), _op(operation) {
-    
-    _global_state.resize(N * (_collective == ALLGATHER ? MyMpi::size(comm) : 1), 0);
+
+    if (includeCounters) {
+        assert(_collective == ALLREDUCE && _op == MPI_SUM);
+        _counter_names = CounterRegistry::getNames();
+        for (auto& name : _counter_names) _counter_ids.push_back(CounterRegistry::getId(name));
+    }
+    const size_t size = N + _counter_ids.size();
+    _send_buffer.resize(size, 0);
+    _global_state.resize(size * (_collective == ALLGATHER ? MyMpi::size(comm) : 1), 0);
     for (size_t i = 0; i < N; i++)
-        _local_state[i] = 0.0f;
+        _local_state[i] = 0.0;
 }
 
 template <int N>
@@ -49,10 +57,14 @@ bool SysState<N>::aggregate(float elapsedTime) {
         float timeSinceLast = time-_last_aggregation;
         if (!_aggregating && timeSinceLast >= _period) {
             _last_aggregation = time;
+            // Copy the local state, which may change during the non-blocking collective
+            for (size_t i = 0; i < N; i++) _send_buffer[i] = _local_state[i];
+            for (size_t i = 0; i < _counter_ids.size(); i++)
+                _send_buffer[N+i] = CounterRegistry::get(_counter_ids[i]);
             if (_collective == ALLREDUCE) {
-                _request = MyMpi::iallreduce(_comm, _local_state, _global_state.data(), N, _op);
+                _request = MyMpi::iallreduce(_comm, _send_buffer.data(), _global_state.data(), _send_buffer.size(), _op);
             } else /*allgather*/ {
-                _request = MyMpi::iallgather(_comm, _local_state, _global_state.data(), N);
+                _request = MyMpi::iallgather(_comm, _send_buffer.data(), _global_state.data(), _send_buffer.size());
             }
             _aggregating = true;
         } else if (_aggregating) {
@@ -74,12 +86,20 @@ bool SysState<N>::aggregate(float elapsedTime) {
 }
 
 template <int N>
-const std::vector<float>& SysState<N>::getGlobal() {
+const std::vector<double>& SysState<N>::getGlobal() {
     return _global_state;
 }
 
 template <int N>
-float* SysState<N>::getLocal() {
+std::vector<std::pair<std::string, double>> SysState<N>::getGlobalCounters() const {
+    std::vector<std::pair<std::string, double>> counters;
+    for (size_t i = 0; i < _counter_names.size(); i++)
+        counters.emplace_back(_counter_names[i], _global_state[N+i]);
+    return counters;
+}
+
+template <int N>
+double* SysState<N>::getLocal() {
     return _local_state;
 }
 
@@ -89,7 +109,8 @@ SysState<N>::~SysState() {
         // It would be a violation to clean up the buffer while MPI is still accessing it
         // and the collective operation cannot be cancelled easily. So we extract the buffer
         // so that it won't be freed.
-        std::vector<float>* releasedData = new std::vector<float>(std::move(_global_state));
+        new std::vector<double>(std::move(_send_buffer));
+        std::vector<double>* releasedData = new std::vector<double>(std::move(_global_state));
         // TODO Move to some structure which gets cleaned up AFTER MPI messages ...
     }
 }
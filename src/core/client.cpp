@@ -158,13 +158,24 @@ void Client::readIncomingJobs() {
                             id, filesList.c_str(), time, foundJob.description->getNumFormulaLiterals(), 
                             foundJob.description->getNumAssumptionLiterals());
                     foundJob.description->getStatistics().parseTime = time;
-                    
-                    // Enqueue in ready jobs
-                    auto lock = _ready_job_lock.getLock();
-                    _ready_job_queue.push_back(std::move(foundJob.description));
-                    atomics::incrementRelaxed(_num_ready_jobs);
-                    atomics::incrementRelaxed(_num_loaded_jobs);
-                    _sys_state.addLocal(SYSSTATE_PARSED_JOBS, 1);
+
+                    auto reconstructor = preprocessJob(*foundJob.description, log);
+                    if (tryQuickSolve(*foundJob.description, log, reconstructor)) {
+                        // Job is done already - never introduce it to the workers
+                        _sys_state.addLocal(SYSSTATE_PARSED_JOBS, 1);
+                    } else {
+                        tuneJob(*foundJob.description);
+                        if (reconstructor) {
+                            auto lock = _solution_reconstructors_lock.getLock();
+                            _solution_reconstructors[id] = std::move(reconstructor);
+                        }
+                        // Enqueue in ready jobs
+                        auto lock = _ready_job_lock.getLock();
+                        _ready_job_queue.push_back(std::move(foundJob.description));
+                        atomics::incrementRelaxed(_num_ready_jobs);
+                        atomics::incrementRelaxed(_num_loaded_jobs);
+                        _sys_state.addLocal(SYSSTATE_PARSED_JOBS, 1);
+                    }
                 }
 
                 delete foundJobPtr;
@@ -185,6 +196,84 @@ void Client::readIncomingJobs() {
     log.flush();
 }
 
+// Lets the job's application simplify a freshly parsed job in the calling
+// (reader) thread. Returns the function which maps a result of the simplified
+// job back to the original job, or an empty function if nothing was changed.
+app_registry::JobSolutionReconstructor Client::preprocessJob(JobDescription& desc, Logger& log) {
+
+    // Only plain, non-incremental jobs: later revisions and assumptions
+    // refer to the original variables
+    if (desc.isIncremental() || desc.getRevision() > 0 || desc.getNumAssumptionLiterals() > 0)
+        return app_registry::JobSolutionReconstructor();
+    auto preprocessor = app_registry::getJobPreprocessor(desc.getApplicationId());
+    if (!preprocessor) return app_registry::JobSolutionReconstructor();
+
+    float time = Timer::elapsedSeconds();
+    auto reconstructor = preprocessor(_params, desc);
+    time = Timer::elapsedSeconds() - time;
+    if (reconstructor) {
+        LOGGER(log, V3_VERB, "[T] Preprocessed job #%i in %.3fs: %ld lits w/ separators remain\n",
+            desc.getId(), time, desc.getNumFormulaLiterals());
+    }
+    return reconstructor;
+}
+
+// Lets the job's application adjust the configuration of a parsed (and possibly
+// preprocessed) job in the calling (reader) thread before it is introduced to the workers.
+void Client::tuneJob(JobDescription& desc) {
+    auto tuner = app_registry::getJobTuner(desc.getApplicationId());
+    if (tuner) tuner(_params, desc);
+}
+
+// Attempts to solve a freshly parsed job within a small budget in the calling
+// (reader) thread. If successful, the result is reported right away and the job
+// is marked as done without ever being introduced to the workers.
+bool Client::tryQuickSolve(JobDescription& desc, Logger& log, const app_registry::JobSolutionReconstructor& reconstructor) {
+
+    if (_params.quickSolveConflicts() == 0) return false;
+    // Mono mode and solution files expect results via the usual result path
+    if (_params.monoFilename.isSet() || _params.solutionToFile.isSet()) return false;
+    // Only plain, non-incremental jobs of moderate size
+    if (desc.isIncremental() || desc.getRevision() > 0 || desc.getNumAssumptionLiterals() > 0
+        || desc.getNumFormulaLiterals() > _params.quickSolveMaxLiterals()) return false;
+    auto quickSolver = app_registry::getJobQuickSolver(desc.getApplicationId());
+    if (!quickSolver) return false;
+
+    const int jobId = desc.getId();
+    float time = Timer::elapsedSeconds();
+    JobResult result;
+    result.id = jobId;
+    result.revision = desc.getRevision();
+    result.winningInstanceId = -1;
+    result.globalStartOfSuccessEpoch = 0;
+    bool solved = quickSolver(_params, desc, result);
+    time = Timer::elapsedSeconds() - time;
+    if (!solved) {
+        LOGGER(log, V4_VVER, "[T] Quick solving #%i unsuccessful after %.3fs\n", jobId, time);
+        return false;
+    }
+
+    if (reconstructor) reconstructor(result);
+
+    auto& stats = desc.getStatistics();
+    stats.processingTime = time;
+    stats.usedWallclockSeconds = time;
+    stats.usedCpuSeconds = time;
+    LOGGER(log, V3_VERB, "[T] Quick-solved #%i in %.3fs\n", jobId, time);
+    LOGGER(log, V2_INFO, "RESPONSE_TIME #%i %.6f rev. %i\n", jobId, Timer::elapsedSeconds()-desc.getArrival(), result.revision);
+    LOGGER(log, V2_INFO, "SOLUTION #%i %s rev. %i\n", jobId, result.result == RESULT_SAT ? "SAT" : "UNSAT", result.revision);
+
+    if (_json_interface) _json_interface->handleJobDone(std::move(result), stats, desc.getApplicationId());
+    {
+        auto lock = _done_job_lock.getLock();
+        _done_jobs[jobId] = DoneInfo{desc.getRevision(), desc.getChecksum()};
+    }
+    // system state is updated by the main thread
+    atomics::incrementRelaxed(_num_new_quick_solved_jobs);
+    _incoming_job_cond_var.notify(); // jobs depending on this one might be eligible now
+    return true;
+}
+
 void Client::handleNewJob(JobMetadata&& data) {
 
     if (data.done) {
@@ -369,16 +458,27 @@ void Client::advance() {
     // to outside events without too much latency)
     introduceNextJob();
     
+    // Account for jobs which were solved directly after parsing
+    if (_num_new_quick_solved_jobs.load(std::memory_order_relaxed) > 0) {
+        int numQuickSolved = _num_new_quick_solved_jobs.exchange(0, std::memory_order_relaxed);
+        _sys_state.addLocal(SYSSTATE_QUICKSOLVED_JOBS, numQuickSolved);
+        _sys_state.addLocal(SYSSTATE_PROCESSED_JOBS, numQuickSolved);
+        _sys_state.addLocal(SYSSTATE_SUCCESSFUL_JOBS, numQuickSolved);
+    }
+
     // Advance an all-reduction of the current system state
     if (_sys_state.aggregate(time)) {
-        const std::vector<float>& result = _sys_state.getGlobal();
+        const auto& result = _sys_state.getGlobal();
         if (MyMpi::rank(_comm) == 0) {
-            LOG(V2_INFO, "sysstate entered=%i parsed=%i scheduled=%i processed=%i successful=%i\n",
+            int processed = (int)result[SYSSTATE_PROCESSED_JOBS];
+            int quickSolved = (int)result[SYSSTATE_QUICKSOLVED_JOBS];
+            LOG(V2_INFO, "sysstate entered=%i parsed=%i scheduled=%i processed=%i successful=%i quicksolved=%i (%.3f of processed)\n",
                 (int)result[SYSSTATE_ENTERED_JOBS], 
                 (int)result[SYSSTATE_PARSED_JOBS], 
                 (int)result[SYSSTATE_SCHEDULED_JOBS],
-                (int)result[SYSSTATE_PROCESSED_JOBS],
-                (int)result[SYSSTATE_SUCCESSFUL_JOBS]);
+                processed,
+                (int)result[SYSSTATE_SUCCESSFUL_JOBS],
+                quickSolved, processed > 0 ? quickSolved / (float) processed : 0.f);
         }
     }
 
@@ -478,6 +578,8 @@ void Client::introduceNextJob() {
         /*requestedNodeIndex=*/0, /*timeOfBirth=*/time, /*balancingEpoch=*/-1, /*numHops=*/0, job.isIncremental());
     req.revision = job.getRevision();
     req.timeOfBirth = job.getArrival();
+    req.light = _params.lightJobThreshold() > 0 && !job.isIncremental()
+        && job.getNumFormulaLiterals() <= (size_t) _params.lightJobThreshold();
 
     LOG_ADD_DEST(V2_INFO, "Introducing job #%i rev. %i : %s", nodeRank, jobId, req.revision, req.toStr().c_str());
     if (job.isIncremental() && req.revision > 0) {
@@ -557,6 +659,18 @@ void Client::handleSendJobResult(MessageHandle& handle) {
         _sys_state.addLocal(SYSSTATE_SUCCESSFUL_JOBS, 1);
     }
 
+    // Map the result back to the original job if the client preprocessed it
+    app_registry::JobSolutionReconstructor reconstructor;
+    {
+        auto lock = _solution_reconstructors_lock.getLock();
+        auto it = _solution_reconstructors.find(jobId);
+        if (it != _solution_reconstructors.end()) reconstructor = it->second;
+    }
+    if (reconstructor) reconstructor(jobResult);
+
+    auto observer = app_registry::getJobResultObserver(desc.getApplicationId());
+    if (observer) observer(_params, desc, jobResult);
+
     // Disable all watchdogs to avoid crashes while printing a huge model
     Watchdog::disableGlobally();
 
@@ -623,6 +737,17 @@ void Client::handleAbort(MessageHandle& handle) {
     int jobId = request[0];
     LOG_ADD_SRC(V2_INFO, "TIMEOUT #%i %.6f", handle.source, jobId, 
             Timer::elapsedSeconds() - _active_jobs[jobId]->getArrival());
+    JobDescription& desc = *_active_jobs.at(jobId);
+    desc.getStatistics().processingTime = Timer::elapsedSeconds() - desc.getStatistics().timeOfScheduling;
+
+    auto observer = app_registry::getJobResultObserver(desc.getApplicationId());
+    if (observer) {
+        JobResult result;
+        result.id = jobId;
+        result.revision = desc.getRevision();
+        result.result = 0;
+        observer(_params, desc, result);
+    }
     
     if (_json_interface) {
         JobResult result;
@@ -644,6 +769,10 @@ void Client::finishJob(int jobId, bool hasIncrementalSuccessors) {
         _done_jobs[jobId] = DoneInfo{_active_jobs[jobId]->getRevision(), _active_jobs[jobId]->getChecksum()};
     }
     if (!hasIncrementalSuccessors) {
+        {
+            auto lock = _solution_reconstructors_lock.getLock();
+            _solution_reconstructors.erase(jobId);
+        }
         _root_nodes.erase(jobId);
         _active_jobs.erase(jobId);
         _sys_state.addLocal(SYSSTATE_PROCESSED_JOBS, 1);
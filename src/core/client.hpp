@@ -12,6 +12,7 @@
 #include <memory>
 #include <vector>
 
+#include "app/app_registry.hpp"
 #include "comm/mympi.hpp"
 #include "util/params.hpp"
 #include "data/job_description.hpp"
@@ -33,6 +34,7 @@ struct JobRequest;
 class APIConnector;
 class Connector;
 class JsonInterface;
+class Logger;
 struct MessageHandle;
 
 #define SYSSTATE_ENTERED_JOBS 0
@@ -40,6 +42,7 @@ struct MessageHandle;
 #define SYSSTATE_SCHEDULED_JOBS 2
 #define SYSSTATE_PROCESSED_JOBS 3
 #define SYSSTATE_SUCCESSFUL_JOBS 4
+#define SYSSTATE_QUICKSOLVED_JOBS 5
 
 struct JobByArrivalComparator {
     inline bool operator() (const JobMetadata& struct1, const JobMetadata& struct2) const {
@@ -98,6 +101,13 @@ private:
     // Safeguards _done_jobs.
     Mutex _done_job_lock; 
 
+    // Jobs solved directly by the client after parsing, not yet accounted for in _sys_state.
+    std::atomic_int _num_new_quick_solved_jobs = 0;
+
+    // For each active job preprocessed by the client: maps its results back to the original job.
+    robin_hood::unordered_node_map<int, app_registry::JobSolutionReconstructor> _solution_reconstructors;
+    Mutex _solution_reconstructors_lock;
+
     std::list<std::future<void>> _done_job_futures;
     std::list<bool> _done_job_futures_finished;
 
@@ -107,7 +117,7 @@ private:
 
     std::map<int, int> _root_nodes;
     std::set<int> _client_ranks;
-    SysState<5> _sys_state;
+    SysState<6> _sys_state;
 
     std::unique_ptr<JsonInterface> _json_interface;
     std::vector<Connector*> _interface_connectors;
@@ -124,7 +134,7 @@ private:
 public:
     Client(MPI_Comm comm, Parameters& params)
         : _comm(comm), _world_rank(MyMpi::rank(MPI_COMM_WORLD)), 
-        _params(params), _sys_state(_comm, params.sysstatePeriod(), SysState<5>::ALLREDUCE) {}
+        _params(params), _sys_state(_comm, params.sysstatePeriod(), SysState<6>::ALLREDUCE) {}
     ~Client();
     void init();
     void advance();
@@ -139,6 +149,9 @@ public:
 
 private:
     void readIncomingJobs();
+    app_registry::JobSolutionReconstructor preprocessJob(JobDescription& desc, Logger& log);
+    void tuneJob(JobDescription& desc);
+    bool tryQuickSolve(JobDescription& desc, Logger& log, const app_registry::JobSolutionReconstructor& reconstructor);
     
     void handleOfferAdoption(MessageHandle& handle);
     void sendJobDescription(JobRequest& req, int destRank);
@@ -2,6 +2,7 @@
 #pragma once
 
 #include "util/hashing.hpp"
+#include "util/tracer.hpp"
 #include "app/job.hpp"
 #include "job_registry.hpp"
 #include "util/sys/thread_pool.hpp"
@@ -12,6 +13,7 @@ class JobDescriptionInterface {
 private:
     JobRegistry& _job_registry;
     robin_hood::unordered_map<int, int> _send_id_to_job_id;
+    robin_hood::unordered_set<int> _job_ids_with_traced_query;
 
     std::list<MessageSubscription> _subscriptions;
 
@@ -33,6 +35,7 @@ public:
             // Transfer of at least one revision is required
             int requestedRevision = job.hasDescription() ? job.getRevision()+1 : 0;
             MyMpi::isend(source, MSG_QUERY_JOB_DESCRIPTION, IntPair(job.getId(), requestedRevision));
+            traceQuery(job.getId(), requestedRevision);
         }
     }
 
@@ -43,6 +46,7 @@ public:
             // No: Query next revision
             MyMpi::isend(source, MSG_QUERY_JOB_DESCRIPTION, 
                 IntPair(job.getId(), job.getRevision()+1));
+            traceQuery(job.getId(), job.getRevision()+1);
         }
     }
 
@@ -51,6 +55,9 @@ public:
         const auto& data = handle.getRecvData();
         outJobId = data.size() >= sizeof(int) ? Serializable::get<int>(data) : -1;
         LOG_ADD_SRC(V4_VVER, "Got desc. of size %lu for job #%i", handle.source, data.size(), outJobId);
+        if (Tracer::enabled() && _job_ids_with_traced_query.erase(outJobId)) {
+            Tracer::endAsync("desc", "transfer", outJobId);
+        }
 
         auto dataPtr = std::shared_ptr<std::vector<uint8_t>>(
             new std::vector<uint8_t>(handle.moveRecvData())
@@ -102,6 +109,7 @@ private:
                 job.toStr(), revision, descPtr->size());
         int sendId = MyMpi::isend(dest, MSG_SEND_JOB_DESCRIPTION, descPtr);
         LOG_ADD_DEST(V4_VVER, "Sent id=%i", dest, sendId);
+        Tracer::beginAsync("desc_send", "send", sendId, {"job", job.getId(), "rev", revision});
         job.getJobTree().addSendHandle(dest, sendId);
         _send_id_to_job_id[sendId] = job.getId();
     }
@@ -130,6 +138,7 @@ private:
     void handleJobDescriptionSent(int sendId) {
         auto it = _send_id_to_job_id.find(sendId);
         if (it != _send_id_to_job_id.end()) {
+            Tracer::endAsync("desc_send", "send", sendId);
             int jobId = it->second;
             if (_job_registry.has(jobId)) {
                 _job_registry.get(jobId).getJobTree().clearSendHandle(sendId);
@@ -138,6 +147,13 @@ private:
         }
     }
 
+    // One traced transfer per job at a time: a query is answered before the next one is sent
+    void traceQuery(int jobId, int revision) {
+        if (!Tracer::enabled() || _job_ids_with_traced_query.count(jobId)) return;
+        _job_ids_with_traced_query.insert(jobId);
+        Tracer::beginAsync("desc", "transfer", jobId, {"rev", revision});
+    }
+
     void handleQueryForJobDescription(MessageHandle& handle) {
 
         IntPair pair = Serializable::get<IntPair>(handle.getRecvData());
@@ -1,7 +1,9 @@
 
 #pragma once
 
+#include <algorithm>
 #include <queue>
+#include <vector>
 
 #include "app/app_message_subscription.hpp"
 #include "util/logger.hpp"
@@ -24,6 +26,8 @@ private:
     bool _has_commitment {false};
     int _load {0};
     Job* _current_job {nullptr};
+    // Light jobs which are active on this PE in addition to the (light) current job
+    std::vector<Job*> _co_hosted_light_jobs;
     robin_hood::unordered_map<int, int> _num_reactivators_per_job;
 
     float _time_of_last_adoption = 0;
@@ -98,6 +102,29 @@ public:
     Job& getActive() {
         return *_current_job;
     }
+    // Whether the job is active on this PE, either as the current job or as a co-hosted light job.
+    bool isActive(int jobId) const {
+        if (_current_job && _current_job->getId() == jobId) return true;
+        for (auto job : _co_hosted_light_jobs) if (job->getId() == jobId) return true;
+        return false;
+    }
+    // IDs of all jobs active on this PE, beginning with the current job.
+    std::vector<int> getActiveJobIds() const {
+        std::vector<int> ids;
+        if (_current_job) ids.push_back(_current_job->getId());
+        for (auto job : _co_hosted_light_jobs) ids.push_back(job->getId());
+        return ids;
+    }
+    int getNumCoHostedLightJobs() const {
+        return _co_hosted_light_jobs.size();
+    }
+    // A further light job can be adopted if all jobs active on this PE are light
+    // and their number is below the configured limit - and no other adoption is pending.
+    bool canCoHostLightJob() const {
+        if (!hasActiveJob() || !_current_job->isLight() || _current_job->getState() != ACTIVE) return false;
+        if (committed()) return false;
+        return 1 + _co_hosted_light_jobs.size() < _params.lightJobsPerProcess();
+    }
 
     bool hasCommitment(int jobId) const {
         return has(jobId) && get(jobId).hasCommitment();
@@ -117,9 +144,34 @@ public:
     }
 
     void setLoad(int load, int whichJobId) {
+        assert(has(whichJobId));
+        if (load == 1 && _load == 1) {
+            // Co-host another light job next to the current one
+            assert(get(whichJobId).isLight() && canCoHostLightJob());
+            LOG(V3_VERB, "LOAD 1 (+%s, co-hosted)\n", get(whichJobId).toStr());
+            _co_hosted_light_jobs.push_back(&get(whichJobId));
+            get(whichJobId).setCoHosted(true);
+            return;
+        }
+        if (load == 0 && _current_job != nullptr && _current_job->getId() != whichJobId) {
+            // A co-hosted light job leaves
+            auto it = std::find(_co_hosted_light_jobs.begin(), _co_hosted_light_jobs.end(), &get(whichJobId));
+            assert(it != _co_hosted_light_jobs.end());
+            LOG(V3_VERB, "LOAD 1 (-%s, co-hosted)\n", get(whichJobId).toStr());
+            _co_hosted_light_jobs.erase(it);
+            get(whichJobId).setCoHosted(false);
+            return;
+        }
+        if (load == 0 && !_co_hosted_light_jobs.empty()) {
+            // The current job leaves: a co-hosted light job takes its place
+            LOG(V3_VERB, "LOAD 1 (-%s, +%s)\n", get(whichJobId).toStr(), _co_hosted_light_jobs.front()->toStr());
+            _current_job = _co_hosted_light_jobs.front();
+            _current_job->setCoHosted(false);
+            _co_hosted_light_jobs.erase(_co_hosted_light_jobs.begin());
+            return;
+        }
         assert(load + _load == 1); // (load WAS 1) XOR (load BECOMES 1)
         _load = load;
-        assert(has(whichJobId));
         if (load == 1) {
             assert(_current_job == NULL);
             LOG(V3_VERB, "LOAD 1 (+%s)\n", get(whichJobId).toStr());
@@ -143,7 +143,12 @@ public:
         // If hopped enough for collective assignment to be enabled
         // and if either reactivation scheduling is employed or the requested node is non-root
         auto huca = _params.hopsUntilCollectiveAssignment();
-        if (_req_matcher && (huca < 0 || num >= huca)
+        // The root of a light job can also be adopted by a busy PE hosting other light jobs,
+        // which collective assignment (matching requests with idle PEs) does not consider:
+        // let such a request bounce for a few more hops first.
+        bool bounceLightRoot = request.light && request.requestedNodeIndex == 0
+            && num < std::max(huca, 2*_params.numBounceAlternatives());
+        if (_req_matcher && (huca < 0 || num >= huca) && !bounceLightRoot
             && (_params.reactivationScheduling() || request.requestedNodeIndex > 0)) {
 
             request.triggerAndDestroyMultiplicityData();
@@ -15,6 +15,7 @@
 #include "data/job_state.h"
 #include "data/job_transfer.hpp"
 #include "util/sys/timer.hpp"
+#include "util/tracer.hpp"
 #include "util/logger.hpp"
 #include "util/sys/watchdog.hpp"
 #include "job_registry.hpp"
@@ -36,6 +37,10 @@
 #include "util/option.hpp"
 #include "util/params.hpp"
 #include "util/robin_hood.hpp"
+#include "util/sys/counter_registry.hpp"
+
+static Counter cntCommits("sched.commits");
+static Counter cntSuspensions("sched.suspensions");
 
 SchedulingManager::SchedulingManager(Parameters& params, MPI_Comm& comm, 
             RandomizedRoutingTree& routingTree,
@@ -194,7 +199,15 @@ void SchedulingManager::handleDemandUpdate(Job& job, int demand) {
 
 void SchedulingManager::checkActiveJob() {
 
-    Job &job = _job_registry.getActive();
+    // Check the current job as well as any light jobs co-hosted next to it
+    for (int id : _job_registry.getActiveJobIds()) {
+        // The job may have been terminated by checking a previous job
+        if (_job_registry.isActive(id)) checkActiveJob(get(id));
+    }
+}
+
+void SchedulingManager::checkActiveJob(Job& job) {
+
     int id = job.getId();
     bool isRoot = job.getJobTree().isRoot();
 
@@ -346,7 +359,8 @@ void SchedulingManager::handleIncomingJobRequest(MessageHandle& handle, JobReque
 
         // Adoption takes place
         LOG_ADD_SRC(V3_VERB, "ADOPT %s mode=%i", source, req.toStr().c_str(), mode);
-        assert(!_job_registry.isBusyOrCommitted() || LOG_RETURN_FALSE("Adopting a job, but not idle!\n"));
+        assert(!_job_registry.isBusyOrCommitted() || (req.light && !_job_registry.committed())
+            || LOG_RETURN_FALSE("Adopting a job, but not idle!\n"));
 
         // Commit on the job, send a request to the parent
         if (!has(req.jobId)) {
@@ -1002,6 +1016,8 @@ void SchedulingManager::commit(Job& job, JobRequest& req) {
 
     LOG(V3_VERB, "COMMIT %s -> #%i:%i\n", job.toStr(), req.jobId, req.requestedNodeIndex);
     job.commit(req);
+    cntCommits.add();
+    Tracer::beginAsync("job", "committed", req.jobId, {"index", req.requestedNodeIndex, "rev", req.revision});
 
     // Forward discard callback from the one "commitment" job request
     // to *two* requests (representing potential children) within the Job instance
@@ -1042,6 +1058,7 @@ void SchedulingManager::commit(Job& job, JobRequest& req) {
 JobRequest SchedulingManager::uncommit(Job& job, bool leaving) {
     if (!job.hasCommitment()) return JobRequest();
     LOG(V3_VERB, "UNCOMMIT %s\n", job.toStr());
+    Tracer::endAsync("job", "committed", job.getId());
     
     auto optReq = job.uncommit();
     assert(optReq.has_value());
@@ -1106,6 +1123,14 @@ SchedulingManager::AdoptionResult SchedulingManager::tryAdopt(JobRequest& req, J
     }
     // -- node is busy in some form
 
+    // Request for the root of a light job: co-host it next to the active light job(s)
+    if (req.light && req.requestedNodeIndex == 0 && req.revision == 0 && mode == NORMAL
+            && (!has(req.jobId) || get(req.jobId).getState() == INACTIVE)
+            && _job_registry.canCoHostLightJob()) {
+        LOG(V4_VVER, "Co-host light %s\n", req.toStr().c_str());
+        return ADOPT;
+    }
+
     // Request for a root node:
     // Possibly adopt the job while dismissing the active job
     if (req.requestedNodeIndex == 0 && req.revision == 0 && !_params.reactivationScheduling()) {
@@ -1161,6 +1186,8 @@ void SchedulingManager::suspend(Job& job) {
     job.suspend();
     setLoad(0, job.getId());
     LOG(V3_VERB, "SUSPEND %s\n", job.toStr());
+    cntSuspensions.add();
+    Tracer::instant("job", "suspend", {"job", job.getId()});
     _balancer.onSuspend(job);
 }
 
@@ -1168,7 +1195,7 @@ void SchedulingManager::terminate(Job& job) {
 
     int jobId = job.getId();
     bool wasTerminatedBefore = job.getState() == JobState::PAST;
-    if (_job_registry.hasActiveJob() && _job_registry.getActive().getId() == jobId) {
+    if (_job_registry.isActive(jobId)) {
         setLoad(0, jobId);
     }
 
@@ -1177,6 +1204,7 @@ void SchedulingManager::terminate(Job& job) {
     if (!wasTerminatedBefore) _balancer.onTerminate(job);
 
     LOG(V4_VVER, "Forget %s\n", job.toStr());
+    Tracer::instant("job", "terminate", {"job", jobId});
     eraseJobAndQueueForDeletion(job);
 }
 
@@ -1236,8 +1264,17 @@ void SchedulingManager::eraseJobAndQueueForDeletion(Job& job) {
 bool SchedulingManager::has(int id) const {return _job_registry.has(id);}
 Job& SchedulingManager::get(int id) const {return _job_registry.get(id);}
 void SchedulingManager::setLoad(int load, int jobId) {
+    int currentJobId = _job_registry.hasActiveJob() ? _job_registry.getActive().getId() : -1;
     _job_registry.setLoad(load, jobId);
-    if (load == 0 && _req_matcher) _req_matcher->setStatusDirty(RequestMatcher::BECOME_IDLE);
+    // Report changes in light job co-hosting to balancing, which credits the shared PEs
+    if (load == 1 && get(jobId).isCoHosted()) 
+        _balancer.onCoHostingChange(get(jobId));
+    if (load == 0 && _job_registry.hasActiveJob() && _job_registry.getActive().getId() != currentJobId) 
+        _balancer.onCoHostingChange(_job_registry.getActive());
+    if (load == 1) Tracer::beginAsync("job", "active", jobId, {"index", get(jobId).getIndex()});
+    else Tracer::endAsync("job", "active", jobId);
+    if (load == 0 && !_job_registry.hasActiveJob() && _req_matcher) 
+        _req_matcher->setStatusDirty(RequestMatcher::BECOME_IDLE);
 }
 
 int SchedulingManager::getGlobalBalancingEpoch() const {
@@ -1249,14 +1286,14 @@ void SchedulingManager::triggerMemoryPanic() {
     _job_registry.setMemoryPanic(true);
     forgetOldJobs();
     _job_registry.setMemoryPanic(false);
-    // Trigger memory panic in the active job
-    if (_job_registry.hasActiveJob()) _job_registry.getActive().appl_memoryPanic();
+    // Trigger memory panic in the active job(s)
+    for (int id : _job_registry.getActiveJobIds()) get(id).appl_memoryPanic();
 }
 
 SchedulingManager::~SchedulingManager() {
 
-    // Suspend current job (if applicable) to compute last slice of busy time
-    if (_job_registry.hasActiveJob()) 
+    // Suspend current job(s) (if applicable) to compute last slice of busy time
+    while (_job_registry.hasActiveJob()) 
         setLoad(0, _job_registry.getActive().getId());
 
     // Setup a watchdog to get feedback on hanging destructors
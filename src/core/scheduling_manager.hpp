@@ -109,6 +109,7 @@ private:
     void setLoad(int load, int jobId);
         
     void handleDemandUpdate(Job& job, int demand);
+    void checkActiveJob(Job& job);
     void interruptJob(int jobId, bool terminate, bool reckless);
 
     bool isRequestObsolete(const JobRequest& req);
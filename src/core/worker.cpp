@@ -25,7 +25,7 @@
 Worker::Worker(MPI_Comm comm, Parameters& params) :
     _comm(comm), _world_rank(MyMpi::rank(MPI_COMM_WORLD)), 
     _params(params), _job_registry(_params, _comm), _routing_tree(_params, _comm), 
-    _sys_state(_comm, params.sysstatePeriod(), SysState<9>::ALLREDUCE), 
+    _sys_state(_comm, params.sysstatePeriod(), SysState<9>::ALLREDUCE, MPI_SUM, /*includeCounters=*/true), 
     _sched_man(_params, _comm, _routing_tree, _job_registry, _sys_state), 
     _watchdog(/*enabled=*/_params.watchdog(), /*checkIntervMillis=*/100, Timer::elapsedSeconds())
 {
@@ -187,7 +187,8 @@ void Worker::checkActiveJob() {
 
     _sys_state.setLocal(SYSSTATE_BUSYRATIO, 1.0f); // busy nodes
     _sys_state.setLocal(SYSSTATE_COMMITTEDRATIO, 0.0f); // committed nodes
-    _sys_state.setLocal(SYSSTATE_NUMJOBS, isRoot ? 1.0f : 0.0f); // active jobs
+    _sys_state.setLocal(SYSSTATE_NUMJOBS, (isRoot ? 1.0f : 0.0f) 
+        + _job_registry.getNumCoHostedLightJobs()); // active jobs
 
     _sched_man.checkActiveJob();
 }
@@ -205,6 +206,24 @@ void Worker::publishAndResetSysState() {
                     result[SYSSTATE_BUSYRATIO]/MyMpi::size(_comm), result[SYSSTATE_COMMITTEDRATIO]/MyMpi::size(_comm), 
                     (int)result[SYSSTATE_NUMJOBS], result[SYSSTATE_GLOBALMEM], (int)result[SYSSTATE_SPAWNEDREQUESTS], 
                     (int)result[SYSSTATE_NUMHOPS]);
+
+        // Global totals of registered counters and their rates since the last report
+        float time = Timer::elapsedSeconds();
+        float elapsed = time - _last_counter_report_time;
+        auto counters = _sys_state.getGlobalCounters();
+        if (!counters.empty()) {
+            std::string out;
+            for (size_t i = 0; i < counters.size(); i++) {
+                auto& [name, value] = counters[i];
+                double rate = i < _last_counter_values.size() && elapsed > 0 ?
+                    (value - _last_counter_values[i]) / elapsed : 0;
+                out += " " + name + "=" + std::to_string((long) value) + "(" + std::to_string((long) rate) + "/s)";
+            }
+            LOG(V3_VERB, "sysstate counters%s\n", out.c_str());
+            _last_counter_values.resize(counters.size());
+            for (size_t i = 0; i < counters.size(); i++) _last_counter_values[i] = counters[i].second;
+        }
+        _last_counter_report_time = time;
     }
     
     if (!_job_registry.isBusyOrCommitted()) {
@@ -4,6 +4,7 @@
 
 #include <atomic>
 #include <list>
+#include <vector>
 
 #include "core/scheduling_manager.hpp"
 #include "data/worker_sysstate.hpp"
@@ -31,6 +32,8 @@ private:
     std::list<MessageSubscription> _subscriptions;
 
     WorkerSysState _sys_state;
+    std::vector<double> _last_counter_values;
+    float _last_counter_report_time = 0;
     JobRegistry _job_registry;
     RandomizedRoutingTree _routing_tree;
     SchedulingManager _sched_man;
@@ -20,6 +20,20 @@ void JobDescription::reserveSize(size_t size) {
     getRevisionData(_revision)->reserve(getMetadataSize() + size);
 }
 
+void JobDescription::addPermanentData(const int* lits, size_t size) {
+    auto& data = _data_per_revision[_revision];
+    data->insert(data->end(), (const uint8_t*) lits, (const uint8_t*) (lits+size));
+    _f_size += size;
+    if (_use_checksums) for (size_t i = 0; i < size; i++) _checksum.combine(lits[i]);
+}
+
+void JobDescription::addTransientData(const int* lits, size_t size) {
+    auto& data = _data_per_revision[_revision];
+    data->insert(data->end(), (const uint8_t*) lits, (const uint8_t*) (lits+size));
+    _a_size += size;
+    if (_use_checksums) for (size_t i = 0; i < size; i++) _checksum.combine(-lits[i]);
+}
+
 void JobDescription::endInitialization() {
     // Add preloaded literals and assumptions (if any)
     for (int l : _preloaded_literals) addPermanentData(l);
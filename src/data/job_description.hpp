@@ -162,6 +162,9 @@ public:
         _a_size++;
         if (_use_checksums) _checksum.combine(-lit);
     }
+    // Append an entire block of literals at once
+    void addPermanentData(const int* lits, size_t size);
+    void addTransientData(const int* lits, size_t size);
     void setFSize(int fSize) {_f_size = fSize;}
     void endInitialization();
     void writeMetadata();
@@ -6,6 +6,7 @@ JobResult::JobResult(std::vector<uint8_t>&& packedData) : packedData(std::move(p
     n = sizeof(int); memcpy(&id, this->packedData.data()+i, n); i += n;
     n = sizeof(int); memcpy(&result, this->packedData.data()+i, n); i += n;
     n = sizeof(int); memcpy(&revision, this->packedData.data()+i, n); i += n;
+    n = sizeof(int); memcpy(&winningInstanceId, this->packedData.data()+i, n); i += n;
     n = sizeof(EncodedType); memcpy(&encodedType, this->packedData.data()+i, n); i += n;
 }
 
@@ -15,13 +16,14 @@ std::vector<uint8_t>&& JobResult::moveSerialization() {
 
 std::vector<uint8_t> JobResult::serialize() const {
     
-    int size = 3*sizeof(int) + sizeof(EncodedType) + solution.size()*sizeof(int);
+    int size = 4*sizeof(int) + sizeof(EncodedType) + solution.size()*sizeof(int);
     std::vector<uint8_t> packed(size);
 
     int i = 0, n;
     n = sizeof(int); memcpy(packed.data()+i, &id, n); i += n;
     n = sizeof(int); memcpy(packed.data()+i, &result, n); i += n;
     n = sizeof(int); memcpy(packed.data()+i, &revision, n); i += n;
+    n = sizeof(int); memcpy(packed.data()+i, &winningInstanceId, n); i += n;
     n = sizeof(EncodedType); memcpy(packed.data()+i, &encodedType, n); i += n;
     n = solution.size() * sizeof(int); memcpy(packed.data()+i, solution.data(), n); i += n;
     return packed;
@@ -33,6 +35,7 @@ void JobResult::updateSerialization() {
     n = sizeof(int); memcpy(packedData.data()+i, &id, n); i += n;
     n = sizeof(int); memcpy(packedData.data()+i, &result, n); i += n;
     n = sizeof(int); memcpy(packedData.data()+i, &revision, n); i += n;
+    n = sizeof(int); memcpy(packedData.data()+i, &winningInstanceId, n); i += n;
     n = sizeof(EncodedType); memcpy(packedData.data()+i, &encodedType, n); i += n;
 }
 
@@ -42,6 +45,7 @@ JobResult& JobResult::deserialize(const std::vector<uint8_t>& packed) {
     n = sizeof(int); memcpy(&id, packed.data()+i, n); i += n;
     n = sizeof(int); memcpy(&result, packed.data()+i, n); i += n;
     n = sizeof(int); memcpy(&revision, packed.data()+i, n); i += n;
+    n = sizeof(int); memcpy(&winningInstanceId, packed.data()+i, n); i += n;
     n = sizeof(EncodedType); memcpy(&encodedType, packed.data()+i, n); i += n;
     n = packed.size()-i; solution.resize(n/sizeof(int));
     memcpy(solution.data(), packed.data()+i, n); i += n;
@@ -50,23 +54,25 @@ JobResult& JobResult::deserialize(const std::vector<uint8_t>& packed) {
 
 void JobResult::setSolution(std::vector<int>&& solution) {
     this->solution = std::move(solution); 
+    packedData.clear(); // would shadow the new solution
 }
 
 void JobResult::setSolutionToSerialize(const int* solutionPtr, size_t solutionSize) {
-    int size = 3*sizeof(int) + sizeof(EncodedType) + solutionSize*sizeof(int);
+    int size = 4*sizeof(int) + sizeof(EncodedType) + solutionSize*sizeof(int);
     packedData.resize(size);
 
     int i = 0, n;
     n = sizeof(int); memcpy(packedData.data()+i, &id, n); i += n;
     n = sizeof(int); memcpy(packedData.data()+i, &result, n); i += n;
     n = sizeof(int); memcpy(packedData.data()+i, &revision, n); i += n;
+    n = sizeof(int); memcpy(packedData.data()+i, &winningInstanceId, n); i += n;
     n = sizeof(EncodedType); memcpy(packedData.data()+i, &encodedType, n); i += n;
     n = solutionSize * sizeof(int); memcpy(packedData.data()+i, solutionPtr, n); i += n;
 }
 
 size_t JobResult::getSolutionSize() const {
     static_assert(sizeof(int) == sizeof(EncodedType));
-    if (!packedData.empty()) return packedData.size()/sizeof(int) - 4;
+    if (!packedData.empty()) return packedData.size()/sizeof(int) - 5;
     return solution.size();
 }
 
@@ -17,7 +17,7 @@ struct JobResult : public Serializable {
     int revision;
     int result;
     enum EncodedType {INT, FLOAT} encodedType = INT;
-    int winningInstanceId;
+    int winningInstanceId = -1;
     unsigned long globalStartOfSuccessEpoch;
 
 private:
@@ -54,7 +54,7 @@ public:
     void setSolutionToSerialize(const int* begin, size_t size);
 
     bool hasSerialization() const {
-        return packedData.size() >= 3*sizeof(int) + sizeof(EncodedType);
+        return packedData.size() >= 4*sizeof(int) + sizeof(EncodedType);
     }
     size_t getSolutionSize() const;
     inline int getSolution(size_t pos) const {
@@ -62,7 +62,7 @@ public:
         static_assert(sizeof(int) == sizeof(EncodedType));
         if (!packedData.empty()) {
             return *(
-                (int*) (packedData.data() + (4+pos)*sizeof(int))
+                (int*) (packedData.data() + (5+pos)*sizeof(int))
             );
         }
         return solution[pos];
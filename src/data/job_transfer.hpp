@@ -37,6 +37,7 @@ struct JobRequest : public Serializable {
     int balancingEpoch;
     int applicationId;
     bool incremental;
+    bool light {false};
 
     int multiBaseId {-1};
     int multiplicity {1};
@@ -75,6 +76,7 @@ public:
         balancingEpoch = other.balancingEpoch;
         applicationId = other.applicationId;
         incremental = other.incremental;
+        light = other.light;
         multiBaseId = other.multiBaseId;
         multiplicity = other.multiplicity;
         multiBegin = other.multiBegin;
@@ -95,6 +97,7 @@ public:
         balancingEpoch = other.balancingEpoch;
         applicationId = other.applicationId;
         incremental = other.incremental;
+        light = other.light;
         multiBaseId = other.multiBaseId;
         multiplicity = other.multiplicity;
         multiBegin = other.multiBegin;
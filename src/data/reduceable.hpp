@@ -49,4 +49,22 @@ struct ReduceableInt : public Reduceable {
     }
 };
 
+// Reduceables whose content is a single trivially copyable value can
+// specialize this trait. AsyncCollective then (de-)serializes them in bulk
+// with a fixed layout and reduces broadcast prefixes in place on the received buffer.
+template <class T>
+struct FlatReduceable {
+    static constexpr bool enabled = false;
+};
+
+template <>
+struct FlatReduceable<ReduceableInt> {
+    static constexpr bool enabled = true;
+    typedef int Flat;
+    static Flat toFlat(const ReduceableInt& elem) {return elem.content;}
+    static ReduceableInt fromFlat(const Flat& flat) {return ReduceableInt(flat);}
+    // Same semantics as Reduceable::aggregate: left := left x right
+    static void aggregate(Flat& left, const Flat& right) {left += right;}
+};
+
 #endif
@@ -17,11 +17,13 @@
 #include "interface/api/rank_specific_file_fetcher.hpp"
 #include "util/sys/subprocess.hpp"
 #include "util/sys/timer.hpp"
+#include "util/tracer.hpp"
 #include "util/logger.hpp"
 #include "util/random.hpp"
 #include "util/params.hpp"
 #include "util/sys/process.hpp"
 #include "util/sys/proc.hpp"
+#include "util/sys/shared_memory.hpp"
 #include "core/worker.hpp"
 #include "core/client.hpp"
 #include "util/sys/thread_pool.hpp"
@@ -246,6 +248,13 @@ int main(int argc, char *argv[]) {
 
     longStartupWarnMsg(rank, "Init'd logger");
 
+    if (params.chromeTrace()) {
+        Tracer::init(rank, params.traceDirectory(), params.chromeTraceMaxEvents());
+        // Common point in time for aligning the timelines of all ranks
+        MPI_Barrier(MPI_COMM_WORLD);
+        Tracer::setClockSyncPoint();
+    }
+
     MyMpi::setOptions(params);
 
     longStartupWarnMsg(rank, "Init'd message queue");
@@ -310,6 +319,9 @@ int main(int argc, char *argv[]) {
         for (auto file : FileUtils::glob("/dev/shm/edu.kit.iti.mallob.*")) {
             doRemove(file);
         }
+        for (auto file : FileUtils::glob(std::string(SharedMemory::HUGETLBFS_DIRECTORY) + "/edu.kit.iti.mallob.*")) {
+            doRemove(file);
+        }
         for (auto file : FileUtils::glob(TmpDir::get() + "/mallob.*")) {
             doRemove(file);
         }
@@ -374,6 +386,7 @@ int main(int argc, char *argv[]) {
     }
 
     // Exit properly
+    Tracer::flush();
     MPI_Barrier(MPI_COMM_WORLD);
     MPI_Finalize();
     LOG(V2_INFO, "Exiting happily\n");
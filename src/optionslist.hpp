@@ -73,10 +73,15 @@ OPTION_GROUP(grpOutput, "output", "Output")
 
 OPTION_GROUP(grpScheduling, "scheduling", "Scheduling")
  OPT_FLOAT(balancingPeriod,               "p", "balancing-period",                     0.1,  0, LARGE_INT,      "Minimum interval between subsequent rounds of balancing")
+ OPT_BOOL(churnAwareBalancing,            "cab", "churn-aware-balancing",              false,                   "Damp volume updates: defer a job's growth until the PE time withheld from it outweighs the startup cost of the new PEs, and rate-limit shrinks which no other job needs")
+ OPT_INT(churnShrinkInterval,             "cabsi", "churn-aware-shrink-interval",      5,    1, LARGE_INT,      "Min. number of balancing epochs between a change of a job's volume and its next voluntary shrink")
+ OPT_FLOAT(churnSpawnLatency,             "cabsl", "churn-aware-spawn-latency",        0.2,  0, LARGE_INT,      "Expected time in seconds to spawn and warm up a job on a further PE")
+ OPT_FLOAT(churnTransferRate,             "cabtr", "churn-aware-transfer-rate",        100,  0.001, LARGE_INT,  "Expected rate in MB/s at which a job description is transferred to a further PE")
  OPT_BOOL(explicitVolumeUpdates,          "evu", "explicit-volume-updates",            false,                   "Broadcast volume updates through job tree instead of letting each PE compute it itself")
  OPT_INT(jobCacheSize,                    "jc", "job-cache-size",                      4,    0, LARGE_INT,      "Size of job cache per PE for suspended yet unfinished job nodes")
  OPT_FLOAT(loadFactor,                    "l", "load-factor",                          1,    0, 1,              "The share of PEs which should be busy at any given time")
  OPT_INT(numBounceAlternatives,           "ba", "bounce-alternatives",                 4,    1, LARGE_INT,      "Number of bounce alternatives per PE")
+ OPT_STRING(routingCacheDirectory,        "routing-cache", "routing-cache-dir",        "",                      "Directory to cache the expander graph of bounce alternatives in across runs (keyed by #workers, bounce alternatives, seed)") //[[AUTOCOMPLETE_DIRECTORY]]
 
 ///////////////////////////////////////////////////////////////////////
 
@@ -98,8 +103,13 @@ OPTION_GROUP(grpJob, "job", "Global configuration of jobs")
  OPT_FLOAT(jobCommUpdatePeriod,           "jcup", "job-comm-update-period",            0,    0, LARGE_INT,      "Job communicator update period (0: never update)" )
  OPT_FLOAT(jobCpuLimit,                   "jcl", "job-cpu-limit",                      0,    0, LARGE_INT,      "Timeout an instance after x cpu seconds")
  OPT_FLOAT(jobWallclockLimit,             "jwl", "job-wallclock-limit",                0,    0, LARGE_INT,      "Timeout an instance after x seconds wall clock time")
+ OPT_INT(lightJobThreshold,               "ljt", "light-job-threshold",                0,    0, MAX_INT,        "Treat non-incremental jobs with at most this many formula literals as light jobs which never grow beyond one PE and can share a PE with other light jobs (0: disabled)")
+ OPT_INT(lightJobsPerProcess,             "ljpp", "light-jobs-per-process",            4,    1, LARGE_INT,      "Max. number of light jobs hosted by a single PE; each light job receives this fraction of the PE's threads, and balancing does not count a PE for light jobs co-hosted next to another job")
  OPT_INT(maxDemand,                       "md", "max-demand",                          0,    0, LARGE_INT,      "Limit any job's demand to this value")
  OPT_INT(numThreadsPerProcess,            "t", "threads-per-process",                  1,    1, MALLOB_MAX_N_APPTHREADS_PER_PROCESS,      "Number of application worker threads per MPI process")
+ OPT_INT(quickSolveConflicts,             "qsc", "quick-solve-conflicts",              0,    0, MAX_INT,        "Let the client try to solve each non-incremental job within this many conflicts right after parsing; solved jobs never reach a worker (0: disabled)")
+ OPT_INT(quickSolveMaxLiterals,           "qsml", "quick-solve-max-literals",          1000000, 0, MAX_INT,     "Only attempt client-side quick solving for jobs with at most this many formula literals")
+ OPT_FLOAT(quickSolveTime,                "qst", "quick-solve-time",                   0.1,  0, LARGE_INT,      "Wallclock time limit in seconds for each client-side quick solving attempt (0: none)")
 
 ///////////////////////////////////////////////////////////////////////
 
@@ -122,6 +132,8 @@ OPTION_GROUP(grpPerformance, "performance", "Performance")
 ///////////////////////////////////////////////////////////////////////
 
 OPTION_GROUP(grpDebug, "debug", "Debugging")
+ OPT_BOOL(chromeTrace,                    "ctrace", "chrome-trace",                     false,                   "Record a timeline of job lifecycles, description transfers, clause sharing, proof assembly and balancing; write it in Chrome Trace Event format to <trace-dir>/mallob_timeline.<rank>.json at exit")
+ OPT_INT(chromeTraceMaxEvents,            "ctrace-max-events", "",                     1000000, 0, MAX_INT,     "Max. number of timeline events recorded per thread (see -ctrace)")
  OPT_FLOAT(crashMonkeyProbability,        "cmp", "crash-monkey",                       0,    0, 1,              "Have an application thread crash with this probability each time it performs a certain action")
  OPT_BOOL(delayMonkey,                    "delaymonkey", "",                           false,                   "Small chance for each MPI call to block for some random amount of time")
  OPT_BOOL(latencyMonkey,                  "latencymonkey", "",                         false,                   "Block all MPI_Isend operations by a small randomized amount of time")
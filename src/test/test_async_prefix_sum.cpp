@@ -0,0 +1,80 @@
+
+#include <assert.h>
+#include <list>
+#include <vector>
+
+#include "comm/async_collective.hpp"
+#include "comm/mympi.hpp"
+#include "data/reduceable.hpp"
+#include "util/logger.hpp"
+#include "util/params.hpp"
+#include "util/random.hpp"
+#include "util/sys/process.hpp"
+#include "util/sys/terminator.hpp"
+#include "util/sys/timer.hpp"
+
+int reductionInstanceCounter = 1;
+int reductionCallCounter = 1;
+
+// Exact integer prefix sums, i.e., of a flat reduceable whose broadcast
+// prefixes are reduced in place on the received buffer.
+// Run with several processes in order to cover the forwarding within the tree.
+void testExactIntegerPrefixSums() {
+
+    MPI_Comm comm = MPI_COMM_WORLD;
+    int rank = MyMpi::rank(comm);
+    int size = MyMpi::size(comm);
+    auto& q = MyMpi::getMessageQueue();
+    Terminator::reset();
+
+    AsyncCollective<ReduceableInt> allRed(comm, q, reductionInstanceCounter++);
+
+    MPI_Barrier(MPI_COMM_WORLD); // ensure all processes have a registered callback
+
+    // contributions 1, 2, ..., size
+    ReduceableInt myContrib(rank+1);
+    const int excl = rank*(rank+1)/2;
+    const int incl = (rank+1)*(rank+2)/2;
+    const int total = size*(size+1)/2;
+    int numDone = 0; int numExpectedDone = 5;
+    auto check = [&](std::list<ReduceableInt>& results, std::vector<int> expected) {
+        assert(results.size() == expected.size());
+        auto it = results.begin();
+        for (int val : expected) {
+            assert(it->content == val || log_return_false("[ERROR] %i != %i\n", it->content, val));
+            ++it;
+        }
+        numDone++;
+        if (numDone == numExpectedDone) Terminator::setTerminating();
+    };
+    allRed.allReduce(reductionCallCounter++, myContrib, [&](auto& results) {check(results, {total});});
+    allRed.inclusivePrefixSum(reductionCallCounter++, myContrib, [&](auto& results) {check(results, {incl});});
+    allRed.exclusivePrefixSum(reductionCallCounter++, myContrib, [&](auto& results) {check(results, {excl});});
+    allRed.inclAndExclPrefixSum(reductionCallCounter++, myContrib, [&](auto& results) {check(results, {excl, incl});});
+    allRed.inclAndExclPrefixSumWithTotal(reductionCallCounter++, myContrib, [&](auto& results) {
+        check(results, {excl, incl, total});
+    });
+
+    // Poll message queue until everything is done
+    while (!Terminator::isTerminating() || q.hasOpenSends()) q.advance();
+    LOG(V2_INFO, "Exact integer prefix sums done\n");
+}
+
+int main(int argc, char *argv[]) {
+
+    MyMpi::init();
+    Timer::init();
+    int rank = MyMpi::rank(MPI_COMM_WORLD);
+    Process::init(rank);
+    Random::init(rand(), rand());
+    Logger::init(rank, V5_DEBG);
+
+    Parameters params;
+    params.init(argc, argv);
+    MyMpi::setOptions(params);
+
+    testExactIntegerPrefixSums();
+
+    MPI_Barrier(MPI_COMM_WORLD);
+    MPI_Finalize();
+}
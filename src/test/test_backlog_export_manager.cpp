@@ -0,0 +1,92 @@
+
+#include <assert.h>
+#include <stdlib.h>
+#include <limits>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "app/sat/data/clause_histogram.hpp"
+#include "app/sat/sharing/backlog_export_manager.hpp"
+#include "app/sat/sharing/filter/exact_clause_filter.hpp"
+#include "app/sat/sharing/store/adaptive_clause_store.hpp"
+#include "util/sys/process.hpp"
+#include "util/random.hpp"
+#include "util/logger.hpp"
+#include "util/sys/timer.hpp"
+
+unsigned long long getSum(ClauseHistogram& hist, int maxLength) {
+    unsigned long long sum = 0;
+    for (int len = 1; len <= maxLength; len++) sum += hist.get(len);
+    return sum;
+}
+
+void testConcurrentProduction() {
+    const int numProducers = 8;
+    const int numClausesPerProducer = 100'000;
+    const int maxLength = 6;
+
+    AdaptiveClauseStore::Setup setup;
+    setup.maxEffectiveClauseLength = maxLength;
+    setup.maxLbdPartitionedSize = 2;
+    setup.numLiterals = numProducers * numClausesPerProducer * maxLength;
+    AdaptiveClauseStore store(setup);
+    ExactClauseFilter filter(store, std::numeric_limits<int>::max(), maxLength);
+
+    // No actual solvers and solver statistics required
+    std::vector<std::shared_ptr<PortfolioSolverInterface>> solvers(numProducers);
+    std::vector<SolverStatistics*> solverStats(numProducers, nullptr);
+    BacklogExportManager manager(store, filter, solvers, solverStats, maxLength);
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < numProducers; p++) {
+        threads.emplace_back([&, p]() {
+            std::vector<int> lits;
+            for (int c = 0; c < numClausesPerProducer; c++) {
+                // Distinct clauses for each producer, every other clause is produced twice
+                int id = (p * numClausesPerProducer + c) / 2;
+                int length = 2 + (id % (maxLength-1));
+                lits.clear();
+                for (int i = 0; i < length; i++) lits.push_back(1 + maxLength*id + i);
+                manager.produce(lits.data(), lits.size(), 2, p, 0);
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+
+    // Drain the remaining backlog by producing further (mostly duplicate) clauses
+    const unsigned long long numDistinct = numProducers * numClausesPerProducer / 2;
+    unsigned long long numProduced = numProducers * numClausesPerProducer;
+    std::vector<int> lits;
+    while (manager.getNumBackloggedClauses() > 0) {
+        for (int length = 2; length <= maxLength; length++) {
+            lits.clear();
+            for (int i = 0; i < length; i++) lits.push_back(1 + maxLength*numDistinct + i);
+            manager.produce(lits.data(), lits.size(), 2, 0, 0);
+            numProduced++;
+        }
+    }
+
+    auto admitted = getSum(manager.getAdmittedHistogram(), maxLength);
+    auto filtered = getSum(manager.getFailedFilterHistogram(), maxLength);
+    auto dropped = getSum(manager.getDroppedHistogram(), maxLength);
+    LOG(V2_INFO, "admitted=%llu filtered=%llu dropped=%llu backlog_peak=%lu backlog_dropped=%lu\n",
+        admitted, filtered, dropped, manager.getMaxNumBackloggedClauses(), manager.getNumDroppedFromBacklog());
+
+    // Each produced clause has been processed exactly once
+    assert(manager.getNumBackloggedClauses() == 0);
+    assert(admitted + filtered + dropped == numProduced);
+    assert(dropped == manager.getNumDroppedFromBacklog());
+    // Each distinct clause has been admitted at most once, and only dropped clauses are missing
+    assert(admitted <= numDistinct + maxLength-1);
+    assert(admitted + dropped >= numDistinct);
+}
+
+int main() {
+    Timer::init();
+    Random::init(rand(), rand());
+    Logger::init(0, V5_DEBG);
+    Process::init(0);
+
+    testConcurrentProduction();
+}
@@ -13,6 +13,7 @@
 #include "util/assert.hpp"
 #include "util/params.hpp"
 #include "util/sys/fileutils.hpp"
+#include "util/sys/futex_event.hpp"
 #include "util/sys/process.hpp"
 #include "util/sys/shared_memory.hpp"
 #include "util/sys/subprocess.hpp"
@@ -91,16 +92,25 @@ void testBasic() {
 
 void testAnytimeChild() {
     {
-        bool* childReadyToWrite = (bool*) SharedMemory::access("edu.kit.mallob.test.bidirpipe", 1);
+        char* shmem = (char*) SharedMemory::access("edu.kit.mallob.test.bidirpipe", 8);
+        bool* childReadyToWrite = (bool*) shmem;
         BiDirectionalAnytimePipe pipe(BiDirectionalAnytimePipe::ACCESS, pathChildToParentAnytime, pathParentToChildAnytime, childReadyToWrite);
+        // sleep until the incoming message wakes us up
+        FutexEvent wakeup((uint32_t*) (shmem+4));
+        uint32_t lastWakeup = wakeup.get();
+        pipe.setIncomingMessageCallback([&]() {wakeup.signal();});
         pipe.open();
 
         LOG(V2_INFO, "[child]  wait for data ...\n");
         char tag = TAG_SEND_DATA;
-        while (pipe.pollForData() != tag) {}
+        while (pipe.pollForData() != tag) {
+            wakeup.wait(lastWakeup, 10'000'000);
+            lastWakeup = wakeup.get();
+        }
         LOG(V2_INFO, "[child]  data present\n");
         std::vector<int> data = pipe.readData(tag);
         LOG(V2_INFO, "[child]  read all data\n");
+        assert(pipe.getArrivalTimeOfLastRead() > 0);
         for (size_t i = 0; i < data.size(); i++) data[i]++;
         LOG(V2_INFO, "[child]  transformed data\n");
         LOG(V2_INFO, "[child]  writing data ...\n");
@@ -116,8 +126,10 @@ void testAnytime() {
     FileUtils::rm(pathChildToParentAnytime);
     FileUtils::rm("/dev/shm/edu.kit.mallob.test.bidirpipe");
 
-    bool* childReadyToWrite = (bool*) SharedMemory::create("edu.kit.mallob.test.bidirpipe", 1);
+    char* shmem = (char*) SharedMemory::create("edu.kit.mallob.test.bidirpipe", 8);
+    bool* childReadyToWrite = (bool*) shmem;
     *childReadyToWrite = false;
+    *((uint32_t*) (shmem+4)) = 0;
     pid_t pid;
     {
         BiDirectionalAnytimePipe pipe(BiDirectionalAnytimePipe::CREATE, pathParentToChildAnytime, pathChildToParentAnytime, childReadyToWrite);
@@ -152,7 +164,7 @@ void testAnytime() {
     while (!Process::didChildExit(pid)) usleep(10'000);
     LOG(V2_INFO, "[parent] child exited\n");
 
-    SharedMemory::free("edu.kit.mallob.test.bidirpipe", (char*) &childReadyToWrite, 1);
+    SharedMemory::free("edu.kit.mallob.test.bidirpipe", shmem, 8);
     FileUtils::rm(pathParentToChildAnytime);
     FileUtils::rm(pathChildToParentAnytime);
     FileUtils::rm("/dev/shm/edu.kit.mallob.test.bidirpipe");
@@ -0,0 +1,86 @@
+
+#include <assert.h>
+#include <stdlib.h>
+#include <thread>
+#include <vector>
+
+#include "app/sat/sharing/filter/blocked_literals.hpp"
+#include "app/sat/data/clause_metadata.hpp"
+#include "util/logger.hpp"
+#include "util/random.hpp"
+#include "util/sys/timer.hpp"
+
+Mallob::Clause makeClause(std::vector<int>& data, const std::vector<int>& lits) {
+    data.assign(ClauseMetadata::numInts(), 0);
+    data.insert(data.end(), lits.begin(), lits.end());
+    return Mallob::Clause(data.data(), data.size(), lits.size() == 1 ? 1 : 2);
+}
+
+void testBlocking() {
+    BlockedLiterals blocked(100);
+    std::vector<int> data;
+    assert(!blocked.blocks(makeClause(data, {1, -2, 3})));
+
+    // A fixed literal blocks its own polarity only
+    blocked.blockLiteral(-2);
+    assert(blocked.isBlocked(-2) && !blocked.isBlocked(2));
+    assert(blocked.blocks(makeClause(data, {1, -2, 3})));
+    assert(!blocked.blocks(makeClause(data, {1, 2, 3})));
+    assert(blocked.getNumBlockedVariables() == 1);
+
+    // An eliminated variable blocks both polarities
+    blocked.blockVariable(64);
+    assert(blocked.isBlocked(64) && blocked.isBlocked(-64));
+    assert(!blocked.isBlocked(63) && !blocked.isBlocked(-63) && !blocked.isBlocked(65));
+    assert(blocked.blocks(makeClause(data, {5, -64})));
+    assert(blocked.getNumBlockedVariables() == 2);
+    blocked.blockLiteral(64);
+    assert(blocked.getNumBlockedVariables() == 2);
+
+    blocked.unblockVariable(64);
+    assert(!blocked.isBlocked(64) && !blocked.isBlocked(-64));
+    assert(!blocked.blocks(makeClause(data, {5, -64})));
+    assert(blocked.getNumBlockedVariables() == 1);
+
+    // Variables beyond the covered range are never blocked
+    blocked.blockVariable(101);
+    blocked.blockLiteral(-1000);
+    assert(!blocked.isBlocked(101) && !blocked.isBlocked(-1000));
+    assert(blocked.getNumBlockedVariables() == 1);
+
+    BlockedLiterals empty(0);
+    empty.blockLiteral(1);
+    assert(!empty.isBlocked(1) && empty.getNumBlockedVariables() == 0);
+}
+
+void testConcurrentBlocking() {
+    const int numVars = 10'000;
+    BlockedLiterals blocked(numVars);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++) {
+        threads.emplace_back([&, t]() {
+            // Every thread blocks every variable of its residue class, half of them twice
+            for (int var = 1; var <= numVars; var++) {
+                if (var % 4 != t) continue;
+                if (var % 2 == 0) blocked.blockVariable(var);
+                else blocked.blockLiteral(-var);
+                blocked.blockLiteral(-var);
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    assert(blocked.getNumBlockedVariables() == numVars);
+    for (int var = 1; var <= numVars; var++) {
+        assert(blocked.isBlocked(-var));
+        assert(blocked.isBlocked(var) == (var % 2 == 0));
+    }
+}
+
+int main() {
+    Timer::init();
+    Random::init(rand(), rand());
+    Logger::init(0, V5_DEBG);
+
+    testBlocking();
+    testConcurrentBlocking();
+}
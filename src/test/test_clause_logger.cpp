@@ -0,0 +1,64 @@
+#include <assert.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+
+#include "app/sat/data/clause.hpp"
+#include "app/sat/sharing/clause_logger.hpp"
+#include "util/random.hpp"
+#include "util/logger.hpp"
+#include "util/sys/fileutils.hpp"
+#include "util/sys/proc.hpp"
+#include "util/sys/timer.hpp"
+
+void testBinaryRoundTrip() {
+    const std::string path = "/tmp/mallob_test_clause_log." + std::to_string(Proc::getPid());
+    const int numEpochs = 5;
+
+    // epoch -> clauses
+    std::vector<std::vector<std::vector<int>>> expected(numEpochs);
+    {
+        ClauseLogger logger(path, ClauseLogger::BINARY);
+        for (int epoch = 0; epoch < numEpochs; epoch++) {
+            // Enough clauses to wrap around the ring buffer
+            int numClauses = epoch == 2 ? 0 : 100'000;
+            for (int c = 0; c < numClauses; c++) {
+                int length = 1 + (int) (30*Random::rand());
+                std::vector<int> lits;
+                for (int i = 0; i < length; i++) lits.push_back(1 + i + 100*c);
+                logger.append(Mallob::Clause(lits.data(), lits.size(), std::min(length, 2)), epoch, c % 8);
+                expected[epoch].push_back(std::move(lits));
+            }
+            logger.publish();
+        }
+        LOG(V2_INFO, "%lu stalls\n", logger.getNumStalls());
+    }
+
+    ClauseLogReader reader(path);
+    assert(reader.valid());
+    int epoch;
+    std::vector<ClauseLogReader::LoggedClause> clauses;
+    int numReadEpochs = 0;
+    while (reader.readNextEpoch(epoch, clauses)) {
+        // Empty epochs do not appear in the log
+        while (expected[numReadEpochs].empty()) numReadEpochs++;
+        assert(epoch == numReadEpochs);
+        assert(clauses.size() == expected[epoch].size());
+        for (size_t c = 0; c < clauses.size(); c++) {
+            assert(clauses[c].lits == expected[epoch][c]);
+            assert(clauses[c].lbd == std::min((int) clauses[c].lits.size(), 2));
+            assert(clauses[c].producers == c % 8);
+        }
+        numReadEpochs++;
+    }
+    assert(numReadEpochs == numEpochs);
+    FileUtils::rm(path);
+}
+
+int main() {
+    Timer::init();
+    Random::init(rand(), rand());
+    Logger::init(0, V5_DEBG);
+
+    testBinaryRoundTrip();
+}
@@ -0,0 +1,85 @@
+
+#include <assert.h>
+#include <stdlib.h>
+#include <set>
+#include <vector>
+
+#include "app/sat/data/clause.hpp"
+#include "app/sat/job/clause_snapshot.hpp"
+#include "app/sat/sharing/store/adaptive_clause_store.hpp"
+#include "util/sys/process.hpp"
+#include "util/sys/thread_pool.hpp"
+#include "util/random.hpp"
+#include "util/logger.hpp"
+#include "util/sys/timer.hpp"
+
+AdaptiveClauseStore::Setup getSetup(int numLiterals) {
+    AdaptiveClauseStore::Setup setup;
+    setup.maxEffectiveClauseLength = 20;
+    setup.maxLbdPartitionedSize = 2;
+    setup.numLiterals = numLiterals;
+    return setup;
+}
+
+// Raw clause buffer with one clause of each length in [1, maxLength], literals offset by the given value
+std::vector<int> getBuffer(int maxLength, int offset) {
+    AdaptiveClauseStore store(getSetup(100'000));
+    for (int length = 1; length <= maxLength; length++) {
+        std::vector<int> lits;
+        for (int i = 0; i < length; i++) lits.push_back(offset + i + 1);
+        store.addClause(Mallob::Clause(lits.data(), lits.size(), std::min(length, 2)));
+    }
+    int numClauses, numLits;
+    return store.exportBuffer(100'000, numClauses, numLits);
+}
+
+std::multiset<int> getClauseLengths(const std::vector<int>& buffer) {
+    AdaptiveClauseStore store(getSetup(100'000));
+    std::vector<int> copy(buffer);
+    auto reader = store.getBufferReader(copy.data(), copy.size());
+    std::multiset<int> lengths;
+    auto cls = reader.getNextIncomingClause();
+    while (cls.begin != nullptr) {
+        lengths.insert(cls.size);
+        cls = reader.getNextIncomingClause();
+    }
+    return lengths;
+}
+
+void testDeduplication() {
+    ClauseSnapshot snapshot(getSetup(100'000));
+    // Same clauses in several epochs
+    for (int epoch = 0; epoch < 5; epoch++) snapshot.insert(getBuffer(10, 0));
+    snapshot.waitForInsertions();
+    auto lengths = getClauseLengths(snapshot.read());
+    LOG(V2_INFO, "%lu clauses, %i lits\n", lengths.size(), snapshot.getNumLiterals());
+    assert(lengths.size() == 10);
+    assert(snapshot.getNumLiterals() == 10*11/2);
+}
+
+void testSizeBound() {
+    const int limit = 100;
+    ClauseSnapshot snapshot(getSetup(limit));
+    for (int epoch = 0; epoch < 20; epoch++) snapshot.insert(getBuffer(15, 100*epoch));
+    snapshot.waitForInsertions();
+    auto lengths = getClauseLengths(snapshot.read());
+    LOG(V2_INFO, "%lu clauses, %i lits\n", lengths.size(), snapshot.getNumLiterals());
+    // Unit clauses are not subject to the limit
+    int numNonunitLits = 0;
+    for (int length : lengths) if (length > 1) numNonunitLits += length;
+    assert(numNonunitLits <= limit);
+    // Only the shortest clauses are kept
+    assert(!lengths.empty() && *lengths.rbegin() <= 3);
+    assert(lengths.count(1) == 20);
+}
+
+int main() {
+    Timer::init();
+    Random::init(rand(), rand());
+    Logger::init(0, V5_DEBG);
+    Process::init(0);
+    ProcessWideThreadPool::init(2);
+
+    testDeduplication();
+    testSizeBound();
+}
@@ -0,0 +1,124 @@
+
+#include <assert.h>
+#include <stdlib.h>
+#include <map>
+#include <vector>
+
+#include "app/sat/data/clause.hpp"
+#include "app/sat/data/clause_histogram.hpp"
+#include "app/sat/sharing/clause_usefulness_tracker.hpp"
+#include "app/sat/sharing/store/adaptive_clause_store.hpp"
+#include "util/random.hpp"
+#include "util/logger.hpp"
+#include "util/sys/timer.hpp"
+
+void testTracker() {
+    const int maxLength = 10;
+    ClauseUsefulnessTracker tracker(maxLength, 1, 0.1);
+    // No observations yet: no restrictions
+    assert(tracker.getVolumeFactor() == 1);
+    for (float share : tracker.getExportShares()) assert(share == 1);
+
+    // Two solvers; clauses of length 2 are always digested, clauses of length 5
+    // only in a quarter of the cases, clauses of length 8 never
+    ClauseHistogram offered(maxLength), digested1(maxLength), digested2(maxLength);
+    std::vector<ClauseHistogram*> digested {&digested1, &digested2};
+    unsigned long imported = 0, discarded = 0;
+    for (int epoch = 0; epoch < 20; epoch++) {
+        ClauseHistogram offeredNow(maxLength);
+        offeredNow.increase(2, 100);
+        offeredNow.increase(5, 100);
+        offeredNow.increase(8, 100);
+        tracker.recordOffered(offeredNow);
+        for (auto hist : digested) {
+            hist->increase(2, 100);
+            hist->increase(5, 25);
+        }
+        // Backends keep all imported clauses
+        imported += 250;
+        tracker.update(digested, imported, discarded);
+    }
+    LOG(V2_INFO, "usefulness%s vol=%.3f\n", tracker.getReport().c_str(), tracker.getVolumeFactor());
+    auto shares = tracker.getExportShares();
+    assert(shares[0] == 1); // free clauses
+    assert(shares[1] == 1);
+    assert(std::abs(shares[4] - 0.25) < 0.01);
+    assert(shares[7] == 0.1f);
+    assert(shares[9] == 1); // never observed
+    // offered literals: 200 at 1.0, 500 at 0.25, 800 at 0
+    float expectedVolume = (200 + 0.25*500) / 1500.;
+    assert(std::abs(tracker.getVolumeFactor() - expectedVolume) < 0.01);
+
+    // Backends discard half of the imported clauses: usefulness drops
+    for (int epoch = 0; epoch < 20; epoch++) {
+        ClauseHistogram offeredNow(maxLength);
+        offeredNow.increase(2, 100);
+        tracker.recordOffered(offeredNow);
+        for (auto hist : digested) hist->increase(2, 100);
+        imported += 100;
+        discarded += 100;
+        tracker.update(digested, imported, discarded);
+    }
+    LOG(V2_INFO, "usefulness%s vol=%.3f\n", tracker.getReport().c_str(), tracker.getVolumeFactor());
+    assert(std::abs(tracker.getUsefulness(2) - 0.5) < 0.01);
+
+    // The counts are only refreshed every third epoch: the acceptance is retained in between
+    for (int epoch = 0; epoch < 21; epoch++) {
+        ClauseHistogram offeredNow(maxLength);
+        offeredNow.increase(2, 100);
+        tracker.recordOffered(offeredNow);
+        for (auto hist : digested) hist->increase(2, 100);
+        if (epoch % 3 == 2) {
+            imported += 300;
+            discarded += 300;
+        }
+        tracker.update(digested, imported, discarded);
+    }
+    LOG(V2_INFO, "usefulness%s vol=%.3f\n", tracker.getReport().c_str(), tracker.getVolumeFactor());
+    assert(std::abs(tracker.getUsefulness(2) - 0.5) < 0.01);
+}
+
+void testExportShares() {
+    AdaptiveClauseStore::Setup setup;
+    setup.numLiterals = 10'000;
+    setup.maxEffectiveClauseLength = 10;
+    AdaptiveClauseStore store(setup);
+    for (int c = 0; c < 300; c++) {
+        int length = 2 + c % 3;
+        std::vector<int> lits;
+        for (int i = 0; i < length; i++) lits.push_back(1 + i + 10*c);
+        store.addClause(Mallob::Clause(lits.data(), lits.size(), 2));
+    }
+
+    // Clauses of length 2 may occupy at most 10% of the export
+    std::vector<float> shares(setup.maxEffectiveClauseLength, 1);
+    shares[1] = 0.1;
+    store.setExportShares(shares);
+    const int limit = 300;
+    int numClauses, numLits;
+    auto buffer = store.exportBuffer(limit, numClauses, numLits);
+
+    std::map<int, int> litsPerLength;
+    auto reader = store.getBufferReader(buffer.data(), buffer.size());
+    auto cls = reader.getNextIncomingClause();
+    while (cls.begin != nullptr) {
+        litsPerLength[cls.size] += cls.size;
+        cls = reader.getNextIncomingClause();
+    }
+    LOG(V2_INFO, "exported lits: len2=%i len3=%i len4=%i\n", litsPerLength[2], litsPerLength[3], litsPerLength[4]);
+    assert(litsPerLength[2] <= 0.1 * limit);
+    // The freed budget is used for longer clauses
+    assert(litsPerLength[2] + litsPerLength[3] + litsPerLength[4] > limit - 4);
+    assert(litsPerLength[3] >= 0.85 * limit);
+    // Clauses not exported remain in the store
+    assert(store.getCurrentlyUsedLiterals() > 0);
+}
+
+int main() {
+    Timer::init();
+    Random::init(rand(), rand());
+    Logger::init(0, V5_DEBG);
+
+    testTracker();
+    testExportShares();
+}
@@ -0,0 +1,177 @@
+
+#include <assert.h>
+#include <limits.h>
+#include <stdlib.h>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "app/sat/parse/cnf_preprocessor.hpp"
+#include "app/sat/parse/sat_reader.hpp"
+#include "app/sat/solvers/quick_cdcl_solver.hpp"
+#include "app/sat/data/definitions.hpp"
+#include "data/job_description.hpp"
+#include "util/logger.hpp"
+#include "util/params.hpp"
+#include "util/random.hpp"
+#include "util/sys/timer.hpp"
+
+bool satisfies(const std::vector<int>& formula, const std::vector<int>& model) {
+    bool clauseSatisfied = false;
+    for (int lit : formula) {
+        if (lit == 0) {
+            if (!clauseSatisfied) return false;
+            clauseSatisfied = false;
+            continue;
+        }
+        if (std::abs(lit) < (int) model.size() && model[std::abs(lit)] == lit) clauseSatisfied = true;
+    }
+    return true;
+}
+
+// Random formula with some units, duplicate literals, tautologies, duplicate and subsumed clauses
+std::vector<int> generateFormula(int nbVars, int nbClauses, float unitChance) {
+    std::vector<int> formula;
+    for (int c = 0; c < nbClauses; c++) {
+        int len = 2 + (int) (Random::rand() * 3);
+        if (Random::rand() < unitChance) len = 1;
+        std::vector<int> cls;
+        for (int i = 0; i < len; i++) {
+            int var = 1 + (int) (Random::rand() * nbVars);
+            cls.push_back(Random::rand() < 0.5 ? -var : var);
+        }
+        if (Random::rand() < 0.05) cls.push_back(cls.front()); // duplicate literal
+        if (Random::rand() < 0.02) cls.push_back(-cls.front()); // tautology
+        for (int rep = 0; rep < (Random::rand() < 0.05 ? 2 : 1); rep++) {
+            formula.insert(formula.end(), cls.begin(), cls.end());
+            formula.push_back(0);
+        }
+        if (Random::rand() < 0.05) {
+            formula.insert(formula.end(), cls.begin(), cls.end());
+            formula.push_back(1 + (int) (Random::rand() * nbVars));
+            formula.push_back(0);
+        }
+    }
+    return formula;
+}
+
+int solve(const std::vector<int>& formula, std::vector<int>& model) {
+    QuickCdclSolver solver(formula.data(), formula.size());
+    int result = solver.solve(ULONG_MAX, 0);
+    if (result == RESULT_SAT) model = solver.getModel();
+    return result;
+}
+
+void testRandomFormulas() {
+    int numSat = 0, numUnsat = 0;
+    for (int rep = 0; rep < 300; rep++) {
+        const int nbVars = 5 + (int) (Random::rand() * 40);
+        const int nbClauses = (int) (nbVars * (1 + 4 * Random::rand()));
+        auto formula = generateFormula(nbVars, nbClauses, 0.15);
+
+        CnfPreprocessor preprocessor(1);
+        preprocessor.process(formula.data(), formula.size(), nbVars);
+        const auto& reduced = preprocessor.getFormula();
+        assert(reduced.size() <= formula.size() || preprocessor.getNbClauses() <= 2);
+        for (int lit : reduced) assert(std::abs(lit) <= preprocessor.getNbVars());
+
+        std::vector<int> originalModel, reducedModel;
+        int originalResult = solve(formula, originalModel);
+        int reducedResult = solve(reduced, reducedModel);
+        assert(originalResult == reducedResult);
+        if (preprocessor.isUnsat()) assert(originalResult == RESULT_UNSAT);
+        if (reducedResult == RESULT_SAT) {
+            auto model = preprocessor.getReconstruction()->reconstructModel(reducedModel);
+            assert(model.size() == nbVars+1);
+            assert(satisfies(formula, model));
+            numSat++;
+        } else numUnsat++;
+    }
+    LOG(V2_INFO, "%i SAT, %i UNSAT random formulas\n", numSat, numUnsat);
+}
+
+void testParallelChunks() {
+    const int nbVars = 30'000;
+    auto formula = generateFormula(nbVars, 60'000, 0.002);
+
+    CnfPreprocessor sequential(1);
+    sequential.process(formula.data(), formula.size(), nbVars);
+    CnfPreprocessor parallel(4);
+    parallel.process(formula.data(), formula.size(), nbVars);
+    assert(parallel.getFormula() == sequential.getFormula());
+    assert(parallel.getNbVars() == sequential.getNbVars());
+    assert(parallel.getNbClauses() == sequential.getNbClauses());
+    auto& stats = parallel.getStatistics();
+    LOG(V2_INFO, "%i->%i vars, %i->%i cls (%lu taut., %lu units, %lu dupl., %lu subs., %lu pure)\n",
+        nbVars, parallel.getNbVars(), 60'000, parallel.getNbClauses(), stats.numTautologies,
+        stats.numUnits, stats.numDuplicates, stats.numSubsumed, stats.numPureLiterals);
+    assert(!parallel.isUnsat());
+    assert(stats.numUnits > 0 && stats.numDuplicates > 0 && stats.numSubsumed > 0 && stats.numTautologies > 0);
+
+    std::vector<int> reducedModel;
+    int result = solve(parallel.getFormula(), reducedModel);
+    if (result == RESULT_SAT) {
+        auto model = parallel.getReconstruction()->reconstructModel(reducedModel);
+        assert(satisfies(formula, model));
+    }
+}
+
+void testTrivialCases() {
+    // Units propagate through everything
+    std::vector<int> formula {1, 0, -1, 2, 0, -2, 3, 0, 3, 4, 5, 0};
+    CnfPreprocessor satisfied(1);
+    satisfied.process(formula.data(), formula.size(), 5);
+    assert(!satisfied.isUnsat());
+    assert(satisfied.getFormula() == std::vector<int>({1, 0}));
+    auto model = satisfied.getReconstruction()->reconstructModel({0, 1});
+    assert(model.size() == 6);
+    assert(satisfies(formula, model));
+
+    // Conflicting units
+    formula = {1, 2, 0, -1, 0, -2, 0};
+    CnfPreprocessor conflict(1);
+    conflict.process(formula.data(), formula.size(), 2);
+    assert(conflict.isUnsat());
+    assert(conflict.getFormula() == std::vector<int>({1, 0, -1, 0}));
+
+    // Compaction to a dense range
+    formula = {-10, 20, 0, 10, -20, 0, 10, 20, 0, -10, -20, 0};
+    CnfPreprocessor compaction(1);
+    compaction.process(formula.data(), formula.size(), 20);
+    assert(compaction.getNbVars() == 2 && compaction.getNbClauses() == 4);
+    assert(compaction.getFormula() == std::vector<int>({-1, 2, 0, 1, -2, 0, 1, 2, 0, -1, -2, 0}));
+}
+
+void testJobDescription(Parameters& params) {
+    const std::string input = "/tmp/mallob_test_cnf_preprocessor.cnf";
+    {
+        std::ofstream ofs(input);
+        ofs << "p cnf 6 5\n5 0\n-5 6 0\n1 2 0\n-1 -2 0\n2 1 0\n";
+    }
+    JobDescription desc(1, 1, 0);
+    bool ok = SatReader(params, input).read(desc);
+    assert(ok);
+    auto reconstruction = CnfPreprocessor::preprocess(params, desc);
+    assert(reconstruction);
+    assert(desc.getAppConfiguration().map.at("__NV") == "2.........");
+    assert(desc.getAppConfiguration().map.at("__NC") == "2.........");
+    std::vector<int> payload(desc.getFormulaPayload(0), desc.getFormulaPayload(0) + desc.getFormulaPayloadSize(0));
+    assert(payload == std::vector<int>({1, 2, 0, -1, -2, 0}));
+    auto model = reconstruction->reconstructModel({0, -1, 2});
+    assert(model == std::vector<int>({0, -1, 2, 3, 4, 5, 6}));
+    remove(input.c_str());
+}
+
+int main(int argc, char *argv[]) {
+    Timer::init();
+    Random::init(rand(), rand());
+    Logger::init(0, V5_DEBG);
+
+    Parameters params;
+    params.init(argc, argv);
+
+    testTrivialCases();
+    testRandomFormulas();
+    testParallelChunks();
+    testJobDescription(params);
+}
@@ -0,0 +1,96 @@
+
+#include <assert.h>
+#include <cstring>
+#include <string>
+#include <stdlib.h>
+#include <thread>
+#include <vector>
+
+#include "util/random.hpp"
+#include "util/logger.hpp"
+#include "util/sys/timer.hpp"
+#include "util/sys/counter_registry.hpp"
+
+static Counter cntA("test.a");
+static Counter cntB("test.b");
+
+void testRegistration() {
+    assert(CounterRegistry::getId("test.a") >= 0);
+    assert(CounterRegistry::getId("test.b") >= 0);
+    assert(CounterRegistry::getId("test.a") != CounterRegistry::getId("test.b"));
+    assert(CounterRegistry::getId("test.c") == -1);
+    // Registering an existing name yields the same counter
+    assert(CounterRegistry::registerCounter("test.a") == CounterRegistry::getId("test.a"));
+
+    // Names are sorted (other linked modules may register counters as well)
+    auto names = CounterRegistry::getNames();
+    for (size_t i = 1; i < names.size(); i++) assert(names[i-1] < names[i]);
+}
+
+void testConcurrentIncrements() {
+    const int numThreads = 8;
+    const long numIncrements = 1'000'000;
+
+    long valueBefore = cntA.get();
+    std::vector<std::thread> threads;
+    for (int t = 0; t < numThreads; t++) {
+        threads.emplace_back([&]() {
+            for (long i = 0; i < numIncrements; i++) cntA.add();
+            cntB.add(2);
+        });
+    }
+    // Read concurrently: values only grow
+    long lastValue = valueBefore;
+    for (int i = 0; i < 100; i++) {
+        long value = cntA.get();
+        assert(value >= lastValue);
+        lastValue = value;
+    }
+    for (auto& thread : threads) thread.join();
+
+    // Values of exited threads are retained
+    long value = cntA.get();
+    LOG(V2_INFO, "a=%ld b=%ld\n", value, cntB.get());
+    assert(value == valueBefore + numThreads * numIncrements);
+    assert(cntB.get() == 2 * numThreads);
+
+    cntA.add(5);
+    assert(cntA.get() == value + 5);
+}
+
+void testForwarding() {
+    std::vector<long> lastValues;
+    CounterRegistry::serializeIncrements(lastValues);
+    // Nothing changed since the last call
+    auto data = CounterRegistry::serializeIncrements(lastValues);
+    assert(data.empty());
+
+    long valueA = cntA.get(), valueB = cntB.get();
+    cntA.add(5);
+    cntB.add(3L << 33); // exceeds 32 bits
+    data = CounterRegistry::serializeIncrements(lastValues);
+    assert(!data.empty());
+    assert(CounterRegistry::serializeIncrements(lastValues).empty());
+
+    // Adding the forwarded increments (here to the same process) doubles them
+    CounterRegistry::addSerializedIncrements(data);
+    assert(cntA.get() == valueA + 10);
+    assert(cntB.get() == valueB + (3L << 34));
+
+    // Unknown names are ignored
+    std::vector<int> unknown {6, 0, 0, 1, 0};
+    memcpy(unknown.data()+1, "test.x", 6);
+    CounterRegistry::addSerializedIncrements(unknown);
+    assert(CounterRegistry::getId("test.x") == -1);
+    assert(cntA.get() == valueA + 10);
+}
+
+int main() {
+    Timer::init();
+    Random::init(rand(), rand());
+    Logger::init(0, V5_DEBG);
+
+    testRegistration();
+    testConcurrentIncrements();
+    testForwarding();
+}
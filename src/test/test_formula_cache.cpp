@@ -0,0 +1,131 @@
+
+#include <assert.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "app/sat/parse/formula_cache.hpp"
+#include "app/sat/parse/sat_reader.hpp"
+#include "data/job_description.hpp"
+#include "util/logger.hpp"
+#include "util/params.hpp"
+#include "util/random.hpp"
+#include "util/sys/fileutils.hpp"
+#include "util/sys/timer.hpp"
+
+const std::string cacheDir = "/tmp/mallob_test_formula_cache";
+
+std::vector<int> getPayload(const JobDescription& desc) {
+    return std::vector<int>(desc.getFormulaPayload(0), desc.getFormulaPayload(0) + desc.getFormulaPayloadSize(0));
+}
+
+std::vector<int> readFormula(const Parameters& params, const std::string& file, int& nbVars, int& nbClauses) {
+    SatReader r(params, file);
+    JobDescription d(1, 1, 0);
+    bool success = r.read(d);
+    assert(success);
+    nbVars = r.getNbVars();
+    nbClauses = r.getNbClauses();
+    return getPayload(d);
+}
+
+size_t getNumCacheEntries() {
+    return FileUtils::glob(cacheDir + "/*.mfc").size();
+}
+
+void testCachedReads(Parameters& params) {
+    const std::string input = "/tmp/mallob_test_formula_cache_input.cnf";
+    {
+        std::ofstream ofs(input);
+        ofs << "p cnf 3 3\n1 2 0\n-1 3 0\n-2 -3 0\n";
+    }
+    params.formulaCacheDirectory.set(cacheDir);
+
+    // First read: parsed from text and inserted into the cache
+    int nbVars, nbClauses;
+    auto parsed = readFormula(params, input, nbVars, nbClauses);
+    assert(getNumCacheEntries() == 1);
+    assert(nbVars == 3 && nbClauses == 3);
+
+    // Second read: served from the cache
+    int cachedNbVars, cachedNbClauses;
+    auto cached = readFormula(params, input, cachedNbVars, cachedNbClauses);
+    assert(cached == parsed);
+    assert(cachedNbVars == nbVars && cachedNbClauses == nbClauses);
+    assert(getNumCacheEntries() == 1);
+
+    // A modified input must not be served from the stale entry
+    usleep(10'000);
+    {
+        std::ofstream ofs(input, std::ofstream::app);
+        ofs << "4 0\n";
+    }
+    auto modified = readFormula(params, input, nbVars, nbClauses);
+    assert(modified.size() == parsed.size() + 2);
+    assert(nbVars == 4 && nbClauses == 4);
+    assert(getNumCacheEntries() == 2);
+
+    params.formulaCacheDirectory.set("");
+    remove(input.c_str());
+}
+
+void testEviction() {
+    // Each entry takes a few hundred bytes: the bound fits only two of them
+    FormulaCache cache(cacheDir, 1200);
+    std::vector<std::string> inputs;
+    for (int i = 0; i < 4; i++) {
+        std::string input = "/tmp/mallob_test_formula_cache_input." + std::to_string(i) + ".cnf";
+        JobDescription desc(1, 1, 0);
+        desc.beginInitialization(0);
+        for (int c = 0; c < 30; c++) {
+            int lits[] {1+c, -(2+c), 0};
+            desc.addPermanentData(lits, 3);
+        }
+        {
+            std::ofstream ofs(input);
+            ofs << "c dummy input " << i << "\n";
+        }
+        cache.store(input, "text", desc, 31, 30);
+        desc.endInitialization();
+        inputs.push_back(input);
+        usleep(10'000);
+    }
+    assert(getNumCacheEntries() == 2);
+
+    // The most recent entries survived
+    for (int i = 0; i < 4; i++) {
+        JobDescription desc(1, 1, 0);
+        desc.beginInitialization(0);
+        int nbVars = 0, nbClauses = 0;
+        bool hit = cache.load(inputs[i], "text", desc, nbVars, nbClauses);
+        desc.endInitialization();
+        assert(hit == (i >= 2));
+        if (hit) {
+            assert(nbVars == 31 && nbClauses == 30);
+            assert(desc.getNumFormulaLiterals() == 90);
+        }
+        // a different variant is a different entry
+        JobDescription other(1, 1, 0);
+        other.beginInitialization(0);
+        hit = cache.load(inputs[i], "raw", other, nbVars, nbClauses);
+        assert(!hit);
+    }
+    for (auto& input : inputs) remove(input.c_str());
+}
+
+int main(int argc, char *argv[]) {
+    Timer::init();
+    Random::init(rand(), rand());
+    Logger::init(0, V5_DEBG);
+
+    Parameters params;
+    params.init(argc, argv);
+
+    FileUtils::rmrf(cacheDir);
+    testCachedReads(params);
+    FileUtils::rmrf(cacheDir);
+    testEviction();
+    FileUtils::rmrf(cacheDir);
+}
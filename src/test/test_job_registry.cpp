@@ -0,0 +1,111 @@
+
+#include <assert.h>
+
+#include "app/app_registry.hpp"
+#include "app/dummy/dummy_job.hpp"
+#include "comm/mympi.hpp"
+#include "core/job_registry.hpp"
+#include "data/job_transfer.hpp"
+#include "util/logger.hpp"
+#include "util/params.hpp"
+#include "util/random.hpp"
+#include "util/sys/process.hpp"
+#include "util/sys/timer.hpp"
+
+int appId;
+
+JobRequest lightRootRequest(int jobId) {
+    JobRequest req(jobId, appId, /*rootRank=*/0, /*requestingNodeRank=*/0, /*requestedNodeIndex=*/0,
+        Timer::elapsedSeconds(), /*balancingEpoch=*/0, /*numHops=*/0, /*incremental=*/false);
+    req.light = true;
+    return req;
+}
+
+// Mirrors the scheduler: commit to the job, then (upon receiving its description) uncommit and execute it
+Job& adopt(JobRegistry& registry, int jobId) {
+    Job& job = registry.create(jobId, appId, false);
+    job.commit(lightRootRequest(jobId));
+    registry.setCommitted();
+    job.uncommit();
+    registry.unsetCommitted();
+    job.start();
+    registry.setLoad(1, jobId);
+    return job;
+}
+
+void testCoHosting(Parameters& params) {
+    LOG(V2_INFO, "#### Test light job co-hosting ####\n");
+    params.lightJobsPerProcess.set(3);
+    MPI_Comm comm = MPI_COMM_WORLD;
+    JobRegistry registry(params, comm);
+
+    // Idle PE: light jobs are adopted regularly, not co-hosted
+    assert(!registry.canCoHostLightJob());
+    Job& a = adopt(registry, 1);
+    assert(!a.isCoHosted());
+    assert(registry.canCoHostLightJob());
+
+    // A request arrives while the PE is committed to another light job
+    Job& b = registry.create(2, appId, false);
+    b.commit(lightRootRequest(2));
+    registry.setCommitted();
+    assert(!registry.canCoHostLightJob());
+    b.uncommit();
+    registry.unsetCommitted();
+    assert(registry.canCoHostLightJob());
+    b.start();
+    registry.setLoad(1, 2);
+    assert(b.isCoHosted());
+    assert(registry.getNumCoHostedLightJobs() == 1);
+
+    // Limit of light jobs per PE reached
+    Job& c = adopt(registry, 3);
+    assert(c.isCoHosted());
+    assert(!registry.canCoHostLightJob());
+
+    // The current job leaves: the first co-hosted job takes its place
+    a.terminate();
+    registry.setLoad(0, 1);
+    assert(registry.getActive().getId() == 2);
+    assert(!b.isCoHosted());
+    assert(c.isCoHosted());
+    assert(registry.canCoHostLightJob());
+
+    // A co-hosted job leaves
+    c.terminate();
+    registry.setLoad(0, 3);
+    assert(!c.isCoHosted());
+    assert(registry.getNumCoHostedLightJobs() == 0);
+    b.terminate();
+    registry.setLoad(0, 2);
+    assert(!registry.hasActiveJob());
+
+    for (Job* job : {&a, &b, &c}) registry.erase(job);
+    registry.checkOldJobs();
+    assert(!registry.hasJobsLeftToDelete());
+}
+
+int main(int argc, char *argv[]) {
+    MyMpi::init();
+    Timer::init();
+    int rank = MyMpi::rank(MPI_COMM_WORLD);
+    Process::init(rank);
+    Random::init(rand(), rand());
+    Logger::init(rank, V5_DEBG);
+
+    Parameters params;
+    params.init(argc, argv);
+
+    app_registry::registerApplication("DUMMY",
+        [](const Parameters& params, const std::vector<std::string>& files, JobDescription& desc) {return false;},
+        [](const Parameters& params, const Job::JobSetup& setup, AppMessageTable& table) -> Job* {
+            return new DummyJob(params, setup, table);
+        },
+        [](const JobResult& result) {return nlohmann::json();}
+    );
+    appId = app_registry::getAppId("DUMMY");
+
+    testCoHosting(params);
+
+    MPI_Finalize();
+}
@@ -0,0 +1,150 @@
+
+#include <algorithm>
+#include <assert.h>
+#include <atomic>
+#include <unistd.h>
+
+#include "app/job_tree.hpp"
+#include "comm/job_tree_all_reduction.hpp"
+#include "comm/msgtags.h"
+#include "comm/mympi.hpp"
+#include "data/job_transfer.hpp"
+#include "util/logger.hpp"
+#include "util/params.hpp"
+#include "util/random.hpp"
+#include "util/sys/process.hpp"
+#include "util/sys/thread_pool.hpp"
+#include "util/sys/timer.hpp"
+
+typedef JobTreeAllReduction::AllReduceElement Elem;
+
+const int jobId = 1;
+const int epoch = 0;
+const int msgTag = 42;
+
+// Allows to hold back the aggregation in order to let the broadcast overtake it
+std::atomic_bool aggregationReleased {true};
+
+// Inner node (index 1) with a single (left) child. All tree nodes reside on this rank,
+// so the messages sent by the all-reduction are self messages which are never processed.
+JobTree createTree() {
+    JobTree tree(/*commSize=*/4, /*rank=*/0, /*contextId=*/1, /*seed=*/1, false);
+    tree.update(/*index=*/1, /*rootRank=*/0, /*rootContextId=*/2, /*parentRank=*/0, /*parentContextId=*/2);
+    tree.setLeftChild(0, 3);
+    return tree;
+}
+
+JobTreeAllReduction createAllReduction(JobTree& tree) {
+    return JobTreeAllReduction(tree, JobMessage(jobId, 0, 0, epoch, msgTag), Elem(),
+        [](std::list<Elem>& elems) {
+            while (!aggregationReleased) usleep(1000);
+            Elem result;
+            for (auto& elem : elems) result.insert(result.end(), elem.begin(), elem.end());
+            std::sort(result.begin(), result.end());
+            return result;
+        });
+}
+
+void receive(JobTreeAllReduction& allred, int tag, std::initializer_list<int> payload) {
+    JobMessage msg(jobId, 1, 0, epoch, msgTag, payload);
+    bool accepted = allred.receive(0, tag, msg);
+    assert(accepted);
+}
+
+void testEarlyBroadcastBeforeAggregation() {
+    LOG(V2_INFO, "#### Test early broadcast before aggregation ####\n");
+    JobTree tree = createTree();
+    auto allred = createAllReduction(tree);
+    allred.setChildDeadline(60);
+    allred.produce([]() {return Elem {1};});
+    allred.advance();
+    receive(allred, MSG_JOB_TREE_BROADCAST, {7});
+    assert(allred.hasResult());
+
+    // The child element arrives too late for the final result, but is still collected
+    receive(allred, MSG_JOB_TREE_REDUCTION, {2});
+
+    Elem result = allred.extractResult();
+    assert(result == Elem {7});
+    auto unforwarded = allred.extractUnforwardedElems();
+    assert(unforwarded.size() == 2);
+    assert(unforwarded.front() == Elem {1});
+    assert(unforwarded.back() == Elem {2});
+    unforwarded = allred.extractUnforwardedElems();
+    assert(unforwarded.empty());
+
+    // After the extraction, further child elements are rejected
+    JobMessage msg(jobId, 1, 0, epoch, msgTag, {3});
+    bool accepted = allred.receive(0, MSG_JOB_TREE_REDUCTION, msg);
+    assert(!accepted);
+}
+
+void testEarlyBroadcastDuringAggregation() {
+    LOG(V2_INFO, "#### Test early broadcast during aggregation ####\n");
+    JobTree tree = createTree();
+    auto allred = createAllReduction(tree);
+    allred.setChildDeadline(60);
+    allred.produce([]() {return Elem {1};});
+    // Complete set of elements: the aggregation begins, but is not forwarded yet
+    aggregationReleased = false;
+    receive(allred, MSG_JOB_TREE_REDUCTION, {2});
+    receive(allred, MSG_JOB_TREE_BROADCAST, {7});
+    assert(allred.hasResult());
+    assert(!allred.isDestructible());
+    aggregationReleased = true;
+
+    Elem result = allred.extractResult();
+    assert(result == Elem {7});
+    auto unforwarded = allred.extractUnforwardedElems();
+    assert(unforwarded.size() == 1);
+    assert(unforwarded.front() == Elem({1, 2}));
+    assert(allred.isDestructible());
+}
+
+void testDeadline() {
+    LOG(V2_INFO, "#### Test child deadline ####\n");
+    JobTree tree = createTree();
+    auto allred = createAllReduction(tree);
+    allred.setChildDeadline(0.01);
+    allred.produce([]() {return Elem {1};});
+    allred.advance();
+    assert(allred.getNumMissedChildElems() == 0);
+
+    // The child misses the deadline: the local element is aggregated and forwarded alone
+    usleep(20 * 1000);
+    allred.advance();
+    assert(allred.getNumMissedChildElems() == 1);
+    while (!allred.isDestructible()) usleep(1000);
+    allred.advance();
+
+    // The late child element is rejected, and nothing is left unforwarded
+    JobMessage msg(jobId, 1, 0, epoch, msgTag, {2});
+    bool accepted = allred.receive(0, MSG_JOB_TREE_REDUCTION, msg);
+    assert(!accepted);
+    receive(allred, MSG_JOB_TREE_BROADCAST, {1});
+    assert(allred.hasResult());
+    Elem result = allred.extractResult();
+    assert(result == Elem {1});
+    auto unforwarded = allred.extractUnforwardedElems();
+    assert(unforwarded.empty());
+}
+
+int main(int argc, char *argv[]) {
+    MyMpi::init();
+    Timer::init();
+    int rank = MyMpi::rank(MPI_COMM_WORLD);
+    Process::init(rank);
+    Random::init(rand(), rand());
+    Logger::init(rank, V5_DEBG);
+    ProcessWideThreadPool::init(2);
+
+    Parameters params;
+    params.init(argc, argv);
+    MyMpi::setOptions(params);
+
+    testEarlyBroadcastBeforeAggregation();
+    testEarlyBroadcastDuringAggregation();
+    testDeadline();
+
+    MPI_Finalize();
+}
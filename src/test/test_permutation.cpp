@@ -3,6 +3,7 @@
 #include <ext/alloc_traits.h>
 #include <stdlib.h>
 #include <set>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -11,6 +12,8 @@
 #include "util/logger.hpp"
 #include "util/sys/timer.hpp"
 #include "util/robin_hood.hpp"
+#include "util/sys/fileutils.hpp"
+#include "util/sys/proc.hpp"
 
 void testPermutations() {
 
@@ -98,6 +101,24 @@ void testBestOutgoingEdges() {
     }
 }
 
+void testPermutationCache() {
+
+    int r = 4;
+    int n = 500;
+    auto permutations = AdjustablePermutation::getPermutations(n, r);
+    std::string file = "/tmp/mallob_test_routing." + std::to_string(Proc::getPid()) + ".bin";
+    assert(AdjustablePermutation::writePermutations(file, permutations));
+
+    std::vector<std::vector<int>> readPermutations;
+    assert(AdjustablePermutation::readPermutations(file, n, r, readPermutations));
+    assert(readPermutations == permutations);
+    // Mismatching dimensions are rejected
+    assert(!AdjustablePermutation::readPermutations(file, n+1, r, readPermutations));
+    assert(!AdjustablePermutation::readPermutations(file, n, r-1, readPermutations));
+    FileUtils::rm(file);
+    assert(!AdjustablePermutation::readPermutations(file, n, r, readPermutations));
+}
+
 int main() {
 
     Timer::init();
@@ -106,4 +127,5 @@ int main() {
 
     testBestOutgoingEdges();
     testPermutations();
+    testPermutationCache();
 }
\ No newline at end of file
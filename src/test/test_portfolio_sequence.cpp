@@ -68,4 +68,27 @@ int main() {
     printf("%s\n", seq.toStr().c_str());
     assert(seq.prefix.size()==4*24);
     assert(seq.cycle.size()==1);
+
+    // Diversification indices as assigned by the SAT engine:
+    // counted within the prefix and within the repeated cycle
+    bool parsed = seq.parse("kck(lcc)*");
+    assert(parsed);
+    std::vector<std::string> expected {"k0", "c0", "k1", "l0", "c0", "c1", "l1", "c2", "c3", "l2"};
+    for (int globalId = 0; globalId < (int) expected.size(); globalId++) {
+        int divIdx;
+        auto item = seq.getItem(globalId, divIdx);
+        assert(PortfolioSequence::toConfiguration(item, divIdx) == expected[globalId]);
+    }
+
+    PortfolioSequence::Item item;
+    int divIdx;
+    parsed = PortfolioSequence::parseConfiguration("k+12", item, divIdx);
+    assert(parsed);
+    assert(item.baseSolver == PortfolioSequence::KISSAT && item.flavour == PortfolioSequence::SAT && divIdx == 12);
+    assert(PortfolioSequence::toConfiguration(item, divIdx) == "k+12");
+    parsed = PortfolioSequence::parseConfiguration("c0", item, divIdx);
+    assert(parsed);
+    assert(item.baseSolver == PortfolioSequence::CADICAL && item.flavour == PortfolioSequence::DEFAULT && divIdx == 0);
+    for (std::string invalid : {"", "k", "K3", "x1", "k+", "k3a", "kc"})
+        assert(!PortfolioSequence::parseConfiguration(invalid, item, divIdx));
 }
@@ -0,0 +1,107 @@
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+
+#include "app/sat/parse/portfolio_tuner.hpp"
+#include "app/sat/parse/sat_reader.hpp"
+#include "data/job_description.hpp"
+#include "data/job_result.hpp"
+#include "util/logger.hpp"
+#include "util/params.hpp"
+#include "util/random.hpp"
+#include "util/sys/timer.hpp"
+
+const std::string storePath = "/tmp/mallob_test_portfolio_tuner.txt";
+
+PortfolioTuner::Record makeRecord(int nbVars, int nbClauses, const std::string& tuned, const std::string& winner) {
+    return PortfolioTuner::Record {nbVars, nbClauses, (size_t) 4*nbClauses, tuned, winner,
+        winner == "-" ? 0 : 10, 1.0f};
+}
+
+void testSelection() {
+    remove(storePath.c_str());
+    PortfolioTuner tuner(storePath, 0, 8);
+    assert(tuner.select(1000, 4000, 16000) == "");
+
+    // Small instances are won by k3, large instances by c1
+    for (int i = 0; i < 10; i++) {
+        tuner.addRecord(makeRecord(1000 + 10*i, 4000 + 10*i, "-", "k3"));
+        tuner.addRecord(makeRecord(1'000'000 + i, 4'000'000 + i, "-", "c1"));
+    }
+    tuner.addRecord(makeRecord(1000, 4000, "-", "l0"));
+    assert(tuner.select(1200, 4800, 19200) == "k3");
+    assert(tuner.select(900'000, 3'900'000, 15'600'000) == "c1");
+
+    // Repeated failures of a tuned configuration outweigh its earlier wins
+    for (int i = 0; i < 40; i++) tuner.addRecord(makeRecord(1000, 4000, "k3", i < 8 ? "l0" : "-"));
+    PortfolioTuner widerTuner(storePath, 0, 64);
+    assert(widerTuner.getNumRecords() == tuner.getNumRecords());
+    assert(widerTuner.select(1000, 4000, 16000) == "l0");
+
+    // Exploration: always leave jobs untuned
+    PortfolioTuner exploringTuner(storePath, 1, 8);
+    assert(exploringTuner.select(1000, 4000, 16000) == "");
+    remove(storePath.c_str());
+}
+
+void testJobDescription(Parameters& params) {
+    remove(storePath.c_str());
+    params.satSolverSequence.set("kcl");
+    JobDescription desc(1, 1, 0);
+    PortfolioTuner::reserveConfiguration(desc);
+    desc.beginInitialization(0);
+    std::vector<int> lits {1, 2, 0, -1, 2, 0, -2, 0};
+    desc.addPermanentData(lits.data(), lits.size());
+    SatReader::storeFormulaSize(desc, 2, 3);
+    desc.endInitialization();
+
+    // Untuned: the plain portfolio's configurations
+    assert(PortfolioTuner::getConfiguration(desc) == "");
+    assert(PortfolioTuner::getConfiguration(params, desc, 0) == "k0");
+    assert(PortfolioTuner::getConfiguration(params, desc, 4) == "c1");
+
+    PortfolioTuner tuner(storePath, 0, 8);
+    for (int i = 0; i < 3; i++) tuner.addRecord(makeRecord(2, 3, "-", "l7"));
+    tuner.tune(desc);
+    assert(PortfolioTuner::getConfiguration(desc) == "l7");
+    // the serialized description carries the tuned configuration
+    std::string serialized((const char*) desc.getRevisionData(0)->data(), desc.getMetadataSize());
+    assert(serialized.find("-__PFT=l7..............;") != std::string::npos);
+
+    // The tuned configuration replaces the first solver; all others are left as they are
+    assert(PortfolioTuner::getConfiguration(params, desc, 0) == "l7");
+    assert(PortfolioTuner::getConfiguration(params, desc, 1) == "c0");
+    assert(PortfolioTuner::getConfiguration(params, desc, 2) == "l0");
+    assert(PortfolioTuner::getConfiguration(params, desc, 3) == "k1");
+    assert(PortfolioTuner::getConfiguration(params, desc, 4) == "c1");
+
+    JobResult result;
+    result.id = 1;
+    result.revision = 0;
+    result.result = 10;
+    result.winningInstanceId = 3;
+    tuner.record(params, desc, result);
+    PortfolioTuner reloaded(storePath, 0, 8);
+    assert(reloaded.getNumRecords() == 4);
+
+    // The winning instance survives the serialization of the result
+    result.setSolution({0, 1, -2});
+    JobResult received(result.serialize());
+    assert(received.winningInstanceId == 3 && received.getSolutionSize() == 3 && received.getSolution(2) == -2);
+    remove(storePath.c_str());
+}
+
+int main(int argc, char *argv[]) {
+    Timer::init();
+    Random::init(rand(), rand());
+    Logger::init(0, V5_DEBG);
+
+    Parameters params;
+    params.init(argc, argv);
+
+    testSelection();
+    testJobDescription(params);
+}
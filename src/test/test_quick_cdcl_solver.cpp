@@ -0,0 +1,145 @@
+
+#include <assert.h>
+#include <stdlib.h>
+#include <cmath>
+#include <vector>
+
+#include "app/sat/solvers/quick_cdcl_solver.hpp"
+#include "util/logger.hpp"
+#include "util/random.hpp"
+#include "util/sys/timer.hpp"
+
+std::vector<int> getRandom3Sat(int numVars, int numClauses) {
+    std::vector<int> lits;
+    for (int c = 0; c < numClauses; c++) {
+        for (int i = 0; i < 3; i++) {
+            int var = 1 + (int) (Random::rand() * numVars) % numVars;
+            lits.push_back(Random::rand() < 0.5 ? var : -var);
+        }
+        lits.push_back(0);
+    }
+    return lits;
+}
+
+// Clauses stating that n+1 pigeons sit in n holes, no two pigeons sharing a hole
+std::vector<int> getPigeonhole(int numHoles) {
+    auto var = [&](int pigeon, int hole) {return 1 + pigeon*numHoles + hole;};
+    std::vector<int> lits;
+    for (int p = 0; p <= numHoles; p++) {
+        for (int h = 0; h < numHoles; h++) lits.push_back(var(p, h));
+        lits.push_back(0);
+    }
+    for (int h = 0; h < numHoles; h++) for (int p1 = 0; p1 <= numHoles; p1++) for (int p2 = p1+1; p2 <= numHoles; p2++) {
+        lits.insert(lits.end(), {-var(p1, h), -var(p2, h), 0});
+    }
+    return lits;
+}
+
+bool isModel(const std::vector<int>& lits, const std::vector<int>& model) {
+    bool satisfied = false;
+    for (int lit : lits) {
+        if (lit == 0) {
+            if (!satisfied) return false;
+            satisfied = false;
+            continue;
+        }
+        if (std::abs(lit) < model.size() && model[std::abs(lit)] == lit) satisfied = true;
+    }
+    return true;
+}
+
+bool isSatisfiableByBruteForce(const std::vector<int>& lits, int numVars) {
+    std::vector<int> model(numVars+1);
+    for (unsigned long assignment = 0; assignment < (1UL << numVars); assignment++) {
+        for (int v = 1; v <= numVars; v++) model[v] = ((assignment >> (v-1)) & 1) ? v : -v;
+        if (isModel(lits, model)) return true;
+    }
+    return false;
+}
+
+void testTrivialFormulas() {
+    {
+        std::vector<int> lits {1, 2, 0, -1, 0, -2, 3, 0};
+        QuickCdclSolver solver(lits.data(), lits.size());
+        int result = solver.solve(100, 0);
+        assert(result == RESULT_SAT);
+        auto model = solver.getModel();
+        assert(model.size() == 4);
+        assert(isModel(lits, model));
+    }
+    {
+        std::vector<int> lits {1, 0, 2, 2, -1, 0, -2, 0};
+        QuickCdclSolver solver(lits.data(), lits.size());
+        int result = solver.solve(100, 0);
+        assert(result == RESULT_UNSAT);
+        assert(solver.getNumConflicts() == 0);
+    }
+    {
+        // tautologies only
+        std::vector<int> lits {1, -1, 0, 2, 3, -2, 0};
+        QuickCdclSolver solver(lits.data(), lits.size());
+        int result = solver.solve(100, 0);
+        assert(result == RESULT_SAT);
+    }
+}
+
+void testAgainstBruteForce() {
+    const int numVars = 12;
+    int numSat = 0, numUnsat = 0;
+    for (int rep = 0; rep < 300; rep++) {
+        auto lits = getRandom3Sat(numVars, 40 + rep % 40);
+        QuickCdclSolver solver(lits.data(), lits.size());
+        int result = solver.solve(100'000, 0);
+        assert(result != 0);
+        bool sat = isSatisfiableByBruteForce(lits, numVars);
+        assert(sat == (result == RESULT_SAT));
+        if (sat) {
+            assert(isModel(lits, solver.getModel()));
+            numSat++;
+        } else numUnsat++;
+    }
+    LOG(V2_INFO, "%i SAT, %i UNSAT random formulas verified\n", numSat, numUnsat);
+    assert(numSat > 0 && numUnsat > 0);
+}
+
+void testLargerFormulas() {
+    for (int rep = 0; rep < 10; rep++) {
+        auto lits = getRandom3Sat(150, 600);
+        QuickCdclSolver solver(lits.data(), lits.size());
+        int result = solver.solve(1'000'000, 0);
+        assert(result != 0);
+        if (result == RESULT_SAT) assert(isModel(lits, solver.getModel()));
+    }
+    auto lits = getPigeonhole(6);
+    QuickCdclSolver solver(lits.data(), lits.size());
+    int result = solver.solve(1'000'000, 0);
+    assert(result == RESULT_UNSAT);
+    LOG(V2_INFO, "PHP(7,6) refuted after %lu conflicts\n", solver.getNumConflicts());
+}
+
+void testBudget() {
+    auto lits = getPigeonhole(10);
+    QuickCdclSolver solver(lits.data(), lits.size());
+    int result = solver.solve(50, 0);
+    assert(result == 0);
+    assert(solver.getNumConflicts() == 50);
+
+    QuickCdclSolver timedSolver(lits.data(), lits.size());
+    float time = Timer::elapsedSeconds();
+    result = timedSolver.solve(1'000'000'000, 0.05);
+    assert(result == 0);
+    time = Timer::elapsedSeconds() - time;
+    LOG(V2_INFO, "Time-limited solve returned after %.3fs, %lu conflicts\n", time, timedSolver.getNumConflicts());
+    assert(time < 1);
+}
+
+int main() {
+    Timer::init();
+    Random::init(rand(), rand());
+    Logger::init(0, V5_DEBG);
+
+    testTrivialFormulas();
+    testAgainstBruteForce();
+    testLargerFormulas();
+    testBudget();
+}
@@ -1,8 +1,10 @@
 
 #include <assert.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string>
 #include <initializer_list>
+#include <vector>
 
 #include "util/random.hpp"
 #include "app/sat/parse/sat_reader.hpp"
@@ -11,6 +13,127 @@
 #include "util/params.hpp"
 #include "data/job_description.hpp"
 
+std::vector<int> readFormula(const Parameters& params, const std::string& file) {
+    SatReader r(params, file);
+    JobDescription d(1, 1, 0);
+    bool success = r.read(d);
+    assert(success);
+    return std::vector<int>(d.getFormulaPayload(0), d.getFormulaPayload(0) + d.getFormulaPayloadSize(0));
+}
+
+void testCompressedFormats(const Parameters& params) {
+    const std::string plainFile = "instances/r3unsat_200.cnf";
+    auto expected = readFormula(params, plainFile);
+    assert(!expected.empty());
+
+    // The format is detected by the content, so a misleading extension is fine
+    std::vector<std::pair<std::string, std::string>> tools {
+        {"gzip", "/tmp/mallob_test_formula.cnf.gz"}, {"gzip", "/tmp/mallob_test_formula_gz.cnf"},
+        {"bzip2", "/tmp/mallob_test_formula.cnf.bz2"}, {"xz", "/tmp/mallob_test_formula.cnf.xz"},
+        {"zstd", "/tmp/mallob_test_formula.cnf.zst"}
+    };
+    for (auto& [tool, file] : tools) {
+        if (system(("command -v " + tool + " > /dev/null").c_str()) != 0) {
+            LOG(V2_INFO, "%s not available - skipping\n", tool.c_str());
+            continue;
+        }
+        int retval = system((tool + " -c " + plainFile + " > " + file).c_str());
+        assert(retval == 0);
+        auto format = DecompressingReader::detectFormat(file);
+        LOG(V2_INFO, "Reading %s (detected: %s) ...\n", file.c_str(), DecompressingReader::getFormatName(format));
+        assert(format != DecompressingReader::PLAIN);
+        auto formula = readFormula(params, file);
+        assert(formula == expected);
+        remove(file.c_str());
+    }
+}
+
+bool readRawFormula(const Parameters& params, const std::string& file, std::vector<int>& formula,
+        std::vector<int>& assumptions, int& nbVars, int& nbClauses) {
+    SatReader r(params, file);
+    JobDescription d(1, 1, 0);
+    d.setAppConfigurationEntry("content-mode", "raw");
+    if (!r.read(d)) return false;
+    formula.assign(d.getFormulaPayload(0), d.getFormulaPayload(0) + d.getFormulaPayloadSize(0));
+    assumptions.assign(d.getAssumptionsPayload(0), d.getAssumptionsPayload(0) + d.getNumAssumptionLiterals());
+    nbVars = r.getNbVars();
+    nbClauses = r.getNbClauses();
+    return true;
+}
+
+void writeInts(const std::string& file, const std::vector<int>& data) {
+    FILE* f = fopen(file.c_str(), "wb");
+    assert(f);
+    size_t numWritten = fwrite(data.data(), sizeof(int), data.size(), f);
+    assert(numWritten == data.size());
+    fclose(f);
+}
+
+void testRawContentMode(const Parameters& params) {
+    // Large enough to span many blocks of the bulk ingestion
+    std::vector<int> clauses;
+    int maxVar = 0, numClauses = 0;
+    for (int c = 0; c < 50'000; c++) {
+        int len = 1 + (int) (Random::rand() * 5);
+        for (int i = 0; i < len; i++) {
+            int var = 1 + (int) (Random::rand() * 10'000);
+            maxVar = std::max(maxVar, var);
+            clauses.push_back(Random::rand() < 0.5 ? -var : var);
+        }
+        clauses.push_back(0);
+        numClauses++;
+    }
+    std::vector<int> assumptions {-3, 7, 12'345};
+    std::vector<int> content = clauses;
+    content.push_back(0);
+    content.insert(content.end(), assumptions.begin(), assumptions.end());
+    content.push_back(0);
+
+    const std::string file = "/tmp/mallob_test_formula.raw";
+    std::vector<int> readClauses, readAssumptions;
+    int nbVars, nbClauses;
+
+    writeInts(file, content);
+    bool ok = readRawFormula(params, file, readClauses, readAssumptions, nbVars, nbClauses);
+    assert(ok);
+    assert(readClauses == clauses);
+    assert(readAssumptions == assumptions);
+    assert(nbVars == std::max(maxVar, 12'345));
+    assert(nbClauses == numClauses);
+
+    // Same content via the streaming (decompressing) path
+    if (system("command -v gzip > /dev/null") == 0) {
+        int retval = system(("gzip -c " + file + " > " + file + ".gz").c_str());
+        assert(retval == 0);
+        ok = readRawFormula(params, file + ".gz", readClauses, readAssumptions, nbVars, nbClauses);
+        assert(ok);
+        assert(readClauses == clauses);
+        assert(readAssumptions == assumptions);
+        remove((file + ".gz").c_str());
+    }
+
+    // No assumptions: the formula ends right at the beginning of a block
+    content.assign({1, -2, 0, 0, 0});
+    writeInts(file, content);
+    ok = readRawFormula(params, file, readClauses, readAssumptions, nbVars, nbClauses);
+    assert(ok);
+    assert(readClauses == std::vector<int>({1, -2, 0}));
+    assert(readAssumptions.empty());
+    assert(nbVars == 2 && nbClauses == 1);
+
+    // Missing terminator, trailing data after the terminator
+    content = clauses;
+    writeInts(file, content);
+    ok = readRawFormula(params, file, readClauses, readAssumptions, nbVars, nbClauses);
+    assert(!ok);
+    content.insert(content.end(), {0, 0, 1});
+    writeInts(file, content);
+    ok = readRawFormula(params, file, readClauses, readAssumptions, nbVars, nbClauses);
+    assert(!ok);
+
+    remove(file.c_str());
+}
+
 int main(int argc, char *argv[]) {
 
     Timer::init();
@@ -20,6 +143,9 @@ int main(int argc, char *argv[]) {
     Parameters params;
     params.init(argc, argv);
 
+    testCompressedFormats(params);
+    testRawContentMode(params);
+
     auto files = {"Steiner-9-5-bce.cnf.xz", "uum12.smt2.cnf.xz", 
         "LED_round_29-32_faultAt_29_fault_injections_5_seed_1579630418.cnf.xz", "SAT_dat.k80.cnf.xz", "Timetable_C_497_E_62_Cl_33_S_30.cnf.xz", 
         "course0.2_2018_3-sc2018.cnf.xz", "sv-comp19_prop-reachsafety.queue_longer_false-unreach-call.i-witness.cnf.xz"};
@@ -29,7 +155,7 @@ int main(int argc, char *argv[]) {
         LOG(V2_INFO, "Reading test CNF %s ...\n", f.c_str());
         float time = Timer::elapsedSeconds();
         SatReader r(params, f);
-        JobDescription d;
+        JobDescription d(1, 1, 0);
         bool success = r.read(d);
         assert(success);
         time = Timer::elapsedSeconds() - time;
@@ -0,0 +1,93 @@
+#include <assert.h>
+#include <stdlib.h>
+#include <vector>
+
+#include "app/sat/proof/trusted/siphash/siphash.hpp"
+#include "app/sat/proof/trusted/siphash/siphash_lanes.hpp"
+#include "app/sat/proof/trusted/trusted_solving.hpp"
+#include "util/logger.hpp"
+#include "util/random.hpp"
+#include "util/sys/timer.hpp"
+
+// The actual key is provided by the checker build
+const unsigned char Secret::SECRET_KEY[] = {
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+    0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f
+};
+
+void testLanesMatchSequential() {
+    SipHash seq(Secret::SECRET_KEY);
+    SipHashLanes<4> lanes(Secret::SECRET_KEY);
+    for (int nbMsgs = 1; nbMsgs <= 4; nbMsgs++) {
+        for (int rep = 0; rep < 200; rep++) {
+            std::vector<std::vector<u8>> msgs(nbMsgs);
+            std::vector<const u8*> msgPtrs;
+            std::vector<size_t> lens;
+            std::vector<std::vector<u8>> outs(nbMsgs, std::vector<u8>(16));
+            std::vector<u8*> outPtrs;
+            for (int l = 0; l < nbMsgs; l++) {
+                // Lengths of all residues mod 8, including empty messages
+                size_t len = (size_t) (100 * Random::rand());
+                for (size_t i = 0; i < len; i++) msgs[l].push_back((u8) (256 * Random::rand()));
+                msgPtrs.push_back(msgs[l].data());
+                lens.push_back(len);
+                outPtrs.push_back(outs[l].data());
+            }
+            lanes.digest(nbMsgs, msgPtrs.data(), lens.data(), outPtrs.data());
+            for (int l = 0; l < nbMsgs; l++) {
+                const u8* expected = seq.reset().update(msgs[l].data(), lens[l]).digest();
+                assert(TrustedUtils::equalSignatures(expected, outs[l].data()));
+            }
+        }
+    }
+}
+
+void testBatchedClauseSignatures() {
+    TrustedSolving ts(100);
+    signature formulaSig;
+    for (int i = 0; i < SIG_SIZE_BYTES; i++) formulaSig[i] = i*7;
+    ts.init(formulaSig);
+
+    const int nbClauses = 1001;
+    std::vector<std::vector<int>> clauses(nbClauses);
+    std::vector<u64> ids;
+    std::vector<const int*> litPtrs;
+    std::vector<int> nbLits;
+    for (int c = 0; c < nbClauses; c++) {
+        int len = 1 + (int) (30 * Random::rand());
+        for (int i = 0; i < len; i++) clauses[c].push_back((Random::rand() < 0.5 ? -1 : 1) * (1 + i));
+        ids.push_back(1000 + 3*c);
+        litPtrs.push_back(clauses[c].data());
+        nbLits.push_back(len);
+    }
+    std::vector<u8> batched(nbClauses * SIG_SIZE_BYTES);
+    ts.computeClauseSignatures(nbClauses, ids.data(), litPtrs.data(), nbLits.data(), batched.data());
+    for (int c = 0; c < nbClauses; c++) {
+        signature expected;
+        ts.computeClauseSignature(ids[c], litPtrs[c], nbLits[c], expected);
+        assert(TrustedUtils::equalSignatures(expected, batched.data() + c*SIG_SIZE_BYTES));
+    }
+
+    // Timing of sequential vs. batched signature computation
+    const int nbReps = 100;
+    float time = Timer::elapsedSeconds();
+    for (int r = 0; r < nbReps; r++) for (int c = 0; c < nbClauses; c++) {
+        signature sig;
+        ts.computeClauseSignature(ids[c], litPtrs[c], nbLits[c], sig);
+    }
+    float timeSequential = Timer::elapsedSeconds() - time;
+    time = Timer::elapsedSeconds();
+    for (int r = 0; r < nbReps; r++)
+        ts.computeClauseSignatures(nbClauses, ids.data(), litPtrs.data(), nbLits.data(), batched.data());
+    float timeBatched = Timer::elapsedSeconds() - time;
+    LOG(V2_INFO, "%i signatures: sequential %.4fs, batched %.4fs\n", nbReps*nbClauses, timeSequential, timeBatched);
+}
+
+int main() {
+    Timer::init();
+    Random::init(rand(), rand());
+    Logger::init(0, V5_DEBG);
+
+    testLanesMatchSequential();
+    testBatchedClauseSignatures();
+}
@@ -0,0 +1,125 @@
+
+#include <assert.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <list>
+#include <vector>
+
+#include "app/sat/data/clause.hpp"
+#include "app/sat/data/clause_metadata.hpp"
+#include "app/sat/sharing/buffer/buffer_reducer.hpp"
+#include "app/sat/sharing/filter/in_place_clause_filtering.hpp"
+#include "app/sat/sharing/filter/sparse_filter_vector.hpp"
+#include "app/sat/sharing/store/adaptive_clause_store.hpp"
+#include "util/params.hpp"
+#include "util/sys/timer.hpp"
+#include "util/logger.hpp"
+#include "util/random.hpp"
+#include "util/sys/process.hpp"
+
+std::vector<int> getRandomFilter(int numBits, float density, bool runs) {
+    std::vector<int> filter((numBits+31) / 32, 0);
+    int bit = 0;
+    while (bit < numBits) {
+        bool set = Random::rand() < density;
+        // Clustered bits: decide for a run of up to 100 bits at once
+        int length = runs ? 1 + (int) (100*Random::rand()) : 1;
+        for (int i = bit; i < std::min(numBits, bit+length); i++)
+            if (set) filter[i/32] |= 1 << (i%32);
+        bit += length;
+    }
+    return filter;
+}
+
+void testRoundTripAndMerge() {
+    for (int numBits : {0, 1, 31, 32, 33, 1000, 100'000}) {
+        for (float density : {0.f, 0.001f, 0.05f, 0.5f, 0.99f, 1.f}) {
+            for (bool runs : {false, true}) {
+                std::list<std::vector<int>> encoded;
+                std::vector<int> expectedOr((numBits+31) / 32, 0);
+                for (int n = 0; n < 4; n++) {
+                    // Some contributions may be shorter (or empty)
+                    int myNumBits = n == 3 ? numBits/2 : numBits;
+                    auto filter = getRandomFilter(myNumBits, density, runs);
+                    for (size_t i = 0; i < filter.size(); i++) expectedOr[i] |= filter[i];
+
+                    auto enc = SparseFilterVector::compress(filter);
+                    assert(enc.size() <= filter.size()+2);
+                    assert(SparseFilterVector::decompress(enc) == filter);
+                    encoded.push_back(std::move(enc));
+                }
+                // Neutral element
+                encoded.push_back(std::vector<int>());
+
+                auto merged = SparseFilterVector::merge(encoded);
+                assert(SparseFilterVector::decompress(merged) == expectedOr);
+                LOG(V2_INFO, "bits=%i density=%.3f runs=%i : merged size %i, encoding %i\n",
+                    numBits, density, runs, merged.size(), SparseFilterVector::getEncoding(merged));
+                if (numBits >= 1000 && density == 0.001f && !runs)
+                    assert(SparseFilterVector::getEncoding(merged) == SparseFilterVector::INDICES);
+                if (numBits >= 1000 && density == 1.f)
+                    assert(SparseFilterVector::getEncoding(merged) == SparseFilterVector::RUNS);
+                if (numBits >= 1000 && density == 0.5f && !runs)
+                    assert(SparseFilterVector::getEncoding(merged) == SparseFilterVector::DENSE);
+            }
+        }
+    }
+}
+
+void testInPlaceFiltering(const Parameters& params) {
+    AdaptiveClauseStore::Setup setup;
+    setup.numLiterals = 100'000;
+    setup.maxEffectiveClauseLength = params.strictClauseLengthLimit();
+    setup.slotsForSumOfLengthAndLbd = params.groupClausesByLengthLbdSum();
+    AdaptiveClauseStore store(setup);
+    for (int c = 0; c < 10'000; c++) {
+        int length = 1 + (int) (20*Random::rand());
+        std::vector<int> lits;
+        for (int i = 0; i < length; i++) lits.push_back(1 + i + 20*c);
+        store.addClause(Mallob::Clause(lits.data(), lits.size(), std::min(length, 2)));
+    }
+    int numClauses, numLits;
+    auto buffer = store.exportBuffer(setup.numLiterals, numClauses, numLits);
+    LOG(V2_INFO, "Buffer with %i clauses\n", numClauses);
+
+    for (float density : {0.f, 0.01f, 0.5f, 1.f}) {
+        for (bool runs : {false, true}) {
+            auto filter = getRandomFilter(numClauses, density, runs);
+            if (ClauseMetadata::enabled()) filter.insert(filter.begin(), 2, 0);
+
+            // Reference: bit-by-bit filtering
+            auto expected = buffer;
+            int clsIdx = 0;
+            BufferReducer reducer(expected.data(), expected.size(),
+                params.strictClauseLengthLimit()+ClauseMetadata::numInts(), params.groupClausesByLengthLbdSum());
+            int offset = ClauseMetadata::enabled() ? 2 : 0;
+            int expectedSize = reducer.reduce([&]() {
+                bool admitted = (filter[offset + clsIdx/32] & (1 << (clsIdx%32))) == 0;
+                clsIdx++;
+                return admitted;
+            });
+            expected.resize(expectedSize);
+
+            auto actual = buffer;
+            InPlaceClauseFiltering filtering(params, actual, filter);
+            actual.resize(filtering.applyAndGetNewSize());
+            assert(actual == expected);
+            assert(filtering.getNumClauses() == numClauses);
+            LOG(V2_INFO, "density=%.2f runs=%i : %i/%i admitted\n", density, runs,
+                filtering.getNumAdmittedClauses(), filtering.getNumClauses());
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    Timer::init();
+    Random::init(rand(), rand());
+    Logger::init(0, V5_DEBG);
+    Process::init(0);
+
+    Parameters params;
+    params.init(argc, argv);
+
+    testRoundTripAndMerge();
+    testInPlaceFiltering(params);
+}
@@ -8,6 +8,7 @@
 #include "util/sys/timer.hpp"
 #include "util/random.hpp"
 #include "balancing/volume_calculator.hpp"
+#include "balancing/volume_hysteresis.hpp"
 #include "balancing/balancing_entry.hpp"
 #include "balancing/event_map.hpp"
 #include "util/logger.hpp"
@@ -224,6 +225,103 @@ void testTinyModifier(Parameters& params) {
     auto result = testEventMap(params, map, /*numWorkers=*/100, /*expectedUtilization=*/100);
 }
 
+void testLightJobs(Parameters& params) {
+    LOG(V2_INFO, "#### Test light jobs ####\n");
+    EventMap map;
+    // 40 light jobs share 10 PEs (30 of them co-hosted), leaving 90 PEs to the other two jobs
+    for (int j = 0; j < 40; j++)
+        map.insertIfNovel(Event({/*ID=*/j+1, /*epoch=*/1, /*demand=*/1, /*priority=*/0.5, /*coHosted=*/j%4 != 0}));
+    map.insertIfNovel(Event({/*ID=*/41, /*epoch=*/1, /*demand=*/1000, /*priority=*/0.5}));
+    map.insertIfNovel(Event({/*ID=*/42, /*epoch=*/1, /*demand=*/1000, /*priority=*/0.5}));
+
+    auto result = testEventMap(params, map, /*numWorkers=*/100, /*expectedUtilization=*/130);
+    for (const auto& entry : result) {
+        if (entry.jobId <= 40) assert(entry.volume == 1);
+        else assert(entry.volume == 45);
+    }
+
+    // Light jobs which (so far) run on PEs of their own are not credited
+    for (int j = 0; j < 40; j++)
+        map.insertIfNovel(Event({/*ID=*/j+1, /*epoch=*/2, /*demand=*/1, /*priority=*/0.5, /*coHosted=*/j%4 == 1}));
+    result = testEventMap(params, map, /*numWorkers=*/100, /*expectedUtilization=*/110);
+    for (const auto& entry : result) {
+        if (entry.jobId <= 40) assert(entry.volume == 1);
+        else assert(entry.volume == 35);
+    }
+}
+
+void testHysteresis(Parameters& params) {
+    LOG(V2_INFO, "#### Test hysteresis ####\n");
+    VolumeHysteresis hysteresis(/*enabled=*/true, /*shrinkInterval=*/3, /*epochDuration=*/0.1);
+    EventMap map;
+    for (int id = 1; id <= 3; id++)
+        map.insertIfNovel(Event({id, /*epoch=*/1, /*demand=*/100, /*priority=*/1, /*coHosted=*/false, /*startupCost=*/0.2}));
+
+    auto balance = [&](int epoch, std::vector<std::pair<int, int>> targets, std::vector<int> demands = {}) {
+        std::vector<BalancingEntry> entries;
+        for (size_t i = 0; i < targets.size(); i++) {
+            auto [id, volume] = targets[i];
+            entries.emplace_back(id, i < demands.size() ? demands[i] : 100, 1);
+            entries.back().volume = volume;
+        }
+        hysteresis.apply(epoch, entries, map, /*availableVolume=*/100);
+        std::vector<int> volumes;
+        for (auto& entry : entries) volumes.push_back(entry.volume);
+        return volumes;
+    };
+
+    // New jobs receive their volume immediately
+    auto volumes = balance(1, {{1, 50}, {2, 50}});
+    assert(volumes == std::vector<int>({50, 50}));
+    assert(!hysteresis.hasDeferredChanges());
+    // Recent jobs shrink nevertheless if another job needs the PEs
+    volumes = balance(2, {{1, 45}, {2, 45}, {3, 10}});
+    assert(volumes == std::vector<int>({45, 45, 10}));
+    // Growth is deferred until the withheld PE time of 5*0.1s per epoch pays for 5*0.2s of startup
+    volumes = balance(3, {{1, 50}, {2, 50}});
+    assert(volumes == std::vector<int>({45, 45}));
+    assert(hysteresis.hasDeferredChanges());
+    volumes = balance(4, {{1, 50}, {2, 50}});
+    assert(volumes == std::vector<int>({45, 45}));
+    volumes = balance(5, {{1, 50}, {2, 50}});
+    assert(volumes == std::vector<int>({50, 50}));
+    // A voluntary shrink waits for the shrink interval to pass since the last change
+    volumes = balance(6, {{1, 48}, {2, 50}});
+    assert(volumes == std::vector<int>({50, 50}));
+    volumes = balance(7, {{1, 48}, {2, 50}});
+    assert(volumes == std::vector<int>({50, 50}));
+    volumes = balance(8, {{1, 48}, {2, 50}});
+    assert(volumes == std::vector<int>({48, 50}));
+    assert(!hysteresis.hasDeferredChanges());
+
+    auto churn = hysteresis.getChurnStats(1);
+    assert(churn.numGrows == 1 && churn.numShrinks == 2 && churn.numSpawned == 55);
+    // Job #3 left the balancing
+    assert(hysteresis.getChurnStats(3).numSpawned == 0);
+    assert(hysteresis.getTotalChurnStats().numSpawned == 120);
+
+    // A job whose demand dropped shrinks to it at once, despite its recent change
+    volumes = balance(9, {{1, 20}, {2, 50}}, {20, 100});
+    assert(volumes == std::vector<int>({20, 50}));
+    assert(!hysteresis.hasDeferredChanges());
+    // A shrink below the (dropped) demand is held at the demand
+    volumes = balance(10, {{1, 10}, {2, 50}}, {15, 100});
+    assert(volumes == std::vector<int>({15, 50}));
+    assert(hysteresis.hasDeferredChanges());
+
+    // Disabled: volumes are passed through and only counted
+    VolumeHysteresis passThrough(/*enabled=*/false, 3, 0.1);
+    std::vector<BalancingEntry> entries {BalancingEntry(1, 100, 1)};
+    int epoch = 0;
+    for (int volume : {10, 20, 5}) {
+        entries[0].volume = volume;
+        passThrough.apply(++epoch, entries, map, 100);
+        assert(entries[0].volume == volume);
+    }
+    churn = passThrough.getChurnStats(1);
+    assert(churn.numGrows == 1 && churn.numShrinks == 1 && churn.numSpawned == 20);
+}
+
 int main(int argc, char *argv[]) {
     Timer::init();
     Parameters params;
@@ -241,6 +339,8 @@ int main(int argc, char *argv[]) {
     testDivergentDemandPriorityRatio(params);
     testTinyModifier(params);
     testHugeModifier(params);
+    testLightJobs(params);
+    testHysteresis(params);
     testPerformance(params);
 }
 
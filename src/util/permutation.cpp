@@ -3,6 +3,7 @@
 #include <ext/alloc_traits.h>
 #include <stddef.h>
 #include <stdint.h>
+#include <stdio.h>
 #include <set>
 #include <algorithm>
 #include <cmath>
@@ -14,6 +15,7 @@
 #include "permutation.hpp"
 #include "util/logger.hpp"
 #include "util/random.hpp"
+#include "util/sys/proc.hpp"
 
 std::vector<std::vector<int>> AdjustablePermutation::getPermutations(int n, int degree) {
 
@@ -136,70 +138,93 @@ std::vector<int> AdjustablePermutation::createExpanderGraph(const std::vector<st
 }
 
 /*
-Perform a modified Dijkstra's algorithm to find the outgoing edge from PE #myRank 
-along the shortest path towards each PE. For each PE x, this constructs a distributed 
-r-ary reduction tree of PEs that is probabilistically balanced and rooted at x.
+Find the outgoing edge from PE #myRank along the shortest path towards each PE.
+For each PE x, this constructs a distributed r-ary reduction tree of PEs that
+is probabilistically balanced and rooted at x.
+Since all edges have unit weight, this is a breadth-first search which visits
+the nodes of each level in a pseudo-random order that differs for each PE
+(like a Dijkstra search with pseudo-random tie breaking), in O(n·r + n log n).
 */
 std::vector<int> AdjustablePermutation::getBestOutgoingEdgeForEachNode(const std::vector<std::vector<int>>& permutations, int myRank) {
     
     size_t numNodes = permutations[0].size();
-    size_t degree = permutations.size();
 
-    std::vector<int> distance(numNodes, INT32_MAX);
-    distance[myRank] = 0;
-    
-    auto comp = [&distance, myRank](int x, int y) {
-        if (distance[x] != distance[y]) return distance[x] < distance[y];
-        // Tie breaking is done pseudo-randomly and differently for each PE:
-        // Helps to distribute the child nodes more uniformly
-        return robin_hood::hash_int(x+myRank) < robin_hood::hash_int(y+myRank);
-    };
-    auto unvisitedSet = std::set<int, decltype(comp)>(comp);
-    for (size_t i = 0; i < numNodes; i++) unvisitedSet.insert(i);
+    // Tie breaking is done pseudo-randomly and differently for each PE:
+    // Helps to distribute the child nodes more uniformly
+    auto tieBreakKey = [myRank](int x) {return robin_hood::hash_int(x+myRank);};
+    auto comp = [&](int x, int y) {return tieBreakKey(x) < tieBreakKey(y);};
 
     std::vector<int> bestOutgoingEdge(numNodes, -1);
+    std::vector<bool> discovered(numNodes, false);
+    discovered[myRank] = true;
+
+    // Neighbors of this PE form the first level
+    std::vector<int> level;
+    for (auto& perm : permutations) {
+        int succNode = perm[myRank];
+        if (discovered[succNode]) continue;
+        discovered[succNode] = true;
+        bestOutgoingEdge[succNode] = succNode;
+        level.push_back(succNode);
+    }
 
-    while (!unvisitedSet.empty()) {
-        int currentNode = *unvisitedSet.begin();
-        
-        // For each of the current node's successors:
-        for (size_t i = 0; i < permutations.size(); i++) {
-            int succNode = permutations[i][currentNode];
-            if (!unvisitedSet.count(succNode)) continue;
-
-            // Initialize best outgoing edge for each of the initial node's neighbors
-            if (currentNode == myRank) {
-                bestOutgoingEdge[currentNode] = succNode; 
-            }
-            assert(bestOutgoingEdge[currentNode] >= 0);
-
-            // Update distance and best outgoing edge
-            int newDistance = distance[currentNode] + 1;
-            if (newDistance < distance[succNode]) {
-                unvisitedSet.erase(succNode);
-                distance[succNode] = newDistance;
-                unvisitedSet.insert(succNode);
+    std::vector<int> nextLevel;
+    while (!level.empty()) {
+        std::sort(level.begin(), level.end(), comp);
+        for (int currentNode : level) {
+            // Each newly discovered successor inherits the current node's outgoing edge
+            for (auto& perm : permutations) {
+                int succNode = perm[currentNode];
+                if (discovered[succNode]) continue;
+                discovered[succNode] = true;
                 bestOutgoingEdge[succNode] = bestOutgoingEdge[currentNode];
+                nextLevel.push_back(succNode);
             }
         }
-
-        unvisitedSet.erase(currentNode);
+        level.swap(nextLevel);
+        nextLevel.clear();
     }
     bestOutgoingEdge[myRank] = myRank;
 
-    /*
-    std::string str = "";
-    for (size_t i = 0; i < bestOutgoingEdge.size(); i++) {
-        str += std::to_string(i) + std::string("->") + std::to_string(bestOutgoingEdge[i]) + std::string(" ");
-    }
-    LOG(V4_VVER, "Best out edges: %s\n", str.c_str());
-    */
-
     return bestOutgoingEdge;
 }
 
 
 
+bool AdjustablePermutation::readPermutations(const std::string& file, int n, int r, std::vector<std::vector<int>>& out) {
+    FILE* f = fopen(file.c_str(), "rb");
+    if (!f) return false;
+    int header[2];
+    bool success = fread(header, sizeof(int), 2, f) == 2 && header[0] == n && header[1] == r;
+    if (success) {
+        out.resize(r);
+        for (auto& perm : out) {
+            perm.resize(n);
+            success &= fread(perm.data(), sizeof(int), n, f) == (size_t) n;
+            if (!success) break;
+            for (int x : perm) success &= x >= 0 && x < n;
+        }
+    }
+    fclose(f);
+    if (!success) out.clear();
+    return success;
+}
+
+bool AdjustablePermutation::writePermutations(const std::string& file, const std::vector<std::vector<int>>& permutations) {
+    // Write to a temporary file and move it in place so that no partial file can be read
+    std::string tmpFile = file + "." + std::to_string(Proc::getPid()) + ".tmp";
+    FILE* f = fopen(tmpFile.c_str(), "wb");
+    if (!f) return false;
+    int header[2] = {permutations.empty() ? 0 : (int) permutations[0].size(), (int) permutations.size()};
+    bool success = fwrite(header, sizeof(int), 2, f) == 2;
+    for (auto& perm : permutations)
+        success &= fwrite(perm.data(), sizeof(int), perm.size(), f) == perm.size();
+    success &= fclose(f) == 0;
+    if (success) success = rename(tmpFile.c_str(), file.c_str()) == 0;
+    if (!success) remove(tmpFile.c_str());
+    return success;
+}
+
 AdjustablePermutation::AdjustablePermutation(int n, int seed) {
 
     _n = n;
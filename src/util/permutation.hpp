@@ -3,6 +3,7 @@
 #define DOMPASCH_PERMUTATION
 
 #include <random>
+#include <string>
 #include <vector>
 
 #include "util/robin_hood.hpp"
@@ -28,6 +29,11 @@ public:
     static std::vector<int> createExpanderGraph(const std::vector<std::vector<int>>& permutations, int myRank);
     static std::vector<int> getBestOutgoingEdgeForEachNode(const std::vector<std::vector<int>>& permutations, int myRank);
 
+    // Binary (de-)serialization of the output of getPermutations, e.g., to cache it across runs.
+    // Reading fails (returns false) if the file does not exist or does not match n and r.
+    static bool readPermutations(const std::string& file, int n, int r, std::vector<std::vector<int>>& out);
+    static bool writePermutations(const std::string& file, const std::vector<std::vector<int>>& permutations);
+
     AdjustablePermutation() = default;
     AdjustablePermutation(int n, int seed);
 
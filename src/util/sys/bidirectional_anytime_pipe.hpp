@@ -5,6 +5,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <cstdio>
+#include <functional>
 #include <fcntl.h>
 #include <string>
 #include <sys/poll.h>
@@ -19,6 +20,7 @@
 #include "util/spsc_blocking_ringbuffer.hpp"
 #include "util/sys/background_worker.hpp"
 #include "util/sys/fileutils.hpp"
+#include "util/sys/timer.hpp"
 
 class BiDirectionalAnytimePipe {
 
@@ -38,12 +40,14 @@ private:
     struct Message {
         char tag;
         std::vector<int> data;
+        float arrival {0};
     };
     SPSCBlockingRingbuffer<Message> _buf_in;
     SPSCBlockingRingbuffer<Message> _buf_out;
 
     char _read_tag = 0;
     Message _read_msg;
+    std::function<void()> _cb_incoming;
 
     bool _failed {false};
 
@@ -62,6 +66,12 @@ public:
         }
     }
 
+    // Child only, before open(): called from the reading thread whenever
+    // a new message can be polled, so that the consumer need not poll periodically.
+    void setIncomingMessageCallback(std::function<void()> cb) {
+        _cb_incoming = cb;
+    }
+
     void open() {
         if (_mode == CREATE) {
             _pipe_out = fopen(_path_out.c_str(), "w");
@@ -86,9 +96,11 @@ public:
                     msg.data = readFromPipe(false);
                     if (_failed) break;
                     //printf("READ %c FROM PIPE\n", msg.tag);
+                    msg.arrival = Timer::elapsedSeconds();
                     // write message into reading queue
                     bool success = _buf_in.pushBlocking(msg);
                     if (!success) LOG(V1_WARN, "[WARN] Unsuccessful pipe write for tag %c\n", msg.tag);
+                    else if (_cb_incoming) _cb_incoming();
                     //printf("READ FROM PIPE TO QUEUE\n");
                 }
             });
@@ -148,6 +160,11 @@ public:
             return std::move(_read_msg.data);
         }
     }
+    // Child only: the time (Timer::elapsedSeconds()) at which the message
+    // last returned by readData() was received from the pipe.
+    float getArrivalTimeOfLastRead() const {
+        return _read_msg.arrival;
+    }
 
     void writeData(const std::vector<int>& data, char contentTag) {
         LOG(V5_DEBG, "[PIPE] write %i ints \"%c\"\n", data.size(), contentTag);
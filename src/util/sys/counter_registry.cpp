@@ -0,0 +1,125 @@
+#include "counter_registry.hpp"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <cstring>
+#include <list>
+#include <map>
+
+#include "util/sys/threading.hpp"
+
+thread_local CounterRegistry::Shard* CounterRegistry::_local_shard {nullptr};
+
+namespace {
+
+    // Constructed on first use since counters are registered during static initialization
+    struct RegistryState {
+        Mutex mtx;
+        std::map<std::string, int> idsByName;
+        std::list<CounterRegistry::Shard*> shards;
+        long retiredValues[CounterRegistry::MAX_NUM_COUNTERS] = {0};
+    };
+    RegistryState& getState() {
+        static RegistryState state;
+        return state;
+    }
+
+    // Upon thread exit, adds the thread's values to the retired values and frees its shard
+    struct ShardRetirement {
+        CounterRegistry::Shard* shard {nullptr};
+        ~ShardRetirement() {
+            if (!shard) return;
+            auto& state = getState();
+            auto lock = state.mtx.getLock();
+            for (int i = 0; i < CounterRegistry::MAX_NUM_COUNTERS; i++)
+                state.retiredValues[i] += shard->values[i].load(std::memory_order_relaxed);
+            state.shards.remove(shard);
+            delete shard;
+        }
+    };
+}
+
+int CounterRegistry::registerCounter(const std::string& name) {
+    auto& state = getState();
+    auto lock = state.mtx.getLock();
+    auto it = state.idsByName.find(name);
+    if (it != state.idsByName.end()) return it->second;
+    int id = state.idsByName.size();
+    if (id >= MAX_NUM_COUNTERS) {
+        fprintf(stderr, "[ERROR] Too many counters (registering \"%s\")\n", name.c_str());
+        abort();
+    }
+    state.idsByName[name] = id;
+    return id;
+}
+
+long CounterRegistry::get(int id) {
+    auto& state = getState();
+    auto lock = state.mtx.getLock();
+    long sum = state.retiredValues[id];
+    for (auto shard : state.shards) sum += shard->values[id].load(std::memory_order_relaxed);
+    return sum;
+}
+
+std::vector<std::string> CounterRegistry::getNames() {
+    auto& state = getState();
+    auto lock = state.mtx.getLock();
+    std::vector<std::string> names;
+    for (auto& [name, id] : state.idsByName) names.push_back(name);
+    return names; // std::map: already sorted
+}
+
+int CounterRegistry::getId(const std::string& name) {
+    auto& state = getState();
+    auto lock = state.mtx.getLock();
+    auto it = state.idsByName.find(name);
+    return it == state.idsByName.end() ? -1 : it->second;
+}
+
+std::vector<int> CounterRegistry::serializeIncrements(std::vector<long>& lastValues) {
+    lastValues.resize(MAX_NUM_COUNTERS, 0);
+    std::vector<int> data;
+    for (const auto& name : getNames()) {
+        const int id = getId(name);
+        const long value = get(id);
+        const long increment = value - lastValues[id];
+        if (increment == 0) continue;
+        lastValues[id] = value;
+        data.push_back(name.size());
+        const size_t offset = data.size();
+        data.resize(offset + (name.size()+sizeof(int)-1) / sizeof(int), 0);
+        memcpy(data.data()+offset, name.data(), name.size());
+        data.push_back((int) (increment & 0xffffffff));
+        data.push_back((int) (increment >> 32));
+    }
+    return data;
+}
+
+void CounterRegistry::addSerializedIncrements(const std::vector<int>& data) {
+    size_t i = 0;
+    while (i < data.size()) {
+        const size_t nameLength = data[i++];
+        const size_t nameInts = (nameLength+sizeof(int)-1) / sizeof(int);
+        if (i + nameInts + 2 > data.size()) break; // malformed
+        std::string name((const char*) (data.data()+i), nameLength);
+        i += nameInts;
+        const long increment = (long) (unsigned int) data[i] | ((long) data[i+1] << 32);
+        i += 2;
+        const int id = getId(name);
+        if (id >= 0) add(id, increment);
+    }
+}
+
+CounterRegistry::Shard* CounterRegistry::createLocalShard() {
+    static thread_local ShardRetirement retirement;
+    auto shard = new Shard();
+    {
+        auto& state = getState();
+        auto lock = state.mtx.getLock();
+        state.shards.push_back(shard);
+    }
+    retirement.shard = shard;
+    _local_shard = shard;
+    return shard;
+}
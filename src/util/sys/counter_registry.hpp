@@ -0,0 +1,73 @@
+#pragma once
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+// Process-wide registry of named event counters which are cheap to increment from
+// any thread: Each thread increments its own cache-aligned shard of counter values
+// (a relaxed load and store, no read-modify-write on shared cache lines), and reading
+// a counter sums over all shards. Values of exiting threads are retained.
+//
+// Define counters at namespace scope, e.g., "static Counter cntFoo("foo.bar");",
+// so that all processes (running the same binary) register the same set of counters
+// at program start. SysState relies on this to aggregate all counters across ranks
+// within its reduction. Counters incremented in a subprocess are forwarded to their
+// parent via serializeIncrements/addSerializedIncrements, so the parent must define
+// counters of the same names.
+class CounterRegistry {
+
+public:
+    static const int MAX_NUM_COUNTERS = 128;
+
+    struct alignas(64) Shard {
+        std::atomic_long values[MAX_NUM_COUNTERS];
+        Shard() {
+            for (auto& v : values) v.store(0, std::memory_order_relaxed);
+        }
+    };
+
+private:
+    static thread_local Shard* _local_shard;
+
+public:
+    // Returns the ID of the counter of the given name, registering it if necessary.
+    static int registerCounter(const std::string& name);
+
+    static inline void add(int id, long value) {
+        Shard* shard = _local_shard;
+        if (!shard) shard = createLocalShard();
+        auto& v = shard->values[id];
+        v.store(v.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    }
+
+    // Current value of the counter, summed over all threads of this process
+    static long get(int id);
+
+    // Names of all registered counters, sorted lexicographically
+    static std::vector<std::string> getNames();
+    static int getId(const std::string& name);
+
+    // Increments of all counters since the values in lastValues (which are updated),
+    // encoded by counter name so that another process can add them to its own counters:
+    // for each changed counter, the name's length, the name packed into ints, and the
+    // increment as two ints (low, high).
+    static std::vector<int> serializeIncrements(std::vector<long>& lastValues);
+    // Adds increments serialized by another process to the counters of the same names.
+    // Names which are not registered in this process are ignored.
+    static void addSerializedIncrements(const std::vector<int>& data);
+
+private:
+    static Shard* createLocalShard();
+};
+
+class Counter {
+
+private:
+    int _id;
+
+public:
+    Counter(const std::string& name) : _id(CounterRegistry::registerCounter(name)) {}
+    inline void add(long value = 1) const {CounterRegistry::add(_id, value);}
+    long get() const {return CounterRegistry::get(_id);}
+};
@@ -0,0 +1,41 @@
+
+#pragma once
+
+#include <climits>
+#include <cstdint>
+#include <ctime>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+// An event counter on a 32-bit word which may reside in memory shared among
+// processes. A thread remembers the counter's value via get(), does its work,
+// and then waits until someone signal()s the event or until a timeout passes.
+// Signals which occur in between are never lost: wait() returns immediately if
+// the counter differs from the remembered value.
+class FutexEvent {
+
+private:
+    uint32_t* _word;
+
+public:
+    FutexEvent(uint32_t* word) : _word(word) {}
+
+    uint32_t get() const {
+        return __atomic_load_n(_word, __ATOMIC_ACQUIRE);
+    }
+
+    void signal() {
+        __atomic_add_fetch(_word, 1, __ATOMIC_RELEASE);
+        // not FUTEX_PRIVATE_FLAG: waiters may live in another process
+        syscall(SYS_futex, _word, FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+    }
+
+    // Returns whether the event was signalled since the counter had the provided value.
+    bool wait(uint32_t lastSeen, long timeoutMicros) {
+        if (get() != lastSeen) return true;
+        struct timespec timeout {timeoutMicros / 1'000'000, 1000 * (timeoutMicros % 1'000'000)};
+        syscall(SYS_futex, _word, FUTEX_WAIT, lastSeen, &timeout, nullptr, 0);
+        return get() != lastSeen;
+    }
+};
@@ -280,3 +280,24 @@ long Proc::getRecursiveProportionalSetSizeKbs(pid_t pid) {
 
     return memory;
 }
+
+long Proc::getHugePageMappedSharedMemoryKbs(pid_t pid) {
+
+    long memory = 0;
+    std::ifstream smaps("/proc/" + std::to_string(pid) + "/smaps_rollup", std::ios_base::in);
+    if (!smaps.good()) {
+        smaps = std::ifstream("/proc/" + std::to_string(pid) + "/smaps", std::ios_base::in);
+        if (!smaps.good()) return memory;
+    }
+
+    // Sum up all lines of the form "<label>:   <value> kB" with a relevant label
+    std::string label;
+    long value;
+    std::string unit;
+    while (smaps >> label) {
+        if (label == "ShmemPmdMapped:" || label == "Shared_Hugetlb:" || label == "Private_Hugetlb:") {
+            if (smaps >> value >> unit) memory += value;
+        }
+    }
+    return memory;
+}
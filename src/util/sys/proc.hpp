@@ -41,6 +41,11 @@ public:
 
     static std::pair<unsigned long, unsigned long> getMachineFreeAndTotalRamKbs();
     static long getRecursiveProportionalSetSizeKbs(pid_t pid);
+    /*
+    Returns how many kB of shared memory of the process are currently mapped
+    with (transparent or hugetlbfs) huge pages.
+    */
+    static long getHugePageMappedSharedMemoryKbs(pid_t pid);
 
     /*
     If successful, returns the used CPU ratio and the share of time it spent in kernel mode.
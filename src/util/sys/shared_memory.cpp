@@ -1,15 +1,126 @@
-
 #include "shared_memory.hpp"
 
 #include <sys/mman.h>
+#include <sys/vfs.h>
+#include <linux/magic.h>
 #include <fcntl.h>
 #include <unistd.h>
 #include <assert.h>
+#include <stdint.h>
 #include <stdlib.h>
+#include <fstream>
+#include <map>
+
+#include "util/sys/threading.hpp"
 
 namespace SharedMemory {
 
-    void* create(const std::string& specifier, size_t size) {
+    struct Mapping {
+        size_t length;
+        bool requested;
+        bool advised;
+        bool explicitHuge;
+    };
+    Mutex _mappings_mutex;
+    std::map<void*, Mapping> _mappings;
+    int _num_fallbacks {0};
+
+    size_t getTransparentHugePageSize() {
+        static size_t size = 0;
+        if (size == 0) {
+            std::ifstream ifs("/sys/kernel/mm/transparent_hugepage/hpage_pmd_size");
+            if (!(ifs >> size) || size == 0) size = 2UL << 20; // 2 MiB
+        }
+        return size;
+    }
+
+    size_t getExplicitHugePageSize() {
+        struct statfs fs;
+        if (statfs(HUGETLBFS_DIRECTORY, &fs) != 0 || fs.f_type != HUGETLBFS_MAGIC) return 0;
+        return fs.f_bsize;
+    }
+
+    size_t roundUp(size_t size, size_t alignment) {
+        return ((size + alignment - 1) / alignment) * alignment;
+    }
+
+    std::string getHugetlbfsPath(const std::string& specifier) {
+        return HUGETLBFS_DIRECTORY + (specifier[0] == '/' ? specifier : "/" + specifier);
+    }
+
+    void registerMapping(void* addr, Mapping mapping) {
+        auto lock = _mappings_mutex.getLock();
+        _mappings[addr] = mapping;
+    }
+
+    // Maps the file behind memFd such that the mapping begins at a multiple of
+    // the transparent huge page size and advises the kernel to use huge pages.
+    void* mapAlignedAndAdvise(int memFd, size_t size, int prot, bool& advised) {
+        const size_t alignment = getTransparentHugePageSize();
+        const size_t reservedSize = size + alignment;
+        // Reserve a sufficiently large range of addresses
+        char* reserved = (char*) mmap(NULL, reservedSize, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+        if (reserved == MAP_FAILED) return MAP_FAILED;
+        char* aligned = (char*) roundUp((uintptr_t) reserved, alignment);
+        // Map the segment into the aligned part of the range
+        void* buffer = mmap(aligned, size, prot, MAP_SHARED | MAP_FIXED, memFd, 0);
+        if (buffer == MAP_FAILED) {
+            munmap(reserved, reservedSize);
+            return MAP_FAILED;
+        }
+        // Release the surrounding parts of the reserved range
+        if (aligned > reserved) munmap(reserved, aligned - reserved);
+        char* end = aligned + roundUp(size, sysconf(_SC_PAGESIZE));
+        if (end < reserved + reservedSize) munmap(end, reserved + reservedSize - end);
+        advised = madvise(buffer, size, MADV_HUGEPAGE) == 0;
+        return buffer;
+    }
+
+    void* mapShmem(int memFd, size_t size, int prot, HugePageMode hugePages, Mapping& mapping) {
+        mapping = Mapping{size, hugePages != NO_HUGE_PAGES, false, false};
+        if (hugePages != NO_HUGE_PAGES && size >= getTransparentHugePageSize()) {
+            void* buffer = mapAlignedAndAdvise(memFd, size, prot, mapping.advised);
+            if (buffer != MAP_FAILED) return buffer;
+        }
+        return mmap(NULL, size, prot, MAP_SHARED, memFd, 0);
+    }
+
+    void* createOnHugetlbfs(const std::string& specifier, size_t size) {
+        const size_t pageSize = getExplicitHugePageSize();
+        if (pageSize == 0) return nullptr;
+
+        std::string path = getHugetlbfsPath(specifier);
+        int memFd = open(path.c_str(), O_CREAT | O_RDWR, S_IRWXU);
+        if (memFd == -1) return nullptr;
+
+        // Lengths of hugetlbfs files and mappings must be multiples of the huge page size
+        const size_t length = roundUp(size, pageSize);
+        void* buffer = MAP_FAILED;
+        if (ftruncate(memFd, length) != -1) {
+            // Fails if not enough huge pages can be reserved
+            buffer = mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_SHARED, memFd, 0);
+        }
+        close(memFd);
+        if (buffer == MAP_FAILED) {
+            unlink(path.c_str());
+            return nullptr;
+        }
+        registerMapping(buffer, Mapping{length, true, false, true});
+        return buffer;
+    }
+
+    void* create(const std::string& specifier, size_t size, HugePageMode hugePages) {
+
+        if (hugePages == EXPLICIT_HUGE_PAGES && size >= getTransparentHugePageSize()) {
+            void* buffer = createOnHugetlbfs(specifier, size);
+            if (buffer != nullptr) return buffer;
+            // Fall back to transparent huge pages
+            {
+                auto lock = _mappings_mutex.getLock();
+                _num_fallbacks++;
+            }
+            hugePages = TRANSPARENT_HUGE_PAGES;
+        }
 
         int memFd = shm_open(specifier.c_str(), O_CREAT | O_RDWR, S_IRWXU);
         assert(memFd != -1);
@@ -20,19 +131,51 @@ namespace SharedMemory {
         // If compiled without assert
         if (memFd == -1 || res == -1) abort();
 
-        void *buffer = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, memFd, 0);
-        assert(buffer != nullptr);
+        Mapping mapping;
+        void *buffer = mapShmem(memFd, size, PROT_READ | PROT_WRITE, hugePages, mapping);
+        assert(buffer != MAP_FAILED);
         close(memFd);
 
+        registerMapping(buffer, mapping);
         return buffer;
     }
 
     bool canAccess(const std::string& specifier) {
         std::string shmemFile = "/dev/shm/" + specifier;
-        return ::access(shmemFile.c_str(), F_OK) != -1;
+        return ::access(shmemFile.c_str(), F_OK) != -1
+            || ::access(getHugetlbfsPath(specifier).c_str(), F_OK) != -1;
     }
 
-    void* access(const std::string& specifier, size_t size, AccessMode accessMode) {
+    void* accessOnHugetlbfs(const std::string& path, size_t size, AccessMode accessMode) {
+
+        const size_t pageSize = getExplicitHugePageSize();
+        if (pageSize == 0) return nullptr;
+
+        auto oflag = accessMode == READONLY ? O_RDONLY : O_RDWR;
+        int memFd = open(path.c_str(), oflag);
+        if (memFd == -1) {
+            perror("Can't open file");
+            return nullptr;
+        }
+
+        const size_t length = roundUp(size, pageSize);
+        auto prot = accessMode == READONLY ? PROT_READ : (PROT_READ | PROT_WRITE);
+        void *buffer = mmap(NULL, length, prot, MAP_SHARED, memFd, 0);
+        close(memFd);
+        if (buffer == MAP_FAILED) {
+            perror("Can't mmap");
+            return nullptr;
+        }
+        registerMapping(buffer, Mapping{length, true, false, true});
+        return buffer;
+    }
+
+    void* access(const std::string& specifier, size_t size, AccessMode accessMode, HugePageMode hugePages) {
+
+        // Segments backed by explicit huge pages are found on the hugetlbfs mount
+        std::string hugetlbfsFile = getHugetlbfsPath(specifier);
+        if (::access(hugetlbfsFile.c_str(), F_OK) != -1)
+            return accessOnHugetlbfs(hugetlbfsFile, size, accessMode);
 
         std::string shmemFile = "/dev/shm/" + specifier;
         if (::access(shmemFile.c_str(), F_OK) == -1) return nullptr;
@@ -45,18 +188,45 @@ namespace SharedMemory {
         }
 
         auto prot = accessMode == READONLY ? PROT_READ : (PROT_READ | PROT_WRITE);
-        void *buffer = mmap(NULL, size, prot, MAP_SHARED, memFd, 0);
-        if (buffer == NULL) {
+        Mapping mapping;
+        void *buffer = mapShmem(memFd, size, prot, hugePages, mapping);
+        if (buffer == MAP_FAILED) {
             perror("Can't mmap");
+            close(memFd);
             return nullptr;
         }
         close(memFd);
 
+        registerMapping(buffer, mapping);
         return buffer;
     }
 
     void free(const std::string& specifier, char* addr, size_t size) {
-        munmap(addr, size);
-        shm_unlink(specifier.c_str());
+        size_t length = size;
+        {
+            auto lock = _mappings_mutex.getLock();
+            auto it = _mappings.find(addr);
+            if (it != _mappings.end()) {
+                length = it->second.length;
+                _mappings.erase(it);
+            }
+        }
+        munmap(addr, length);
+        std::string hugetlbfsFile = getHugetlbfsPath(specifier);
+        if (::access(hugetlbfsFile.c_str(), F_OK) != -1) unlink(hugetlbfsFile.c_str());
+        else shm_unlink(specifier.c_str());
+    }
+
+    HugePageStats getHugePageStats() {
+        HugePageStats stats;
+        auto lock = _mappings_mutex.getLock();
+        for (auto& [addr, mapping] : _mappings) {
+            stats.mappedBytes += mapping.length;
+            if (mapping.requested) stats.requestedBytes += mapping.length;
+            if (mapping.advised) stats.advisedBytes += mapping.length;
+            if (mapping.explicitHuge) stats.explicitBytes += mapping.length;
+        }
+        stats.numFallbacks = _num_fallbacks;
+        return stats;
     }
-}
\ No newline at end of file
+}
@@ -1,4 +1,3 @@
-
 #ifndef DOMSCHREI_MALLOB_SHARED_MEMORY_H
 #define DOMSCHREI_MALLOB_SHARED_MEMORY_H
 
@@ -8,14 +7,33 @@
 #include <string>
 
 namespace SharedMemory {
-    
+
     enum AccessMode {READONLY, ARBITRARY};
 
+    // Backing of (large) segments with huge pages to reduce TLB pressure.
+    // TRANSPARENT: align the mapping and advise the kernel to use transparent huge pages
+    // (effective if /sys/kernel/mm/transparent_hugepage/shmem_enabled permits it).
+    // EXPLICIT: place the segment on a hugetlbfs mount (HUGETLBFS_DIRECTORY); falls back
+    // to TRANSPARENT if the mount is missing or has no free huge pages.
+    enum HugePageMode {NO_HUGE_PAGES = 0, TRANSPARENT_HUGE_PAGES = 1, EXPLICIT_HUGE_PAGES = 2};
+    const char* const HUGETLBFS_DIRECTORY = "/dev/hugepages";
+
     // From https://stackoverflow.com/a/5656561
-    void* create(const std::string& specifier, size_t size);
+    void* create(const std::string& specifier, size_t size, HugePageMode hugePages = NO_HUGE_PAGES);
     bool canAccess(const std::string& specifier);
-    void* access(const std::string& specifier, size_t size, AccessMode accessMode = ARBITRARY);
+    void* access(const std::string& specifier, size_t size, AccessMode accessMode = ARBITRARY,
+        HugePageMode hugePages = NO_HUGE_PAGES);
     void free(const std::string& specifier, char* addr, size_t size);
+
+    // Bookkeeping over all segments currently mapped by this process
+    struct HugePageStats {
+        size_t mappedBytes {0}; // all mapped segments
+        size_t requestedBytes {0}; // segments for which huge pages were requested
+        size_t advisedBytes {0}; // segments mapped with transparent huge page advice
+        size_t explicitBytes {0}; // segments backed by hugetlbfs
+        int numFallbacks {0}; // explicit huge page requests which fell back
+    };
+    HugePageStats getHugePageStats();
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,148 @@
+#include "tracer.hpp"
+
+#include <pthread.h>
+#include <stdio.h>
+#include <time.h>
+#include <list>
+#include <memory>
+#include <vector>
+
+#include "util/logger.hpp"
+#include "util/sys/proc.hpp"
+#include "util/sys/threading.hpp"
+#include "util/sys/timer.hpp"
+
+bool Tracer::_enabled = false;
+
+namespace {
+
+    struct Event {
+        char phase;
+        const char* category;
+        const char* name;
+        uint64_t id;
+        double timestamp;
+        double duration;
+        Tracer::Args args;
+    };
+
+    // Only appended to by its owning thread; the mutex is uncontended
+    // except for the final flush.
+    struct ThreadBuffer {
+        long tid;
+        std::string threadName;
+        Mutex mtx;
+        std::vector<Event> events;
+        size_t numDropped {0};
+    };
+
+    int _rank {0};
+    std::string _directory;
+    size_t _max_events_per_thread {0};
+    double _clock_sync_point {-1};
+
+    Mutex _buffers_mutex;
+    std::list<std::unique_ptr<ThreadBuffer>> _buffers;
+    thread_local ThreadBuffer* _local_buffer {nullptr};
+
+    ThreadBuffer& getLocalBuffer() {
+        if (!_local_buffer) {
+            auto buf = new ThreadBuffer();
+            buf->tid = Proc::getTid();
+            char name[32] = {0};
+            pthread_getname_np(pthread_self(), name, sizeof(name));
+            buf->threadName = name;
+            auto lock = _buffers_mutex.getLock();
+            _buffers.emplace_back(buf);
+            _local_buffer = buf;
+        }
+        return *_local_buffer;
+    }
+
+    void append(Event&& event) {
+        auto& buf = getLocalBuffer();
+        auto lock = buf.mtx.getLock();
+        if (buf.events.size() >= _max_events_per_thread) {
+            buf.numDropped++;
+            return;
+        }
+        buf.events.push_back(std::move(event));
+    }
+
+    void writeArgs(FILE* f, const Tracer::Args& args) {
+        if (!args.key1) return;
+        fprintf(f, ",\"args\":{\"%s\":%ld", args.key1, args.val1);
+        if (args.key2) fprintf(f, ",\"%s\":%ld", args.key2, args.val2);
+        fprintf(f, "}");
+    }
+}
+
+void Tracer::init(int rank, const std::string& directory, size_t maxEventsPerThread) {
+    _rank = rank;
+    _directory = directory;
+    _max_events_per_thread = maxEventsPerThread;
+    _enabled = true;
+}
+
+void Tracer::setClockSyncPoint() {
+    _clock_sync_point = now();
+}
+
+double Tracer::now() {
+    timespec start = Timer::getStartTime();
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+    return 1e6 * (ts.tv_sec - start.tv_sec) + 1e-3 * (ts.tv_nsec - start.tv_nsec);
+}
+
+void Tracer::record(char phase, const char* category, const char* name, uint64_t id, const Args& args) {
+    append(Event{phase, category, name, id, now(), 0, args});
+}
+
+void Tracer::recordComplete(const char* category, const char* name, double start, double duration, const Args& args) {
+    append(Event{'X', category, name, 0, start, duration, args});
+}
+
+void Tracer::flush() {
+    if (!_enabled) return;
+
+    std::string filename = _directory + "/mallob_timeline." + std::to_string(_rank) + ".json";
+    FILE* f = fopen(filename.c_str(), "w");
+    if (!f) {
+        LOG(V1_WARN, "[WARN] Cannot write timeline to %s\n", filename.c_str());
+        return;
+    }
+
+    // Wall clock time at which the Timer was started, to align ranks on synchronized hosts
+    timespec real;
+    clock_gettime(CLOCK_REALTIME, &real);
+    double timerStartRealtime = 1e6 * real.tv_sec + 1e-3 * real.tv_nsec - now();
+
+    fprintf(f, "{\"otherData\":{\"rank\":%i,\"timer_start_realtime_us\":%.3f", _rank, timerStartRealtime);
+    if (_clock_sync_point >= 0) fprintf(f, ",\"clock_sync_point_us\":%.3f", _clock_sync_point);
+    fprintf(f, "},\n\"displayTimeUnit\":\"ms\",\n\"traceEvents\":[\n");
+    fprintf(f, "{\"ph\":\"M\",\"name\":\"process_name\",\"pid\":%i,\"args\":{\"name\":\"rank %i\"}}", _rank, _rank);
+
+    size_t numEvents = 0, numDropped = 0;
+    auto lock = _buffers_mutex.getLock();
+    for (auto& buf : _buffers) {
+        auto bufLock = buf->mtx.getLock();
+        fprintf(f, ",\n{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":%i,\"tid\":%ld,\"args\":{\"name\":\"%s\"}}",
+            _rank, buf->tid, buf->threadName.c_str());
+        for (auto& e : buf->events) {
+            fprintf(f, ",\n{\"ph\":\"%c\",\"cat\":\"%s\",\"name\":\"%s\",\"pid\":%i,\"tid\":%ld,\"ts\":%.3f",
+                e.phase, e.category, e.name, _rank, buf->tid, e.timestamp);
+            if (e.phase == 'X') fprintf(f, ",\"dur\":%.3f", e.duration);
+            if (e.phase == 'b' || e.phase == 'e') fprintf(f, ",\"id\":\"0x%lx\"", e.id);
+            if (e.phase == 'i') fprintf(f, ",\"s\":\"t\"");
+            writeArgs(f, e.args);
+            fprintf(f, "}");
+        }
+        numEvents += buf->events.size();
+        numDropped += buf->numDropped;
+    }
+    fprintf(f, "\n]}\n");
+    fclose(f);
+
+    LOG(V3_VERB, "Wrote %lu timeline events (%lu dropped) to %s\n", numEvents, numDropped, filename.c_str());
+}
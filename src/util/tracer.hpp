@@ -0,0 +1,76 @@
+#pragma once
+
+#include <stdint.h>
+#include <string>
+
+// Optional recording of a timeline of spans (job lifecycle, description transfers,
+// clause sharing epochs, proof assembly, balancing rounds) in Chrome's Trace Event
+// format, to be viewed in Perfetto (ui.perfetto.dev) or chrome://tracing.
+// Events are appended to buffers local to each thread and are written to
+// <directory>/mallob_timeline.<rank>.json upon flush(). The files of all ranks
+// can be merged with scripts/eval/merge_timelines.py.
+// If tracing is disabled, each recording call is reduced to a single branch.
+class Tracer {
+
+public:
+    // Up to two named integer arguments attached to an event.
+    struct Args {
+        const char* key1;
+        long val1;
+        const char* key2;
+        long val2;
+        Args(const char* key1 = nullptr, long val1 = 0, const char* key2 = nullptr, long val2 = 0) :
+            key1(key1), val1(val1), key2(key2), val2(val2) {}
+    };
+
+    // Records a span on the calling thread from construction to destruction.
+    class Span {
+    private:
+        const char* _category;
+        const char* _name;
+        Args _args;
+        double _start {-1};
+    public:
+        Span(const char* category, const char* name, Args args = Args()) :
+                _category(category), _name(name), _args(args) {
+            if (enabled()) _start = now();
+        }
+        ~Span() {
+            if (_start >= 0) recordComplete(_category, _name, _start, now() - _start, _args);
+        }
+    };
+
+private:
+    static bool _enabled;
+
+public:
+    static void init(int rank, const std::string& directory, size_t maxEventsPerThread);
+    static inline bool enabled() {return _enabled;}
+
+    // Marks the point in time which is considered simultaneous on all ranks,
+    // e.g., right after a barrier. Used to align the ranks' clocks when merging.
+    static void setClockSyncPoint();
+
+    // Asynchronous span which may begin and end on different threads or in different calls.
+    // Begin and end are matched by category, name, and ID; spans of the same category and ID
+    // are nested and displayed on a common track.
+    static inline void beginAsync(const char* category, const char* name, uint64_t id, Args args = Args()) {
+        if (enabled()) record('b', category, name, id, args);
+    }
+    static inline void endAsync(const char* category, const char* name, uint64_t id) {
+        if (enabled()) record('e', category, name, id, Args());
+    }
+    static inline void instant(const char* category, const char* name, Args args = Args()) {
+        if (enabled()) record('i', category, name, 0, args);
+    }
+
+    // Writes all events recorded so far to this rank's timeline file.
+    static void flush();
+
+    // Microseconds since program start (see Timer)
+    static double now();
+
+private:
+    static void record(char phase, const char* category, const char* name, uint64_t id, const Args& args);
+    static void recordComplete(const char* category, const char* name, double start, double duration, const Args& args);
+};